@@ -30,7 +30,7 @@ struct Node {
      * int64_t         : IntegerLiteralValue
      * double          : FloatingPointLiteralValue
      * bool            : BooleanLiteralValue
-     * std::string     : StringLiteralValue, FunctionName, VariableName
+     * std::string     : StringLiteralValue, FunctionName, FunctionDecorator, VariableName
      * TypeId          : TypeName
      * BinaryOperation : BinaryOperation
      * UnaryOperation  : UnaryOperation
@@ -54,6 +54,7 @@ enum class NodeType {
     FunctionArgument,
     FunctionArguments,
     FunctionCall,
+    FunctionDecorator,
     FunctionDefinition,
     FunctionName,
     FunctionReturnType,
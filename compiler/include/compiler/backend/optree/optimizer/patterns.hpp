@@ -0,0 +1,393 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/definitions.hpp"
+#include "compiler/optree/helpers.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/types.hpp"
+#include "compiler/optree/value.hpp"
+
+#include "compiler/backend/optree/optimizer/opt_builder.hpp"
+
+// Declarative rewrite rules over optree operations, e.g.
+//
+//     constexpr Placeholder<0> x;
+//     m_Commuted(m_ArithBinary(ArithBinOpKind::AddI, m_Any(x), m_Const(0))) >> x
+//
+// Every pattern is a distinct type, so the matching code of a rule is instantiated for it at compile time.
+// Rules are collected in a RuleSet, which tests an operation only against the rules with the same root operation.
+
+namespace optree {
+namespace optimizer {
+namespace patterns {
+
+// Values bound by placeholders during the match of a single rule
+using Bindings = std::array<Value::Ptr, 8U>;
+
+template <size_t Index>
+struct Placeholder {
+    static_assert(Index < std::tuple_size_v<Bindings>, "Too many placeholders in a pattern");
+
+    static constexpr size_t index = Index;
+
+    Value::Ptr rewrite(const Operation::Ptr &, const Bindings &bindings, OptBuilder &) const {
+        return bindings[Index];
+    }
+};
+
+template <typename T>
+concept ValuePattern = requires(const T &pattern, const Value::Ptr &value, Bindings &bindings) {
+    { pattern.match(value, bindings) } -> std::same_as<bool>;
+};
+
+template <typename T>
+concept OpPattern = ValuePattern<T> && requires(const T &pattern, const Operation::Ptr &op, Bindings &bindings) {
+    typename T::Root;
+    { pattern.matchOp(op, bindings) } -> std::same_as<bool>;
+};
+
+template <typename T>
+concept Rewriter = requires(const T &rewriter, const Operation::Ptr &op, const Bindings &bindings,
+                            OptBuilder &builder) {
+    { rewriter.rewrite(op, bindings, builder) } -> std::convertible_to<Value::Ptr>;
+};
+
+// ----------------------------------------------------------------------------
+// Value patterns
+// ----------------------------------------------------------------------------
+
+struct AnyValue {
+    bool match(const Value::Ptr &, Bindings &) const {
+        return true;
+    }
+};
+
+// Binds the value on the first occurrence of the placeholder and requires the same value on the next ones
+template <size_t Index>
+struct BoundValue {
+    bool match(const Value::Ptr &value, Bindings &bindings) const {
+        auto &bound = bindings[Index];
+        if (!bound) {
+            bound = value;
+            return true;
+        }
+        return bound == value;
+    }
+};
+
+template <size_t Index>
+struct AnyConst {
+    bool match(const Value::Ptr &value, Bindings &bindings) const {
+        if (!getValueOwnerAs<ConstantOp>(value))
+            return false;
+        if constexpr (Index < std::tuple_size_v<Bindings>)
+            return BoundValue<Index>{}.match(value, bindings);
+        return true;
+    }
+};
+
+// Floats are compared together with the sign, so that 0.0 and -0.0 are distinguished
+template <typename NativeType>
+struct ConstValue {
+    NativeType value;
+
+    bool match(const Value::Ptr &value, Bindings &) const {
+        auto constOp = getValueOwnerAs<ConstantOp>(value);
+        if (!constOp || !constOp.value().is<NativeType>())
+            return false;
+        const auto &actual = constOp.value().as<NativeType>();
+        if constexpr (std::is_same_v<NativeType, NativeFloat>)
+            return actual == this->value && std::signbit(actual) == std::signbit(this->value);
+        else
+            return actual == this->value;
+    }
+};
+
+// Matches the constants of scalar types which are converted to the given boolean value
+struct TruthyConst {
+    bool value;
+
+    bool match(const Value::Ptr &value, Bindings &) const {
+        auto constOp = getValueOwnerAs<ConstantOp>(value);
+        if (!constOp)
+            return false;
+        const auto &attr = constOp.value();
+        if (attr.is<NativeBool>())
+            return attr.as<NativeBool>() == this->value;
+        if (attr.is<NativeInt>())
+            return (attr.as<NativeInt>() != 0) == this->value;
+        if (attr.is<NativeFloat>())
+            return (attr.as<NativeFloat>() != 0.0) == this->value;
+        return false;
+    }
+};
+
+template <typename T>
+    requires std::is_arithmetic_v<T>
+auto toNative(T value) {
+    if constexpr (std::is_same_v<T, bool>)
+        return NativeBool(value);
+    else if constexpr (std::is_integral_v<T>)
+        return NativeInt(value);
+    else
+        return NativeFloat(value);
+}
+
+// ----------------------------------------------------------------------------
+// Operation patterns
+// ----------------------------------------------------------------------------
+
+// Matches the operation of the adaptor type with the given kind attribute and operands
+template <typename AdaptorType, typename KindType, ValuePattern... OperandPatterns>
+struct KindOpPattern {
+    using Root = AdaptorType;
+
+    KindType kind;
+    std::tuple<OperandPatterns...> operands;
+
+    bool matchOp(const Operation::Ptr &op, Bindings &bindings, bool swapOperands = false) const {
+        auto adapted = op->as<AdaptorType>();
+        if (!adapted || adapted.kind() != kind || op->numOperands() != sizeof...(OperandPatterns))
+            return false;
+        return [&]<size_t... Indices>(std::index_sequence<Indices...>) {
+            constexpr size_t last = sizeof...(OperandPatterns) - 1;
+            return (std::get<Indices>(operands).match(op->operand(swapOperands ? last - Indices : Indices), bindings) &&
+                    ...);
+        }(std::index_sequence_for<OperandPatterns...>{});
+    }
+
+    bool match(const Value::Ptr &value, Bindings &bindings) const {
+        auto owner = value->owner.lock();
+        return owner && matchOp(owner, bindings);
+    }
+};
+
+// Matches the binary operation with operands in any order, the direct order is tried first
+template <typename PatternType>
+struct CommutedPattern {
+    using Root = typename PatternType::Root;
+
+    PatternType pattern;
+
+    bool matchOp(const Operation::Ptr &op, Bindings &bindings) const {
+        auto saved = bindings;
+        if (pattern.matchOp(op, bindings))
+            return true;
+        bindings = saved;
+        return pattern.matchOp(op, bindings, true);
+    }
+
+    bool match(const Value::Ptr &value, Bindings &bindings) const {
+        auto owner = value->owner.lock();
+        return owner && matchOp(owner, bindings);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Rewriters
+// ----------------------------------------------------------------------------
+
+// Constant of the same type as the result of the rewritten operation
+template <typename NativeType>
+struct ConstRewriter {
+    NativeType value;
+
+    Value::Ptr rewrite(const Operation::Ptr &op, const Bindings &, OptBuilder &builder) const {
+        return builder.insert<ConstantOp>(op->ref, op->result(0)->type, value).result();
+    }
+};
+
+template <typename AdaptorType, typename KindType, Rewriter... OperandRewriters>
+struct KindOpRewriter {
+    KindType kind;
+    std::tuple<OperandRewriters...> operands;
+
+    Value::Ptr rewrite(const Operation::Ptr &op, const Bindings &bindings, OptBuilder &builder) const {
+        // Operands are rewritten in a braced list to keep the order of inserted operations
+        using Values = std::array<Value::Ptr, sizeof...(OperandRewriters)>;
+        auto values = std::apply(
+            [&](const auto &...rewriters) { return Values{rewriters.rewrite(op, bindings, builder)...}; }, operands);
+        auto newOp = std::apply(
+            [&](const auto &...operandValues) { return builder.insert<AdaptorType>(op->ref, kind, operandValues...); },
+            values);
+        return newOp.result();
+    }
+};
+
+// Arbitrary rewrite, the rule is not applied if it returns null value
+template <typename FunctionType>
+struct FunctionRewriter {
+    FunctionType function;
+
+    Value::Ptr rewrite(const Operation::Ptr &op, const Bindings &bindings, OptBuilder &builder) const {
+        return function(op, bindings, builder);
+    }
+};
+
+template <typename T>
+auto toRewriter(T rewriter) {
+    if constexpr (Rewriter<T>)
+        return rewriter;
+    else
+        return FunctionRewriter<T>{std::move(rewriter)};
+}
+
+// ----------------------------------------------------------------------------
+// Rules
+// ----------------------------------------------------------------------------
+
+// Replaces the single result of the matched root operation with the rewritten value and erases the operation
+template <OpPattern PatternType, Rewriter RewriterType>
+struct Rule {
+    using Root = typename PatternType::Root;
+
+    PatternType pattern;
+    RewriterType rewriter;
+
+    bool apply(const Operation::Ptr &op, OptBuilder &builder) const {
+        Bindings bindings;
+        if (op->numResults() != 1U || !pattern.matchOp(op, bindings))
+            return false;
+        auto value = rewriter.rewrite(op, bindings, builder);
+        if (!value)
+            return false;
+        builder.replace(op->result(0), value);
+        builder.erase(op);
+        return true;
+    }
+};
+
+template <OpPattern PatternType, typename RewriterType>
+auto operator>>(PatternType pattern, RewriterType rewriter) {
+    auto concreteRewriter = toRewriter(std::move(rewriter));
+    return Rule<PatternType, decltype(concreteRewriter)>{std::move(pattern), std::move(concreteRewriter)};
+}
+
+// Rules grouped by the root operation, they are tried in the order of addition until one of them is applied
+class RuleSet {
+    using Applier = std::function<bool(const Operation::Ptr &, OptBuilder &)>;
+
+    std::unordered_map<Operation::SpecId, std::vector<Applier>> rules;
+
+  public:
+    RuleSet() = default;
+    RuleSet(const RuleSet &) = default;
+    RuleSet(RuleSet &&) = default;
+    ~RuleSet() = default;
+
+    template <typename... RuleTypes>
+    explicit RuleSet(RuleTypes... rules) {
+        (add(std::move(rules)), ...);
+    }
+
+    template <typename RuleType>
+    RuleSet &add(RuleType rule) {
+        rules[RuleType::Root::getSpecId()].emplace_back([rule = std::move(rule)](const Operation::Ptr &op,
+                                                                                 OptBuilder &builder) {
+            return rule.apply(op, builder);
+        });
+        return *this;
+    }
+
+    bool apply(const Operation::Ptr &op, OptBuilder &builder) const {
+        auto it = rules.find(op->getSpecId());
+        if (it == rules.end())
+            return false;
+        for (const auto &rule : it->second)
+            if (rule(op, builder))
+                return true;
+        return false;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Pattern constructors
+// ----------------------------------------------------------------------------
+
+inline AnyValue m_Any() {
+    return {};
+}
+
+template <size_t Index>
+BoundValue<Index> m_Any(Placeholder<Index>) {
+    return {};
+}
+
+inline AnyConst<std::tuple_size_v<Bindings>> m_Const() {
+    return {};
+}
+
+template <size_t Index>
+AnyConst<Index> m_Const(Placeholder<Index>) {
+    return {};
+}
+
+template <typename T>
+    requires std::is_arithmetic_v<T>
+auto m_Const(T value) {
+    return ConstValue<decltype(toNative(value))>{toNative(value)};
+}
+
+inline TruthyConst m_Truthy(bool value) {
+    return {value};
+}
+
+template <ValuePattern LhsPattern, ValuePattern RhsPattern>
+auto m_ArithBinary(ArithBinOpKind kind, LhsPattern lhs, RhsPattern rhs) {
+    return KindOpPattern<ArithBinaryOp, ArithBinOpKind, LhsPattern, RhsPattern>{kind, {lhs, rhs}};
+}
+
+template <ValuePattern OperandPattern>
+auto m_ArithUnary(ArithUnaryOpKind kind, OperandPattern value) {
+    return KindOpPattern<ArithUnaryOp, ArithUnaryOpKind, OperandPattern>{kind, {value}};
+}
+
+template <ValuePattern LhsPattern, ValuePattern RhsPattern>
+auto m_LogicBinary(LogicBinOpKind kind, LhsPattern lhs, RhsPattern rhs) {
+    return KindOpPattern<LogicBinaryOp, LogicBinOpKind, LhsPattern, RhsPattern>{kind, {lhs, rhs}};
+}
+
+template <ValuePattern OperandPattern>
+auto m_LogicUnary(LogicUnaryOpKind kind, OperandPattern value) {
+    return KindOpPattern<LogicUnaryOp, LogicUnaryOpKind, OperandPattern>{kind, {value}};
+}
+
+template <typename AdaptorType, typename KindType, ValuePattern LhsPattern, ValuePattern RhsPattern>
+auto m_Commuted(KindOpPattern<AdaptorType, KindType, LhsPattern, RhsPattern> pattern) {
+    return CommutedPattern<decltype(pattern)>{std::move(pattern)};
+}
+
+// ----------------------------------------------------------------------------
+// Rewriter constructors
+// ----------------------------------------------------------------------------
+
+template <typename T>
+    requires std::is_arithmetic_v<T>
+auto r_Const(T value) {
+    return ConstRewriter<decltype(toNative(value))>{toNative(value)};
+}
+
+template <Rewriter LhsRewriter, Rewriter RhsRewriter>
+auto r_ArithBinary(ArithBinOpKind kind, LhsRewriter lhs, RhsRewriter rhs) {
+    return KindOpRewriter<ArithBinaryOp, ArithBinOpKind, LhsRewriter, RhsRewriter>{kind, {lhs, rhs}};
+}
+
+template <Rewriter OperandRewriter>
+auto r_ArithUnary(ArithUnaryOpKind kind, OperandRewriter value) {
+    return KindOpRewriter<ArithUnaryOp, ArithUnaryOpKind, OperandRewriter>{kind, {value}};
+}
+
+} // namespace patterns
+} // namespace optimizer
+} // namespace optree
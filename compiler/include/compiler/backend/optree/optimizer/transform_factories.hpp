@@ -1,19 +1,66 @@
 #pragma once
 
+#include <cstddef>
+
 #include "compiler/backend/optree/optimizer/transform.hpp"
 
 namespace optree {
 namespace optimizer {
 
+// Chains of at least minCases nested IfOp comparing the same integer value with distinct constants are turned into
+// a single SwitchOp
+BaseTransform::Ptr createConvertIfChainsToSwitches(size_t minCases = 3U);
+BaseTransform::Ptr createEliminateCommonSubexpressions();
+// Loads are replaced with the values stored to the same memory before, stores which are overwritten or never read
+// are erased along with the allocations which are never loaded from
+BaseTransform::Ptr createEliminateDeadStores();
+// Self-recursive tail calls, including ones combined with an addition or a multiplication, are turned into a loop
+BaseTransform::Ptr createEliminateTailRecursion();
 BaseTransform::Ptr createEraseUnusedFunctions();
 BaseTransform::Ptr createEraseUnusedOps();
+// Calls with constant arguments are evaluated at compile time, giving up when the evaluation performs IO or exceeds
+// maxSteps operations or maxDepth nested calls
+BaseTransform::Ptr createEvaluatePureCalls(size_t maxSteps = 100000U, size_t maxDepth = 256U);
 BaseTransform::Ptr createFoldConstants();
 BaseTransform::Ptr createFoldControlFlowOps();
+// Adjacent loops over the same iteration space are merged into one, if they access the same memory only through
+// the elements indexed by their iterators, so the iterations of the second loop can be moved into the first one
+BaseTransform::Ptr createFuseLoops();
 BaseTransform::Ptr createHoistLoopInvariants();
+// Calls are inlined if the callee is decorated with @inline or its size multiplied by the number of its calls
+// does not exceed sizeThreshold operations
+BaseTransform::Ptr createInlineFunctions(size_t sizeThreshold = 64U);
 BaseTransform::Ptr createJoinConditionsBranches();
+// Functions with identical bodies and types, which differ only by their names, are merged into the first of them
+BaseTransform::Ptr createMergeIdenticalFunctions();
 BaseTransform::Ptr createMinimizeBoolExpression();
+// Outermost loops without dependences between their iterations are outlined into separate functions, calls of
+// which are run by the parallel runtime, loops with fewer than minTripCount iterations are kept sequential
+BaseTransform::Ptr createParallelizeLoops(size_t minTripCount = 1000U);
+// Lists larger than heapThreshold bytes or having dynamic size are allocated on the heap
+BaseTransform::Ptr createPlaceAllocations(size_t heapThreshold = 4096U);
+BaseTransform::Ptr createPromoteAllocations();
+// Constants are propagated jointly with the executability of regions and through arguments of called functions
+BaseTransform::Ptr createPropagateConditionalConstants();
 BaseTransform::Ptr createPropagateConstants();
+// Constant arguments common to all call sites are moved into the callee, frequent tuples of constant arguments get
+// specialized copies of the callee within sizeBudget operations in total, unused parameters and results are erased
+BaseTransform::Ptr createPropagateInterproceduralConstants(size_t sizeBudget = 256U);
+// Algebraic identities, reassociation of constants, shifts by powers of two and induction variable multiplications
+BaseTransform::Ptr createReduceStrength();
 BaseTransform::Ptr createSinkControlFlowOps();
+// Lists of at most maxElements elements, which are accessed only by the elements at constant offsets, are split into
+// separate allocations of the elements, so they can be promoted to values
+BaseTransform::Ptr createSplitAllocations(size_t maxElements = 16U);
+// Loops with constant bounds are unrolled fully if the unrolled body does not exceed sizeThreshold operations,
+// otherwise the body is replicated factor times
+BaseTransform::Ptr createUnrollLoops(size_t factor = 4U, size_t sizeThreshold = 64U);
+// Loops branching on a condition which is not changed by them are duplicated for both of its values under a single
+// IfOp, as long as the duplicated loops do not exceed sizeBudget operations in total
+BaseTransform::Ptr createUnswitchLoops(size_t sizeBudget = 64U);
+// Innermost loops with independent iterations over consecutive elements are rewritten to process vectorBits
+// at once, the original loop is kept as an epilogue for the remaining iterations
+BaseTransform::Ptr createVectorizeLoops(unsigned vectorBits = 256U);
 
 } // namespace optimizer
 } // namespace optree
@@ -58,6 +58,8 @@ DECLARE_SEMANTIZER_TRAIT(HasResultOfType, const Type::Ptr &type);
 DECLARE_SEMANTIZER_TRAIT(HasInwards, size_t numInwards);
 DECLARE_SEMANTIZER_TRAIT(HasInwardsOfType, size_t numInwards, const Type::Ptr &type);
 DECLARE_SEMANTIZER_TRAIT(HasAttributes, size_t numAttrs);
+// Profile counts are attached to the operation only when the program is compiled with a profile
+DECLARE_SEMANTIZER_TRAIT(HasOptionalProfileCounts, size_t numCounts);
 template <typename T>
 DECLARE_SEMANTIZER_TRAIT(HasNthAttrOfType, size_t index);
 
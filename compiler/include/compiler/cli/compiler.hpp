@@ -27,6 +27,7 @@ class Compiler {
     int runLexer();
     int runParser();
     int runConverter();
+    int runProfileReader();
 
     int runAstSemantizer();
     int runAstOptimizer();
@@ -35,6 +36,7 @@ class Compiler {
 #endif
 
     int runOptreeOptimizer();
+    int runOptreeInterpreter();
 #ifdef ENABLE_CODEGEN_OPTREE_TO_LLVMIR
     int runOptreeLLVMIRGenerator();
 #endif
@@ -22,4 +22,7 @@ std::string wrapQuotes(const std::string &str);
 
 std::string makeCommand(const std::vector<std::string> &args);
 
+// Width of the vector registers of the host, in bits
+unsigned hostVectorBits();
+
 } // namespace cli
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <exception>
 #include <optional>
 #include <string>
@@ -16,9 +17,14 @@ namespace arg {
 
 constexpr std::string_view debug = "--debug";
 constexpr std::string_view optimize = "--optimize";
+constexpr std::string_view heapThreshold = "--heap-threshold";
+constexpr std::string_view parallelize = "--parallelize";
+constexpr std::string_view parallelThreshold = "--parallel-threshold";
 constexpr std::string_view time = "--time";
 constexpr std::string_view stopAfter = "--stop-after";
 constexpr std::string_view backend = "--backend";
+constexpr std::string_view interpret = "--interpret";
+constexpr std::string_view profileUse = "--profile-use";
 constexpr std::string_view files = "FILES";
 
 #ifdef LLVMIR_CODEGEN_ENABLED
@@ -27,6 +33,9 @@ constexpr std::string_view compile = "--compile";
 constexpr std::string_view clang = "--clang";
 constexpr std::string_view llc = "--llc";
 constexpr std::string_view output = "--output";
+constexpr std::string_view codegenJobs = "--codegen-jobs";
+constexpr std::string_view runtimeLibrary = "--runtime-library";
+constexpr std::string_view profileGenerate = "--profile-generate";
 #endif
 
 } // namespace arg
@@ -39,6 +48,7 @@ constexpr std::string_view parser = "parser";
 constexpr std::string_view converter = "converter";
 constexpr std::string_view semantizer = "semantizer";
 constexpr std::string_view optimizer = "optimizer";
+constexpr std::string_view interpreter = "interpreter";
 
 #ifdef LLVMIR_CODEGEN_ENABLED
 constexpr std::string_view codegen = "codegen";
@@ -66,13 +76,21 @@ struct Options {
     std::string backend;
     bool time;
     bool optimize;
+    size_t heapThreshold;
+    bool parallelize;
+    size_t parallelThreshold;
     std::optional<std::string> stopAfter;
+    bool interpret;
+    std::string profileUse;
 #ifdef LLVMIR_CODEGEN_ENABLED
     std::string codegen;
     bool compile;
     std::string clang;
     std::string llc;
     std::string output;
+    unsigned codegenJobs;
+    std::string runtimeLibrary;
+    std::string profileGenerate;
 #endif
     std::vector<std::string> files;
     std::string helpMessage;
@@ -1,14 +1,21 @@
 #pragma once
 
+#include <cstddef>
 #include <deque>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <llvm/IR/DerivedTypes.h>
 #include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalVariable.h>
 #include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Instructions.h>
 #include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Metadata.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/NoFolder.h>
 #include <llvm/IR/Type.h>
@@ -27,6 +34,12 @@ namespace llvmir_generator {
 class LLVMIRGenerator {
     using IRBuilder = llvm::IRBuilder<llvm::NoFolder>;
 
+  public:
+    using Ptr = std::unique_ptr<LLVMIRGenerator>;
+    // Maps contents of global strings to symbol names shared between modules of the same program
+    using SharedStrings = std::unordered_map<std::string, std::string>;
+
+  private:
     llvm::LLVMContext context;
     IRBuilder builder;
     llvm::Module mod;
@@ -36,16 +49,38 @@ class LLVMIRGenerator {
     std::unordered_map<std::string, llvm::Value *> globalStrings;
     std::unordered_map<std::string_view, llvm::FunctionCallee> externalFunctions;
     std::deque<llvm::BasicBlock *> basicBlocks;
+    std::unordered_set<const Operation *> definedFunctions;
+    std::unordered_set<std::string> parallelFunctions;
+    const SharedStrings *sharedStrings;
+    std::string profilePath;
+    // Index of the first counter of each instrumented operation, its counters follow in the order of its keys
+    std::unordered_map<const Operation *, size_t> profileCounters;
+    std::vector<std::string> profileKeys;
+    llvm::GlobalVariable *profileCountersArray;
 
     llvm::Value *findValue(const Value::Ptr &value) const;
     void saveValue(const Value::Ptr &value, llvm::Value *llvmValue);
     llvm::Type *convertType(const Type::Ptr &type);
+    llvm::Value *convertConstant(const Type::Ptr &type, const ConstantOp &op);
+    llvm::Align alignOf(llvm::Type *type) const;
     llvm::BasicBlock *createBlock();
     void eraseDeadBlocks();
     llvm::Value *normalizePredicate(const Value::Ptr &cond);
     llvm::Value *getGlobalString(const std::string &str);
     llvm::FunctionCallee getExternalFunction(std::string_view name);
     llvm::FunctionCallee loadExternalFunction(std::string_view name);
+    llvm::Function *declareFunction(const FunctionOp &op);
+    llvm::AllocaInst *createEntryAlloca(llvm::Type *type, size_t numElements = 1U);
+    std::vector<llvm::PHINode *> createCarriedPhis(const std::vector<Value::Ptr> &inits,
+                                                   const std::vector<Value::Ptr> &inwards,
+                                                   const std::vector<Value::Ptr> &results, llvm::BasicBlock *preheader);
+    void addCarriedIncomings(const std::vector<llvm::PHINode *> &phis, const YieldOp &yieldOp, llvm::BasicBlock *latch);
+    llvm::Function *getParallelTask(llvm::Function *callee, llvm::StructType *contextType);
+    void createParallelCall(const FunctionCallOp &op);
+    void collectProfileCounters(const Operation::Ptr &op);
+    void createProfileCounters();
+    void incrementProfileCounter(const Operation::Ptr &op, size_t index);
+    llvm::MDNode *createBranchWeights(const Operation::Ptr &op);
 
     void visit(const Operation::Ptr &op);
     void visitBody(const Operation::Ptr &op);
@@ -63,15 +98,21 @@ class LLVMIRGenerator {
     void visit(const LogicUnaryOp &op);
 
     void visit(const AllocateOp &op);
+    void visit(const HeapAllocateOp &op);
+    void visit(const DeallocateOp &op);
     void visit(const LoadOp &op);
     void visit(const StoreOp &op);
 
     void visit(const IfOp &op);
     void visit(const ThenOp &op);
     void visit(const ElseOp &op);
+    void visit(const SwitchOp &op);
+    void visit(const CaseOp &op);
+    void visit(const DefaultOp &op);
     void visit(const WhileOp &op);
     void visit(const ConditionOp &op);
     void visit(const ForOp &op);
+    void visit(const YieldOp &op);
 
     void visit(const InputOp &op);
     void visit(const PrintOp &op);
@@ -84,7 +125,16 @@ class LLVMIRGenerator {
 
     explicit LLVMIRGenerator(const std::string &moduleName);
 
+    // Instruments the generated code with counters of the operations, which are written to the profile at the exit
+    void instrument(const std::string &profilePath);
+
     void process(const Program &program);
+    // Generates definitions of the given functions only, all other functions of the program are declared
+    void process(const Program &program, const std::vector<FunctionOp> &functions, const SharedStrings &strings);
+
+    // Splits functions of the program into shards and generates a separate module for each of them concurrently
+    static std::vector<Ptr> processInParallel(const Program &program, const std::string &moduleName, size_t numShards,
+                                              const std::string &profilePath = {});
 
     std::string dump() const;
     void dump(llvm::raw_ostream &stream) const;
@@ -54,6 +54,7 @@ enum class Special {
     EndOfExpression,
     Arrow,
     Colon,
+    At,
 };
 
 enum class TokenType {
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace optree {
+namespace interpreter {
+
+// Opcodes of the register machine. Suffixes denote the type of the operands: I for integers and booleans,
+// F for floats, S for strings and P for pointers. Operands of the instruction are register indices, except:
+// - jump targets, which are instruction indices: Jump a, JumpIfNot cond, b, JumpIfGreaterEqualI lhs, rhs, c
+// - TruncI c, which is the bit width of the result
+// - Call b, which is the function index, and Call c, which is the offset of its arguments in the function pool
+// - FrameAddress b, which is the offset of the memory cell in the frame
+// Instructions producing a value store it to register a, Store and StoreAt write b to the memory at a.
+#define INTERPRETER_OPCODES(X)                                                                                         \
+    X(Move)                                                                                                            \
+    X(AddI)                                                                                                            \
+    X(SubI)                                                                                                            \
+    X(MulI)                                                                                                            \
+    X(DivI)                                                                                                            \
+    X(ShlI)                                                                                                            \
+    X(ShrI)                                                                                                            \
+    X(AddF)                                                                                                            \
+    X(SubF)                                                                                                            \
+    X(MulF)                                                                                                            \
+    X(DivF)                                                                                                            \
+    X(EqualI)                                                                                                          \
+    X(NotEqualI)                                                                                                       \
+    X(LessI)                                                                                                           \
+    X(GreaterI)                                                                                                        \
+    X(LessEqualI)                                                                                                      \
+    X(GreaterEqualI)                                                                                                   \
+    X(EqualF)                                                                                                          \
+    X(NotEqualF)                                                                                                       \
+    X(LessF)                                                                                                           \
+    X(GreaterF)                                                                                                        \
+    X(LessEqualF)                                                                                                      \
+    X(GreaterEqualF)                                                                                                   \
+    X(AndI)                                                                                                            \
+    X(OrI)                                                                                                             \
+    X(NotI)                                                                                                            \
+    X(NegI)                                                                                                            \
+    X(NegF)                                                                                                            \
+    X(IntToFloat)                                                                                                      \
+    X(FloatToInt)                                                                                                      \
+    X(TruncI)                                                                                                          \
+    X(TruncF)                                                                                                          \
+    X(Jump)                                                                                                            \
+    X(JumpIfNot)                                                                                                       \
+    X(JumpIfGreaterEqualI)                                                                                             \
+    X(Call)                                                                                                            \
+    X(Return)                                                                                                          \
+    X(ReturnVoid)                                                                                                      \
+    X(FrameAddress)                                                                                                    \
+    X(Allocate)                                                                                                        \
+    X(HeapAllocate)                                                                                                    \
+    X(Deallocate)                                                                                                      \
+    X(Load)                                                                                                            \
+    X(LoadAt)                                                                                                          \
+    X(Store)                                                                                                           \
+    X(StoreAt)                                                                                                         \
+    X(PrintI)                                                                                                          \
+    X(PrintF)                                                                                                          \
+    X(PrintS)                                                                                                          \
+    X(PrintP)                                                                                                          \
+    X(PrintNone)                                                                                                       \
+    X(InputI)                                                                                                          \
+    X(InputF)                                                                                                          \
+    X(InputS)
+
+enum class Opcode : uint8_t {
+#define INTERPRETER_OPCODE_ENUM(NAME) NAME,
+    INTERPRETER_OPCODES(INTERPRETER_OPCODE_ENUM)
+#undef INTERPRETER_OPCODE_ENUM
+};
+
+const char *opcodeName(Opcode opcode);
+
+union Register {
+    int64_t i;
+    double f;
+    const char *s;
+    Register *p;
+};
+
+static_assert(sizeof(Register) == sizeof(int64_t));
+
+struct Instruction {
+    static constexpr uint32_t noRegister = std::numeric_limits<uint32_t>::max();
+
+    Opcode opcode;
+    uint32_t a = noRegister;
+    uint32_t b = noRegister;
+    uint32_t c = noRegister;
+};
+
+// Frame of the function is a flat array of registers followed by the memory cells of its fixed-size allocations.
+// Registers are assigned once per value of the operation tree, the first ones hold the function arguments.
+struct Function {
+    std::string name;
+    std::vector<Instruction> code;
+    // Initial contents of the frame with the constants preloaded to their registers
+    std::vector<Register> frame;
+    // Register lists of the call arguments referenced by Call instructions
+    std::vector<uint32_t> arguments;
+    uint32_t numRegisters = 0;
+    uint32_t numArguments = 0;
+};
+
+// Program lowered from the operation tree. It can be moved, but not copied, as the registers of the frames point
+// to the owned strings.
+struct Bytecode {
+    std::vector<Function> functions;
+    std::deque<std::string> strings;
+
+    Bytecode() = default;
+    Bytecode(const Bytecode &) = delete;
+    Bytecode(Bytecode &&) = default;
+    ~Bytecode() = default;
+
+    const Function *lookup(const std::string &name) const;
+    void dump(std::ostream &stream) const;
+    std::string dump() const;
+};
+
+// Failure of the bytecode generation on unsupported operations or of the program execution
+class InterpreterError : public std::exception {
+    std::string message;
+
+  public:
+    InterpreterError(const std::string &message) : message(message){};
+    ~InterpreterError() override = default;
+
+    InterpreterError &operator=(const InterpreterError &) noexcept = default;
+
+    const char *what() const noexcept override {
+        return message.c_str();
+    }
+};
+
+} // namespace interpreter
+} // namespace optree
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "compiler/interpreter/bytecode.hpp"
+#include "compiler/optree/program.hpp"
+
+namespace optree {
+namespace interpreter {
+
+// Lowers the structured control flow of the operation tree to jumps and assigns a register to each value.
+// Throws InterpreterError if the program contains operations which have no bytecode counterpart.
+Bytecode generateBytecode(const Program &program);
+
+} // namespace interpreter
+} // namespace optree
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "compiler/interpreter/bytecode.hpp"
+
+namespace optree {
+namespace interpreter {
+
+// Interpreter of the register bytecode. Print and input instructions follow the formats of printf and scanf calls
+// emitted by the LLVM IR codegen, so the output of the interpreted program is the same as of the compiled one.
+class VirtualMachine {
+    // Stack of frames and dynamic allocations made of chunks, so the allocated cells are not moved when it grows
+    class Stack {
+        std::vector<std::vector<Register>> chunks;
+        size_t chunk;
+        size_t top;
+
+      public:
+        struct Mark {
+            size_t chunk;
+            size_t top;
+        };
+
+        Stack();
+
+        Register *allocate(size_t size);
+
+        Mark mark() const {
+            return {chunk, top};
+        }
+
+        void release(const Mark &mark) {
+            chunk = mark.chunk;
+            top = mark.top;
+        }
+    };
+
+    struct CallRecord {
+        const Function *function;
+        const Instruction *pc;
+        Register *frame;
+        Stack::Mark mark;
+    };
+
+    const Bytecode &bytecode;
+    std::istream &input;
+    std::ostream &output;
+    size_t maxDepth;
+    Stack stack;
+    std::unordered_map<const Register *, std::unique_ptr<Register[]>> heap;
+    std::deque<std::string> inputStrings;
+
+    Register *enter(const Function &function);
+
+  public:
+    VirtualMachine() = delete;
+    VirtualMachine(const VirtualMachine &) = delete;
+    VirtualMachine(VirtualMachine &&) = delete;
+    ~VirtualMachine() = default;
+
+    VirtualMachine(const Bytecode &bytecode, std::istream &input, std::ostream &output, size_t maxDepth = 1U << 20);
+
+    // Value returned by the call of the function, which is unspecified if it returns nothing.
+    // Throws InterpreterError on runtime errors, such as division by zero or too deep recursion.
+    Register call(const std::string &name, const std::vector<Register> &arguments = {});
+};
+
+} // namespace interpreter
+} // namespace optree
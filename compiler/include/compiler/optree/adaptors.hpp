@@ -39,6 +39,7 @@ struct ModuleOp : Adaptor {
     }
 };
 
+// FunctionOp attributes following the function type are names of its decorators and its optional profile count
 struct FunctionOp : Adaptor {
     OPTREE_ADAPTOR_HELPER(Adaptor, "Function")
 
@@ -46,6 +47,11 @@ struct FunctionOp : Adaptor {
 
     OPTREE_ADAPTOR_ATTRIBUTE(name, setName, std::string, 0)
     OPTREE_ADAPTOR_ATTRIBUTE_TYPE(type, FunctionType, 1)
+
+    bool hasDecorator(const std::string &decorator) const;
+    void addDecorator(const std::string &decorator);
+
+    static constexpr size_t numRequiredAttrs = 2U;
 };
 
 struct FunctionCallOp : Adaptor {
@@ -158,6 +164,8 @@ struct LogicUnaryOp : UnaryOp {
 // ----------------------------------------------------------------------------
 
 struct AllocateOp;
+struct HeapAllocateOp;
+struct DeallocateOp;
 struct LoadOp;
 struct StoreOp;
 
@@ -173,6 +181,27 @@ struct AllocateOp : Adaptor {
     void setDynamicSize(const Value::Ptr &value);
 };
 
+// Allocation with a lifetime limited by DeallocateOp instead of the function frame
+struct HeapAllocateOp : Adaptor {
+    OPTREE_ADAPTOR_HELPER(Adaptor, "HeapAllocate")
+
+    void init(const Type::Ptr &type, const Value::Ptr &dynamicSize = {});
+
+    OPTREE_ADAPTOR_RESULT(result, 0)
+
+    // dynamicSize is an optional operand
+    Value::Ptr dynamicSize() const;
+    void setDynamicSize(const Value::Ptr &value);
+};
+
+struct DeallocateOp : Adaptor {
+    OPTREE_ADAPTOR_HELPER(Adaptor, "Deallocate")
+
+    void init(const Value::Ptr &ptr);
+
+    OPTREE_ADAPTOR_OPERAND(ptr, setPtr, 0)
+};
+
 struct LoadOp : Adaptor {
     OPTREE_ADAPTOR_HELPER(Adaptor, "Load")
 
@@ -207,10 +236,15 @@ struct StoreOp : Adaptor {
 struct IfOp;
 struct ThenOp;
 struct ElseOp;
+struct SwitchOp;
+struct CaseOp;
+struct DefaultOp;
 struct WhileOp;
 struct ConditionOp;
 struct ForOp;
+struct YieldOp;
 
+// IfOp results are merged from the operands of YieldOp terminating both ThenOp and ElseOp
 struct IfOp : Adaptor {
     OPTREE_ADAPTOR_HELPER(Adaptor, "If")
 
@@ -226,20 +260,59 @@ struct ThenOp : Adaptor {
     OPTREE_ADAPTOR_HELPER(Adaptor, "Then")
 
     void init();
+
+    YieldOp yieldOp() const;
 };
 
 struct ElseOp : Adaptor {
     OPTREE_ADAPTOR_HELPER(Adaptor, "Else")
 
     void init();
+
+    YieldOp yieldOp() const;
+};
+
+// SwitchOp runs the CaseOp having the value equal to the integer operand, or DefaultOp if there is no such case,
+// its results are merged from the operands of YieldOp terminating all of them
+struct SwitchOp : Adaptor {
+    OPTREE_ADAPTOR_HELPER(Adaptor, "Switch")
+
+    void init(const Value::Ptr &value, const std::vector<NativeInt> &caseValues, bool withDefault = false);
+
+    OPTREE_ADAPTOR_OPERAND(value, setValue, 0);
+
+    size_t numCases() const;
+    CaseOp caseOp(size_t index) const;
+    DefaultOp defaultOp() const;
+};
+
+struct CaseOp : Adaptor {
+    OPTREE_ADAPTOR_HELPER(Adaptor, "Case")
+
+    void init(NativeInt value);
+
+    OPTREE_ADAPTOR_ATTRIBUTE(value, setValue, NativeInt, 0)
+
+    YieldOp yieldOp() const;
+};
+
+struct DefaultOp : Adaptor {
+    OPTREE_ADAPTOR_HELPER(Adaptor, "Default")
+
+    void init();
+
+    YieldOp yieldOp() const;
 };
 
+// WhileOp operands are initial values of its inwards (loop-carried values), YieldOp terminating the body
+// passes their values to the next iteration, and results hold their values on exit from the loop
 struct WhileOp : Adaptor {
     OPTREE_ADAPTOR_HELPER(Adaptor, "While")
 
     void init();
 
     ConditionOp conditionOp() const;
+    YieldOp yieldOp() const;
 };
 
 struct ConditionOp : Adaptor {
@@ -250,6 +323,8 @@ struct ConditionOp : Adaptor {
     Value::Ptr terminator() const;
 };
 
+// ForOp operands following step are initial values of its inwards following iterator (loop-carried values),
+// they are passed between iterations in the same way as for WhileOp
 struct ForOp : Adaptor {
     OPTREE_ADAPTOR_HELPER(Adaptor, "For")
 
@@ -259,6 +334,16 @@ struct ForOp : Adaptor {
     OPTREE_ADAPTOR_OPERAND(stop, setStop, 1)
     OPTREE_ADAPTOR_OPERAND(step, setStep, 2)
     OPTREE_ADAPTOR_INWARD(iterator, 0)
+
+    YieldOp yieldOp() const;
+
+    static constexpr size_t numControlOperands = 3U;
+};
+
+struct YieldOp : Adaptor {
+    OPTREE_ADAPTOR_HELPER(Adaptor, "Yield")
+
+    void init(const std::vector<Value::Ptr> &values = {});
 };
 
 // ----------------------------------------------------------------------------
@@ -91,7 +91,7 @@ class DeclarativeModule {
     const Type::Ptr tBool;
     const Type::Ptr tF64;
     const Type::Ptr tStr;
-    Type::Ptr tPtr(const Type::Ptr &pointee) const;
+    Type::Ptr tPtr(const Type::Ptr &pointee, size_t numElements = 1U) const;
     Type::Ptr tFunc(const Type::Ptr &result) const;
     Type::Ptr tFunc(Type::PtrVector &&arguments, const Type::Ptr &result) const;
 
@@ -141,6 +141,7 @@ class DeclarativeModule {
     }
 
     DeclarativeModule &result(const Type::Ptr &type);
+    DeclarativeModule &result(DeclarativeValue &result, const Type::Ptr &type);
     DeclarativeModule &inward(DeclarativeValue &inward, const Type::Ptr &type);
     DeclarativeModule &inward(DeclarativeValue &inward, size_t index);
     void withBody();
@@ -12,6 +12,9 @@ enum class ArithBinOpKind {
     SubF,
     MulF,
     DivF,
+    ShlI,
+    // Arithmetic shift, which keeps the sign of the value
+    ShrI,
 };
 
 enum class ArithCastOpKind {
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "compiler/optree/attribute.hpp"
+#include "compiler/optree/definitions.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/value.hpp"
+
+namespace optree {
+
+std::optional<Attribute> foldArithBinary(ArithBinOpKind kind, const Attribute &lhs, const Attribute &rhs);
+std::optional<Attribute> foldArithCast(ArithCastOpKind kind, const Attribute &value);
+std::optional<Attribute> foldArithUnary(ArithUnaryOpKind kind, const Attribute &value);
+std::optional<Attribute> foldLogicBinary(LogicBinOpKind kind, const Attribute &lhs, const Attribute &rhs);
+
+// Result of the computational operation over constant operands, empty if the operation can not be folded
+// or its result is undefined, e.g. on division by zero, which is left to trap at runtime
+std::optional<Attribute> fold(const Operation::Ptr &op, const std::vector<Attribute> &operands);
+
+// Interpreter of the module functions over constant arguments. Evaluation gives up on IO, calls of unknown
+// functions, reads of uninitialized memory and undefined results, as well as when the steps of the top-level call
+// or the depth of recursion are exhausted. Results of all calls, including failed ones, are memoized.
+class Evaluator {
+    using Memory = std::shared_ptr<std::vector<Attribute>>;
+    using Slot = std::variant<Attribute, Memory>;
+    using Frame = std::unordered_map<const Value *, Slot>;
+
+    enum class Exit {
+        Next,
+        Return,
+        Fail,
+    };
+
+    struct Context {
+        Frame values;
+        std::vector<Slot> yielded;
+        std::optional<Attribute> returned;
+    };
+
+    Operation::Ptr moduleOp;
+    size_t maxSteps;
+    size_t maxDepth;
+    size_t steps = 0;
+    size_t depth = 0;
+    bool exhausted = false;
+    std::unordered_map<std::string, std::optional<Attribute>> memo;
+
+    Exit runBody(const Operation::Ptr &region, Context &context, size_t skip = 0U);
+    Exit run(const Operation::Ptr &op, Context &context);
+    Exit runLoop(const Operation::Ptr &op, Context &context);
+    std::optional<Attribute> evaluate(const std::string &name, const std::vector<Attribute> &arguments);
+
+  public:
+    Evaluator() = delete;
+    Evaluator(const Evaluator &) = delete;
+    Evaluator(Evaluator &&) = default;
+    ~Evaluator() = default;
+
+    explicit Evaluator(const Operation::Ptr &moduleOp, size_t maxSteps = 100000U, size_t maxDepth = 256U);
+
+    // Value returned by the call of the function, empty if it can not be evaluated or returns nothing
+    std::optional<Attribute> call(const std::string &name, const std::vector<Attribute> &arguments);
+};
+
+} // namespace optree
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstddef>
+
 #include "compiler/utils/source_ref.hpp"
 
 #include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/attribute.hpp"
 #include "compiler/optree/builder.hpp"
 #include "compiler/optree/types.hpp"
 #include "compiler/optree/value.hpp"
@@ -23,4 +26,12 @@ AdaptorType getValueOwnerAs(const Value::Ptr &value) {
 
 bool similar(const Operation::Ptr &lhs, const Operation::Ptr &rhs, bool checkBody = true);
 
+// The predicate computed last in the condition region of WhileOp is used by the loop implicitly
+bool isConditionPredicate(const Operation::Ptr &op);
+
+// Floats are compared bitwise, since 0.0 and -0.0 are equal but not interchangeable
+bool sameAttribute(const Attribute &lhs, const Attribute &rhs);
+
+size_t hashAttribute(const Attribute &attr);
+
 } // namespace optree
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/value.hpp"
+
+namespace optree {
+
+struct LoadOp;
+struct StoreOp;
+
+enum class MemoryEffectKind {
+    Read,
+    Write,
+    Allocate,
+    Free,
+    // Interaction with the program environment, which must keep its order
+    IO,
+};
+
+struct MemoryEffect {
+    MemoryEffectKind kind;
+    // Accessed memory, empty if the operation may access any memory
+    Value::Ptr ptr;
+    // Accessed element, empty means the first element unless wholeObject is set
+    Value::Ptr offset;
+    bool wholeObject = false;
+
+    bool isMemoryAccess() const {
+        return kind != MemoryEffectKind::IO && kind != MemoryEffectKind::Allocate;
+    }
+
+    bool modifiesMemory() const {
+        return kind == MemoryEffectKind::Write || kind == MemoryEffectKind::Free;
+    }
+};
+
+using MemoryEffects = std::vector<MemoryEffect>;
+
+// Memory accessed by the operation, vector accesses cover several elements and are treated as whole object ones
+MemoryEffect readEffect(const LoadOp &op);
+MemoryEffect writeEffect(const StoreOp &op);
+
+enum class AliasResult {
+    NoAlias,
+    MayAlias,
+    MustAlias,
+};
+
+// Allocation the pointer is derived from, empty if the pointer has an unknown origin
+Operation::Ptr getPointerRoot(const Value::Ptr &ptr);
+
+AliasResult alias(const MemoryEffect &lhs, const MemoryEffect &rhs);
+
+// Calls are described by the summaries of the callees computed over the whole module, the calls of unknown
+// functions may read and write any memory and perform IO
+class MemoryEffectsAnalysis {
+    struct FunctionSummary {
+        std::vector<bool> readArguments;
+        std::vector<bool> writtenArguments;
+        bool readsUnknown = false;
+        bool writesUnknown = false;
+        bool performsIO = false;
+
+        bool operator==(const FunctionSummary &) const = default;
+    };
+
+    std::unordered_map<std::string, FunctionSummary> summaries;
+
+    void collectEffects(const Operation::Ptr &op, MemoryEffects &effects) const;
+    void collectCallEffects(const Operation::Ptr &op, MemoryEffects &effects) const;
+    FunctionSummary summarize(const Operation::Ptr &funcOp) const;
+
+  public:
+    MemoryEffectsAnalysis() = default;
+    MemoryEffectsAnalysis(const MemoryEffectsAnalysis &) = default;
+    MemoryEffectsAnalysis(MemoryEffectsAnalysis &&) = default;
+    ~MemoryEffectsAnalysis() = default;
+
+    // Any operation within the module may be passed to summarize the functions of the enclosing module
+    explicit MemoryEffectsAnalysis(const Operation::Ptr &op);
+
+    // Effects of the operation itself and, for the operations with regions, of all nested operations
+    MemoryEffects getEffects(const Operation::Ptr &op) const;
+
+    bool hasEffects(const Operation::Ptr &op) const;
+    bool mayModify(const Operation::Ptr &op, const MemoryEffect &access) const;
+};
+
+} // namespace optree
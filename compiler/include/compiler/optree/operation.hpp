@@ -39,7 +39,7 @@ struct Operation : public std::enable_shared_from_this<Operation> {
     void removeUse(const Value::Ptr &value, size_t operandNumber);
     void updateUse(const Value::Ptr &value, size_t operandNumber, const std::function<void(Value::Use &)> &actor);
 
-    Ptr cloneImpl(const ValueMapping &operandsMap = {});
+    Ptr cloneImpl(ValueMapping &valuesMap);
     Ptr cloneWithoutBodyImpl(const ValueMapping &operandsMap, ValueMapping &outputsMap);
 
     static SpecId getUnknownSpecId();
@@ -80,6 +80,8 @@ struct Operation : public std::enable_shared_from_this<Operation> {
 
     operator bool() const;
 
+    SpecId getSpecId() const;
+
     size_t numOperands() const;
     size_t numResults() const;
     size_t numInwards() const;
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "compiler/optree/definitions.hpp"
+#include "compiler/optree/operation.hpp"
+
+namespace optree {
+
+// Execution counts written by the executables built with --profile-generate. Counters are keyed by the source
+// positions of the operations, so the profile of the optimized executable still matches the unoptimized program,
+// and the counts of the copies of the same operation (e.g. inlined or unrolled ones) are summed
+using Profile = std::unordered_map<std::string, NativeInt>;
+
+// Keys of the counters of the operation: FunctionOp counts its calls, IfOp counts the runs of its branches (even
+// the missing ElseOp), WhileOp and ForOp count their entries and iterations, other operations are not counted
+std::vector<std::string> getProfileKeys(const Operation::Ptr &op);
+
+// Counts are stored as the trailing integer attributes of the operation in the order of its keys
+std::vector<NativeInt> getProfileCounts(const Operation::Ptr &op);
+void setProfileCounts(const Operation::Ptr &op, const std::vector<NativeInt> &counts);
+
+// Each line of the profile holds the key followed by the count separated with a space
+Profile readProfile(std::istream &stream);
+// Counts are attached to the operations having all of their keys in the profile
+void attachProfile(const Operation::Ptr &op, const Profile &profile);
+
+} // namespace optree
@@ -152,6 +152,23 @@ struct PointerType : public Type {
     void dump(std::ostream &stream) const override;
 };
 
+// Fixed number of scalar elements processed by a single operation, e.g. in the loops after vectorization.
+// Constants of this type hold a scalar value, which is broadcast to all lanes.
+struct VectorType : public Type {
+    using Ptr = std::shared_ptr<const VectorType>;
+
+    const Type::Ptr element;
+    const size_t numLanes;
+
+    VectorType(const Type::Ptr &element, size_t numLanes) : element(element), numLanes(numLanes){};
+
+    bool operator==(const Type &other) const override;
+    using Type::operator!=;
+
+    unsigned bitWidth() const override;
+    void dump(std::ostream &stream) const override;
+};
+
 struct TupleType : public Type {
     using Ptr = std::shared_ptr<const TupleType>;
 
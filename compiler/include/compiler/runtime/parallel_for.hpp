@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+// Runtime library linked into the executables which contain parallelized loops
+
+extern "C" {
+
+// Runs the iterations from begin to end (exclusive) with the given step of the outlined loop body
+using ParallelLoopBody = void (*)(int64_t begin, int64_t end, int64_t step, void *context);
+
+// Runs the iterations start, start + step, ... below stop (step must be positive) on the threads of the pool,
+// every thread processes its share of the iterations in chunks and steals the remaining iterations from the
+// others when it runs out of work. Nested calls and the calls made while the pool is busy run sequentially
+void __compiler_parallel_for(int64_t start, int64_t stop, int64_t step, ParallelLoopBody body, void *context);
+
+} // extern "C"
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+// Runtime library linked into the executables instrumented with --profile-generate
+
+extern "C" {
+
+// Registers the counters of the module, keys[i] names the operation counted by counters[i]. Modules register their
+// counters at the startup, and the counts of all of them are written to the profile at the exit of the program
+void __compiler_profile_register(const char *path, const char *const *keys, const int64_t *counters,
+                                 int64_t numCounters);
+
+// Writes the counts summed by keys to the profile, one line per key
+void __compiler_profile_write();
+
+} // extern "C"
@@ -20,6 +20,8 @@ inline const std::string funcEnumerate = "enumerate";
 // ----------------------------------------------------------------------------
 
 inline const std::string atInline = "inline";
+// Set by the optimizer on the outlined bodies of the loops which are run by the parallel runtime
+inline const std::string atParallel = "parallel";
 
 } // namespace language
 } // namespace utils
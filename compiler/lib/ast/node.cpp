@@ -251,6 +251,9 @@ void Node::dump(std::ostream &stream, int depth) const {
     case NodeType::FunctionCall:
         stream << "FunctionCall\n";
         break;
+    case NodeType::FunctionDecorator:
+        stream << "FunctionDecorator: " << str() << "\n";
+        break;
     case NodeType::FunctionDefinition:
         stream << "FunctionDefinition\n";
         break;
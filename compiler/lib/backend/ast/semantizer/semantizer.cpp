@@ -321,6 +321,10 @@ static void parseFunctions(const std::list<Node::Ptr> &children, SemantizerConte
         if (node->type == NodeType::FunctionDefinition) {
             auto child = node->children.begin();
             auto name = (*child)->str();
+            for (const auto &decorator : (*child)->children) {
+                if (decorator->str() != language::atInline)
+                    ctx.errors.push<SemantizerError>(*decorator, "Unknown decorator " + decorator->str());
+            }
             child++;
             VariablesTable tmp;
             auto args = getFunctionArguments((*child)->children, tmp);
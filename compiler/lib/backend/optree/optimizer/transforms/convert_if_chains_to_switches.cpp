@@ -0,0 +1,157 @@
+#include "optimizer/transform.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/helpers.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/types.hpp"
+#include "compiler/optree/value.hpp"
+#include "compiler/utils/helpers.hpp"
+
+#include "optimizer/opt_builder.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+namespace {
+
+struct ConvertIfChainsToSwitches : public Transform<IfOp> {
+    size_t minCases;
+
+    explicit ConvertIfChainsToSwitches(size_t minCases) : minCases(minCases){};
+    ConvertIfChainsToSwitches(const ConvertIfChainsToSwitches &) = default;
+    ConvertIfChainsToSwitches(ConvertIfChainsToSwitches &&) = default;
+    ~ConvertIfChainsToSwitches() override = default;
+
+    std::string_view name() const override {
+        return "ConvertIfChainsToSwitches";
+    }
+
+    // Integer value compared for equality with a constant by the condition, along with the constant
+    static std::optional<std::pair<Value::Ptr, NativeInt>> matchCase(const Value::Ptr &cond) {
+        auto cmpOp = getValueOwnerAs<LogicBinaryOp>(cond);
+        if (!cmpOp || cmpOp.kind() != LogicBinOpKind::Equal || !cmpOp.lhs()->type->is<IntegerType>() ||
+            cmpOp.lhs()->type->is<BoolType>())
+            return std::nullopt;
+        for (const auto &[value, other] : {std::pair(cmpOp.lhs(), cmpOp.rhs()), std::pair(cmpOp.rhs(), cmpOp.lhs())}) {
+            auto constOp = getValueOwnerAs<ConstantOp>(other);
+            if (constOp && constOp.value().is<NativeInt>() && !getValueOwnerAs<ConstantOp>(value))
+                return std::pair(value, constOp.value().as<NativeInt>());
+        }
+        return std::nullopt;
+    }
+
+    // ElseOp continues the chain if it only computes the condition of the nested IfOp and yields its results, the
+    // computations are pure, so they are hoisted before the switch
+    static IfOp findNestedLink(const IfOp &ifOp, std::vector<Operation::Ptr> &hoisted) {
+        auto elseOp = ifOp.elseOp();
+        if (!elseOp || elseOp->body.empty())
+            return {};
+        auto it = elseOp->body.rbegin();
+        auto yieldOp = elseOp.yieldOp();
+        if (yieldOp && ++it == elseOp->body.rend())
+            return {};
+        auto nestedOp = (*it)->as<IfOp>();
+        if (!nestedOp || nestedOp->numResults() != ifOp->numResults())
+            return {};
+        if (yieldOp && !std::ranges::equal(yieldOp->operands, nestedOp->results))
+            return {};
+        auto isPure = [](const Operation::Ptr &childOp) { return utils::isAny<ConstantOp, LogicBinaryOp>(childOp); };
+        if (!std::all_of(std::next(it), elseOp->body.rend(), isPure))
+            return {};
+        for (const auto &childOp : elseOp->body) {
+            if (childOp == nestedOp.op)
+                break;
+            hoisted.push_back(childOp);
+        }
+        return nestedOp;
+    }
+
+    // Nested IfOp is converted together with the outermost IfOp of the chain
+    static bool isNestedLink(const IfOp &ifOp) {
+        auto parentOp = ifOp->parent->parent;
+        if (!ifOp->parent->is<ElseOp>() || !parentOp->is<IfOp>())
+            return false;
+        std::vector<Operation::Ptr> hoisted;
+        if (findNestedLink(parentOp->as<IfOp>(), hoisted) != ifOp)
+            return false;
+        auto parentCase = matchCase(parentOp->as<IfOp>().cond());
+        auto nestedCase = matchCase(ifOp.cond());
+        return parentCase && nestedCase && parentCase->first == nestedCase->first;
+    }
+
+    static void moveBody(const Operation::Ptr &from, const Operation::Ptr &to, OptBuilder &builder) {
+        builder.setInsertPointAtBodyEnd(to);
+        for (const auto &childOp : utils::advanceEarly(from->body)) {
+            auto cloned = builder.clone(childOp);
+            builder.replace(childOp, cloned);
+            builder.setInsertPointAfter(cloned);
+        }
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        auto ifOp = op->as<IfOp>();
+        auto firstCase = matchCase(ifOp.cond());
+        if (!firstCase || isNestedLink(ifOp))
+            return;
+        const auto &value = firstCase->first;
+        std::vector<IfOp> links{ifOp};
+        std::vector<NativeInt> caseValues{firstCase->second};
+        std::unordered_set<NativeInt> seen{firstCase->second};
+        std::vector<Operation::Ptr> hoisted;
+        while (true) {
+            std::vector<Operation::Ptr> linkHoisted;
+            auto nestedOp = findNestedLink(links.back(), linkHoisted);
+            if (!nestedOp)
+                break;
+            // Later comparisons with the same constant are never true, the chain is cut there to keep cases distinct
+            auto nestedCase = matchCase(nestedOp.cond());
+            if (!nestedCase || nestedCase->first != value || !seen.insert(nestedCase->second).second)
+                break;
+            links.push_back(nestedOp);
+            caseValues.push_back(nestedCase->second);
+            hoisted.insert(hoisted.end(), linkHoisted.begin(), linkHoisted.end());
+        }
+        if (links.size() < minCases)
+            return;
+
+        for (const auto &hoistedOp : hoisted) {
+            builder.setInsertPointBefore(ifOp);
+            builder.replace(hoistedOp, builder.clone(hoistedOp));
+        }
+        builder.setInsertPointBefore(ifOp);
+        auto defaultRegion = links.back().elseOp();
+        auto switchOp = builder.insert<SwitchOp>(ifOp->ref, value, caseValues, static_cast<bool>(defaultRegion));
+        builder.update(switchOp, [&switchOp, &ifOp] {
+            for (const auto &result : ifOp->results)
+                switchOp->addResult(result->type);
+        });
+        for (size_t i = 0; i < links.size(); i++)
+            moveBody(links[i].thenOp(), switchOp.caseOp(i), builder);
+        if (defaultRegion)
+            moveBody(defaultRegion, switchOp.defaultOp(), builder);
+        for (const auto &[result, switchResult] : utils::zip(ifOp->results, switchOp->results))
+            builder.replace(result, switchResult);
+        builder.erase(ifOp);
+    }
+};
+
+} // namespace
+
+namespace optree {
+namespace optimizer {
+
+BaseTransform::Ptr createConvertIfChainsToSwitches(size_t minCases) {
+    return std::make_shared<ConvertIfChainsToSwitches>(minCases);
+}
+
+} // namespace optimizer
+} // namespace optree
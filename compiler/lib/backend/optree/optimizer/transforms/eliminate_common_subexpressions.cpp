@@ -0,0 +1,170 @@
+#include "optimizer/transform.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/attribute.hpp"
+#include "compiler/optree/helpers.hpp"
+#include "compiler/optree/memory_effects.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/value.hpp"
+#include "compiler/utils/helpers.hpp"
+
+#include "optimizer/opt_builder.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+namespace {
+
+// Value numbering over the nested regions: an operation is available in its own region after its definition
+// and in all regions nested into it, which are exactly the operations it dominates
+class ValueNumbering {
+    using Scope = std::unordered_multimap<size_t, Operation::Ptr>;
+
+    OptBuilder &builder;
+    const MemoryEffectsAnalysis &effects;
+    std::vector<Scope> scopes;
+
+    static bool isPure(const Operation::Ptr &op) {
+        return utils::isAny<ConstantOp, ArithBinaryOp, ArithCastOp, ArithUnaryOp, LogicBinaryOp, LogicUnaryOp>(op);
+    }
+
+    MemoryEffects writesOf(const Operation::Ptr &op) const {
+        MemoryEffects writes;
+        for (const auto &effect : effects.getEffects(op))
+            if (effect.modifiesMemory())
+                writes.push_back(effect);
+        return writes;
+    }
+
+    // Loads are only equivalent if no memory they read was written between them
+    void invalidateLoads(const MemoryEffects &writes) {
+        if (writes.empty())
+            return;
+        auto isClobbered = [&writes](const auto &item) {
+            auto loadOp = item.second->template as<LoadOp>();
+            if (!loadOp)
+                return false;
+            auto read = readEffect(loadOp);
+            return std::ranges::any_of(writes, [&read](const MemoryEffect &write) {
+                return alias(write, read) != AliasResult::NoAlias;
+            });
+        };
+        for (auto &scope : scopes)
+            std::erase_if(scope, isClobbered);
+    }
+
+    static size_t hashOp(const Operation::Ptr &op) {
+        size_t hash = std::hash<std::string_view>{}(op->name);
+        auto combine = [&hash](size_t value) { hash ^= value + 0x9e3779b9U + (hash << 6U) + (hash >> 2U); };
+        for (const auto &attr : op->attributes)
+            combine(hashAttribute(attr));
+        for (const auto &operand : op->operands)
+            combine(std::hash<Value::Ptr>{}(operand));
+        return hash;
+    }
+
+    static bool equivalent(const Operation::Ptr &lhs, const Operation::Ptr &rhs) {
+        if (lhs->name != rhs->name || lhs->numResults() != rhs->numResults())
+            return false;
+        if (!std::ranges::equal(lhs->attributes, rhs->attributes, sameAttribute))
+            return false;
+        if (!std::ranges::equal(lhs->operands, rhs->operands))
+            return false;
+        auto typeEqual = [](const Value::Ptr &lhsValue, const Value::Ptr &rhsValue) {
+            return lhsValue->sameType(rhsValue);
+        };
+        return std::ranges::equal(lhs->results, rhs->results, typeEqual);
+    }
+
+    Operation::Ptr findAvailable(const Operation::Ptr &op, size_t hash) const {
+        for (const auto &scope : scopes) {
+            auto [begin, end] = scope.equal_range(hash);
+            for (auto it = begin; it != end; ++it)
+                if (equivalent(it->second, op))
+                    return it->second;
+        }
+        return {};
+    }
+
+    void processOp(const Operation::Ptr &op) {
+        if (!op->body.empty() || utils::isAny<WhileOp, ForOp, IfOp, ThenOp, ElseOp, ConditionOp>(op)) {
+            processRegion(op);
+            return;
+        }
+        if (!isPure(op) && !op->is<LoadOp>()) {
+            invalidateLoads(writesOf(op));
+            return;
+        }
+        if (isConditionPredicate(op))
+            return;
+        auto hash = hashOp(op);
+        if (auto available = findAvailable(op, hash)) {
+            for (const auto &[result, availableResult] : utils::zip(op->results, available->results))
+                builder.replace(result, availableResult);
+            builder.erase(op);
+            return;
+        }
+        scopes.back().emplace(hash, op);
+    }
+
+    void processRegion(const Operation::Ptr &op) {
+        auto writes = writesOf(op);
+        // Loop body may be executed after the memory was written on the previous iteration
+        if (utils::isAny<WhileOp, ForOp>(op))
+            invalidateLoads(writes);
+        scopes.emplace_back();
+        // Both branches start with the memory state before the conditional operation
+        auto entryScopes = op->is<IfOp>() && !writes.empty() ? scopes : std::vector<Scope>{};
+        for (const auto &childOp : utils::advanceEarly(op->body)) {
+            if (!entryScopes.empty() && childOp->is<ElseOp>())
+                scopes = entryScopes;
+            processOp(childOp);
+        }
+        scopes.pop_back();
+        invalidateLoads(writes);
+    }
+
+  public:
+    ValueNumbering(OptBuilder &builder, const MemoryEffectsAnalysis &effects) : builder(builder), effects(effects){};
+
+    void run(const Operation::Ptr &funcOp) {
+        processRegion(funcOp);
+    }
+};
+
+struct EliminateCommonSubexpressions : public Transform<FunctionOp> {
+    using Transform::Transform;
+
+    std::string_view name() const override {
+        return "EliminateCommonSubexpressions";
+    }
+
+    bool recurse() const override {
+        return false;
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        MemoryEffectsAnalysis effects(op);
+        ValueNumbering(builder, effects).run(op);
+    }
+};
+
+} // namespace
+
+namespace optree {
+namespace optimizer {
+
+BaseTransform::Ptr createEliminateCommonSubexpressions() {
+    return std::make_shared<EliminateCommonSubexpressions>();
+}
+
+} // namespace optimizer
+} // namespace optree
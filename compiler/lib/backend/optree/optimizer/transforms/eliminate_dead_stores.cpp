@@ -0,0 +1,183 @@
+#include "optimizer/transform.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/helpers.hpp"
+#include "compiler/optree/memory_effects.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/value.hpp"
+#include "compiler/utils/helpers.hpp"
+
+#include "optimizer/opt_builder.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+namespace {
+
+// Values known to be held by the memory at the current point of the region, they come either from stores or
+// from the previous loads of the same memory
+class StoreForwarding {
+    using Available = std::vector<std::pair<MemoryEffect, Value::Ptr>>;
+
+    OptBuilder &builder;
+    const MemoryEffectsAnalysis &effects;
+
+    MemoryEffects writesOf(const Operation::Ptr &op) const {
+        MemoryEffects writes;
+        for (const auto &effect : effects.getEffects(op))
+            if (effect.modifiesMemory())
+                writes.push_back(effect);
+        return writes;
+    }
+
+    static void invalidate(Available &available, const MemoryEffects &writes) {
+        std::erase_if(available, [&writes](const auto &item) {
+            return std::ranges::any_of(writes, [&item](const MemoryEffect &write) {
+                return alias(write, item.first) != AliasResult::NoAlias;
+            });
+        });
+    }
+
+    void processLoad(const LoadOp &op, Available &available) {
+        auto read = readEffect(op);
+        auto it = std::ranges::find_if(available, [&read, &op](const auto &item) {
+            return alias(item.first, read) == AliasResult::MustAlias && item.second->sameType(op.result());
+        });
+        if (it == available.end() || isConditionPredicate(op)) {
+            available.emplace_back(read, op.result());
+            return;
+        }
+        builder.replace(op.result(), it->second);
+        builder.erase(op);
+    }
+
+    void processRegion(const Operation::Ptr &op, Available available) {
+        for (const auto &childOp : utils::advanceEarly(op->body)) {
+            if (auto loadOp = childOp->as<LoadOp>()) {
+                processLoad(loadOp, available);
+                continue;
+            }
+            auto writes = writesOf(childOp);
+            if (!childOp->body.empty()) {
+                // Loop body may be executed after the memory was written on the previous iteration
+                auto entry = available;
+                if (utils::isAny<WhileOp, ForOp>(childOp))
+                    invalidate(entry, writes);
+                if (childOp->is<IfOp>()) {
+                    for (const auto &branchOp : childOp->body)
+                        processRegion(branchOp, entry);
+                } else {
+                    processRegion(childOp, entry);
+                }
+            }
+            invalidate(available, writes);
+            if (auto storeOp = childOp->as<StoreOp>()) {
+                available.emplace_back(writeEffect(storeOp), storeOp.valueToStore());
+            }
+        }
+    }
+
+  public:
+    StoreForwarding(OptBuilder &builder, const MemoryEffectsAnalysis &effects) : builder(builder), effects(effects){};
+
+    void run(const Operation::Ptr &funcOp) {
+        processRegion(funcOp, {});
+    }
+};
+
+struct EliminateDeadStores : public Transform<FunctionOp> {
+    using Transform::Transform;
+
+    std::string_view name() const override {
+        return "EliminateDeadStores";
+    }
+
+    bool recurse() const override {
+        return false;
+    }
+
+    // Memory of the function is not observable after the return if its pointer is used only for accessing it
+    static bool isLocal(const Value::Ptr &ptr) {
+        auto root = getPointerRoot(ptr);
+        if (!root)
+            return false;
+        return std::ranges::all_of(root->result(0)->uses, [](const Value::Use &use) {
+            auto user = use.lock();
+            return user->is<LoadOp>() || user->is<DeallocateOp>() || (user->is<StoreOp>() && use.operandNumber == 0);
+        });
+    }
+
+    // Store is dead if the same memory is overwritten in the same region before any operation may read it
+    static bool isDead(const StoreOp &op, const MemoryEffectsAnalysis &effects) {
+        auto write = writeEffect(op);
+        for (auto it = std::next(op->position); it != op->parent->body.end(); ++it) {
+            const auto &nextOp = *it;
+            if (nextOp->is<ReturnOp>())
+                return isLocal(op.dst());
+            auto mayRead = std::ranges::any_of(effects.getEffects(nextOp), [&write](const MemoryEffect &effect) {
+                return effect.kind == MemoryEffectKind::Read && alias(effect, write) != AliasResult::NoAlias;
+            });
+            if (mayRead)
+                return false;
+            if (auto storeOp = nextOp->as<StoreOp>()) {
+                if (alias(writeEffect(storeOp), write) == AliasResult::MustAlias)
+                    return true;
+            }
+        }
+        return op->parent->is<FunctionOp>() && isLocal(op.dst());
+    }
+
+    static void collectOps(const Operation::Ptr &op, std::vector<Operation::Ptr> &ops) {
+        for (const auto &childOp : op->body) {
+            ops.push_back(childOp);
+            collectOps(childOp, ops);
+        }
+    }
+
+    // Allocations which are never loaded from are only written, so all their stores are dead
+    static bool isUnread(const Operation::Ptr &op) {
+        return std::ranges::all_of(op->result(0)->uses, [](const Value::Use &use) {
+            auto user = use.lock();
+            return user->is<DeallocateOp>() || (user->is<StoreOp>() && use.operandNumber == 0);
+        });
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        MemoryEffectsAnalysis effects(op);
+        StoreForwarding(builder, effects).run(op);
+        std::vector<Operation::Ptr> ops;
+        collectOps(op, ops);
+        for (const auto &childOp : ops)
+            if (auto storeOp = childOp->as<StoreOp>(); storeOp && isDead(storeOp, effects))
+                builder.erase(childOp);
+        for (const auto &childOp : ops) {
+            if (!utils::isAny<AllocateOp, HeapAllocateOp>(childOp) || childOp->results.empty() || !isUnread(childOp))
+                continue;
+            std::vector<Operation::Ptr> users;
+            for (const auto &use : childOp->result(0)->uses)
+                users.push_back(use.lock());
+            for (const auto &user : users)
+                builder.erase(user);
+            builder.erase(childOp);
+        }
+    }
+};
+
+} // namespace
+
+namespace optree {
+namespace optimizer {
+
+BaseTransform::Ptr createEliminateDeadStores() {
+    return std::make_shared<EliminateDeadStores>();
+}
+
+} // namespace optimizer
+} // namespace optree
@@ -0,0 +1,302 @@
+#include "optimizer/transform.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <string_view>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/definitions.hpp"
+#include "compiler/optree/helpers.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/types.hpp"
+#include "compiler/optree/value.hpp"
+#include "compiler/utils/helpers.hpp"
+
+#include "optimizer/opt_builder.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+namespace {
+
+// Return of a self-recursive call, either directly or combined with a value computed before the call
+struct TailReturn {
+    FunctionCallOp callOp;
+    ArithBinaryOp accumulateOp;
+    Value::Ptr addend;
+};
+
+// Values carried between iterations of the loop replacing the function body: function arguments,
+// a flag of the function return, the returned value (if any) and the accumulator (if any)
+struct Carried {
+    std::vector<Value::Ptr> arguments;
+    Value::Ptr done;
+    Value::Ptr result;
+    Value::Ptr accumulator;
+};
+
+struct EliminateTailRecursion : public Transform<FunctionOp> {
+    using Transform::Transform;
+
+    std::string_view name() const override {
+        return "EliminateTailRecursion";
+    }
+
+    bool recurse() const override {
+        return false;
+    }
+
+    static std::optional<TailReturn> getTailReturn(const ReturnOp &returnOp, const FunctionOp &funcOp) {
+        if (returnOp->position == returnOp->parent->body.begin())
+            return std::nullopt;
+        const auto &prevOp = *std::prev(returnOp->position);
+        auto isSelfCall = [&funcOp](const FunctionCallOp &callOp) {
+            return callOp && callOp.name() == funcOp.name() && callOp->numOperands() == funcOp->numInwards() &&
+                   std::ranges::distance(callOp.result()->uses) <= 1;
+        };
+        if (auto callOp = prevOp->as<FunctionCallOp>(); isSelfCall(callOp)) {
+            if (returnOp->numOperands() == 0 ? callOp.result()->uses.empty() : returnOp.value() == callOp.result())
+                return TailReturn{callOp, {}, {}};
+            return std::nullopt;
+        }
+        auto accumulateOp = prevOp->as<ArithBinaryOp>();
+        if (!accumulateOp || returnOp->numOperands() == 0 || returnOp.value() != accumulateOp.result() ||
+            prevOp->position == prevOp->parent->body.begin())
+            return std::nullopt;
+        if (accumulateOp.kind() != ArithBinOpKind::AddI && accumulateOp.kind() != ArithBinOpKind::MulI)
+            return std::nullopt;
+        auto callOp = (*std::prev(prevOp->position))->as<FunctionCallOp>();
+        if (!isSelfCall(callOp))
+            return std::nullopt;
+        if (accumulateOp.lhs() == callOp.result() && accumulateOp.rhs() != callOp.result())
+            return TailReturn{callOp, accumulateOp, accumulateOp.rhs()};
+        if (accumulateOp.rhs() == callOp.result() && accumulateOp.lhs() != callOp.result())
+            return TailReturn{callOp, accumulateOp, accumulateOp.lhs()};
+        return std::nullopt;
+    }
+
+    static bool containsReturn(const Operation::Ptr &op) {
+        return std::ranges::any_of(op->body, [](const Operation::Ptr &childOp) {
+            return childOp->is<ReturnOp>() || containsReturn(childOp);
+        });
+    }
+
+    // Region always ends with a return, and returns are nested only in branches which end with them too,
+    // so every return can be replaced with a yield of the values for the next iteration
+    static bool isTerminating(const Operation::Ptr &region) {
+        if (region->body.empty())
+            return false;
+        const auto &lastOp = region->body.back();
+        bool isLastReturning = lastOp->is<ReturnOp>() || (lastOp->is<IfOp>() && lastOp->numChildren() == 2U &&
+                                                          std::ranges::all_of(lastOp->body, isTerminating));
+        if (!isLastReturning)
+            return false;
+        for (const auto &op : region->body) {
+            if (op->is<ReturnOp>() || !containsReturn(op))
+                continue;
+            auto ifOp = op->as<IfOp>();
+            if (!ifOp || ifOp->numResults() != 0)
+                return false;
+            for (const auto &branchOp : op->body)
+                if (containsReturn(branchOp) && !isTerminating(branchOp))
+                    return false;
+        }
+        return true;
+    }
+
+    static void collectReturns(const Operation::Ptr &op, std::vector<ReturnOp> &returns) {
+        for (const auto &childOp : op->body) {
+            if (auto returnOp = childOp->as<ReturnOp>())
+                returns.push_back(returnOp);
+            collectReturns(childOp, returns);
+        }
+    }
+
+    // Kind of the operation combining results of recursive calls, they must be the same for all returns
+    static std::optional<std::optional<ArithBinOpKind>> getAccumulationKind(const FunctionOp &funcOp) {
+        std::vector<ReturnOp> returns;
+        collectReturns(funcOp, returns);
+        bool hasTailCalls = false;
+        std::optional<ArithBinOpKind> kind;
+        for (const auto &returnOp : returns) {
+            auto tailReturn = getTailReturn(returnOp, funcOp);
+            if (!tailReturn)
+                continue;
+            hasTailCalls = true;
+            if (!tailReturn->accumulateOp)
+                continue;
+            if (kind && *kind != tailReturn->accumulateOp.kind())
+                return std::nullopt;
+            kind = tailReturn->accumulateOp.kind();
+        }
+        if (!hasTailCalls)
+            return std::nullopt;
+        return kind;
+    }
+
+    static Value::Ptr insertConstant(const Type::Ptr &type, NativeInt value, OptBuilder &builder,
+                                     const utils::SourceRef &ref) {
+        if (type->is<BoolType>())
+            return builder.insert<ConstantOp>(ref, type, static_cast<NativeBool>(value)).result();
+        if (type->is<IntegerType>())
+            return builder.insert<ConstantOp>(ref, type, value).result();
+        return builder.insert<ConstantOp>(ref, type, static_cast<NativeFloat>(value)).result();
+    }
+
+    static void moveToBodyEnd(const std::vector<Operation::Ptr> &ops, const Operation::Ptr &region,
+                              OptBuilder &builder) {
+        for (const auto &op : ops) {
+            builder.setInsertPointAtBodyEnd(region);
+            auto cloned = builder.clone(op);
+            builder.replace(op, cloned);
+        }
+    }
+
+    static std::vector<Value::Ptr> yieldedValues(const Carried &carried) {
+        std::vector<Value::Ptr> values = carried.arguments;
+        values.push_back(carried.done);
+        if (carried.result)
+            values.push_back(carried.result);
+        if (carried.accumulator)
+            values.push_back(carried.accumulator);
+        return values;
+    }
+
+    static void replaceReturn(const ReturnOp &returnOp, const FunctionOp &funcOp, const Carried &carried,
+                              std::optional<ArithBinOpKind> kind, OptBuilder &builder) {
+        auto ref = returnOp->ref;
+        auto next = carried;
+        builder.setInsertPointBefore(returnOp);
+        auto tailReturn = getTailReturn(returnOp, funcOp);
+        if (tailReturn) {
+            next.arguments = tailReturn->callOp->operands;
+            next.done = builder.insert<ConstantOp>(ref, TypeStorage::boolType(), false).result();
+            if (tailReturn->accumulateOp)
+                next.accumulator =
+                    builder.insert<ArithBinaryOp>(ref, *kind, carried.accumulator, tailReturn->addend).result();
+        } else {
+            next.done = builder.insert<ConstantOp>(ref, TypeStorage::boolType(), true).result();
+            if (carried.result && kind)
+                next.result = builder.insert<ArithBinaryOp>(ref, *kind, carried.accumulator, returnOp.value()).result();
+            else if (carried.result)
+                next.result = returnOp.value();
+        }
+        builder.insert<YieldOp>(ref, yieldedValues(next));
+        builder.erase(returnOp);
+        if (tailReturn && tailReturn->accumulateOp)
+            builder.erase(tailReturn->accumulateOp);
+        if (tailReturn)
+            builder.erase(tailReturn->callOp);
+    }
+
+    // Replaces returns in the terminating region with yields, the operations following the branching which
+    // returns only in one of its branches are moved into another branch
+    static void convertRegion(const Operation::Ptr &region, const FunctionOp &funcOp, const Carried &carried,
+                              std::optional<ArithBinOpKind> kind, OptBuilder &builder) {
+        for (auto it = region->body.begin(); it != region->body.end(); ++it) {
+            const auto op = *it;
+            if (auto returnOp = op->as<ReturnOp>()) {
+                replaceReturn(returnOp, funcOp, carried, kind, builder);
+                return;
+            }
+            if (!op->is<IfOp>() || !containsReturn(op))
+                continue;
+            std::vector<Operation::Ptr> following(std::next(it), region->body.end());
+            auto ifOp = op->as<IfOp>();
+            if (!ifOp.elseOp()) {
+                builder.setInsertPointAtBodyEnd(ifOp);
+                builder.insert<ElseOp>(ifOp->ref);
+            }
+            std::vector<Operation::Ptr> branches(op->body.begin(), op->body.end());
+            auto fallthrough = std::ranges::find_if(branches, [](const auto &branchOp) {
+                return !containsReturn(branchOp);
+            });
+            if (fallthrough != branches.end()) {
+                moveToBodyEnd(following, *fallthrough, builder);
+            } else {
+                for (const auto &followingOp : std::views::reverse(following))
+                    builder.erase(followingOp);
+            }
+            auto values = yieldedValues(carried);
+            builder.update(ifOp, [&ifOp, &values] {
+                for (const auto &value : values)
+                    ifOp->addResult(value->type);
+            });
+            for (const auto &branchOp : branches)
+                convertRegion(branchOp, funcOp, carried, kind, builder);
+            builder.setInsertPointAfter(ifOp);
+            builder.insert<YieldOp>(ifOp->ref, std::vector<Value::Ptr>(ifOp->results.begin(), ifOp->results.end()));
+            return;
+        }
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        auto funcOp = op->as<FunctionOp>();
+        if (!isTerminating(funcOp))
+            return;
+        auto kind = getAccumulationKind(funcOp);
+        if (!kind)
+            return;
+        const auto &resultType = funcOp.type().result;
+        bool hasResult = !resultType->is<NoneType>();
+        if (hasResult && !resultType->is<IntegerType>() && !resultType->is<FloatType>())
+            return;
+
+        const auto &ref = funcOp->ref;
+        std::vector<Operation::Ptr> bodyOps(funcOp->body.begin(), funcOp->body.end());
+        builder.setInsertPointAtBodyBegin(funcOp);
+        std::vector<Value::Ptr> inits(funcOp->inwards.begin(), funcOp->inwards.end());
+        inits.push_back(builder.insert<ConstantOp>(ref, TypeStorage::boolType(), false).result());
+        if (hasResult)
+            inits.push_back(insertConstant(resultType, 0, builder, ref));
+        if (*kind)
+            inits.push_back(insertConstant(resultType, **kind == ArithBinOpKind::MulI ? 1 : 0, builder, ref));
+
+        auto whileOp = builder.insert<WhileOp>(ref);
+        Carried carried;
+        builder.update(whileOp, [&] {
+            for (const auto &arg : funcOp->inwards)
+                carried.arguments.push_back(whileOp->addInward(arg->type));
+            carried.done = whileOp->addInward(TypeStorage::boolType());
+            if (hasResult)
+                carried.result = whileOp->addInward(resultType);
+            if (*kind)
+                carried.accumulator = whileOp->addInward(resultType);
+        });
+        builder.setInsertPointAtBodyBegin(whileOp.conditionOp());
+        builder.insert<LogicUnaryOp>(ref, LogicUnaryOpKind::Not, carried.done);
+        moveToBodyEnd(bodyOps, whileOp, builder);
+        for (size_t i = 0; i < funcOp->numInwards(); i++)
+            builder.replace(funcOp->inward(i), carried.arguments[i]);
+
+        builder.update(whileOp, [&] {
+            for (const auto &init : inits) {
+                whileOp->addOperand(init);
+                whileOp->addResult(init->type);
+            }
+        });
+        convertRegion(whileOp, funcOp, carried, *kind, builder);
+        builder.setInsertPointAfter(whileOp);
+        if (hasResult)
+            builder.insert<ReturnOp>(ref, whileOp->result(funcOp->numInwards() + 1));
+        else
+            builder.insert<ReturnOp>(ref);
+    }
+};
+
+} // namespace
+
+namespace optree {
+namespace optimizer {
+
+BaseTransform::Ptr createEliminateTailRecursion() {
+    return std::make_shared<EliminateTailRecursion>();
+}
+
+} // namespace optimizer
+} // namespace optree
@@ -2,6 +2,7 @@
 #include <string_view>
 
 #include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/helpers.hpp"
 #include "compiler/optree/operation.hpp"
 
 #include "optimizer/opt_builder.hpp"
@@ -20,6 +21,8 @@ struct EraseUnusedOps : public Transform<ConstantOp, ArithBinaryOp, ArithCastOp,
     }
 
     void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        if (isConditionPredicate(op))
+            return;
         bool unused = true;
         for (const auto &result : op->results)
             unused &= result->uses.empty();
@@ -0,0 +1,87 @@
+#include "optimizer/transform.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/attribute.hpp"
+#include "compiler/optree/evaluator.hpp"
+#include "compiler/optree/helpers.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/types.hpp"
+
+#include "optimizer/opt_builder.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+namespace {
+
+struct EvaluatePureCalls : public Transform<ModuleOp> {
+    size_t maxSteps;
+    size_t maxDepth;
+
+    EvaluatePureCalls(size_t maxSteps, size_t maxDepth) : maxSteps(maxSteps), maxDepth(maxDepth){};
+    EvaluatePureCalls(const EvaluatePureCalls &) = default;
+    EvaluatePureCalls(EvaluatePureCalls &&) = default;
+    ~EvaluatePureCalls() override = default;
+
+    std::string_view name() const override {
+        return "EvaluatePureCalls";
+    }
+
+    bool recurse() const override {
+        return false;
+    }
+
+    static void collectCalls(const Operation::Ptr &op, std::vector<FunctionCallOp> &calls) {
+        for (const auto &childOp : op->body) {
+            if (auto callOp = childOp->as<FunctionCallOp>())
+                calls.push_back(callOp);
+            collectCalls(childOp, calls);
+        }
+    }
+
+    // Only scalar results can be materialized as constants
+    static bool isEvaluable(const FunctionCallOp &callOp) {
+        const auto &type = callOp.result()->type;
+        if (!type->is<IntegerType>() && !type->is<FloatType>() && !type->is<BoolType>())
+            return false;
+        return std::ranges::all_of(callOp->operands,
+                                   [](const Value::Ptr &operand) { return getValueOwnerAs<ConstantOp>(operand); });
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        std::vector<FunctionCallOp> calls;
+        collectCalls(op, calls);
+        Evaluator evaluator(op, maxSteps, maxDepth);
+        for (const auto &callOp : calls) {
+            if (!isEvaluable(callOp))
+                continue;
+            std::vector<Attribute> arguments;
+            for (const auto &operand : callOp->operands)
+                arguments.push_back(getValueOwnerAs<ConstantOp>(operand).value());
+            auto result = evaluator.call(callOp.name(), arguments);
+            if (!result)
+                continue;
+            builder.setInsertPointBefore(callOp);
+            auto constOp = builder.insert<ConstantOp>(callOp->ref, callOp.result()->type, *result);
+            builder.replace(callOp, constOp);
+        }
+    }
+};
+
+} // namespace
+
+namespace optree {
+namespace optimizer {
+
+BaseTransform::Ptr createEvaluatePureCalls(size_t maxSteps, size_t maxDepth) {
+    return std::make_shared<EvaluatePureCalls>(maxSteps, maxDepth);
+}
+
+} // namespace optimizer
+} // namespace optree
@@ -28,6 +28,11 @@ struct FoldControlFlowOps : public Transform<IfOp, WhileOp> {
             return;
         builder.setInsertPointBefore(op->parent);
         for (const auto &childOp : utils::advanceEarly(op->body)) {
+            if (childOp->is<YieldOp>()) {
+                for (const auto &[result, value] : utils::zip(op->parent->results, childOp->operands))
+                    builder.replace(result, value);
+                continue;
+            }
             auto cloned = builder.clone(childOp);
             builder.replace(childOp, cloned);
             builder.setInsertPointAfter(cloned);
@@ -53,6 +58,8 @@ struct FoldControlFlowOps : public Transform<IfOp, WhileOp> {
             return;
         bool condition = conditionOp.value().as<NativeBool>();
         if (!condition) {
+            for (const auto &[result, init] : utils::zip(op->results, op->operands))
+                builder.replace(result, init);
             builder.erase(op);
         }
     }
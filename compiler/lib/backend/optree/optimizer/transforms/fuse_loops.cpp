@@ -0,0 +1,203 @@
+#include "optimizer/transform.hpp"
+
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/helpers.hpp"
+#include "compiler/optree/memory_effects.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/types.hpp"
+#include "compiler/optree/value.hpp"
+#include "compiler/utils/helpers.hpp"
+
+#include "optimizer/opt_builder.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+namespace {
+
+struct FuseLoops : public Transform<ForOp> {
+    using Transform::Transform;
+
+    std::string_view name() const override {
+        return "FuseLoops";
+    }
+
+    static std::optional<NativeInt> constantValue(const Value::Ptr &value) {
+        auto constOp = getValueOwnerAs<ConstantOp>(value);
+        if (!constOp || !constOp.value().is<NativeInt>())
+            return std::nullopt;
+        return constOp.value().as<NativeInt>();
+    }
+
+    static bool isInside(const Operation::Ptr &op, const Operation::Ptr &loopOp) {
+        for (auto parentOp = op; parentOp; parentOp = parentOp->parent)
+            if (parentOp == loopOp)
+                return true;
+        return false;
+    }
+
+    static bool containsReturn(const Operation::Ptr &op) {
+        for (const auto &childOp : op->body)
+            if (childOp->is<ReturnOp>() || containsReturn(childOp))
+                return true;
+        return false;
+    }
+
+    static bool isSameValue(const Value::Ptr &lhs, const Value::Ptr &rhs) {
+        if (lhs == rhs)
+            return true;
+        auto lhsValue = constantValue(lhs);
+        return lhsValue && lhsValue == constantValue(rhs) && *lhs->type == *rhs->type;
+    }
+
+    static bool haveSameIterations(const ForOp &first, const ForOp &second) {
+        return isSameValue(first.start(), second.start()) && isSameValue(first.stop(), second.stop()) &&
+               isSameValue(first.step(), second.step()) && *first.iterator()->type == *second.iterator()->type;
+    }
+
+    // Loops separated only by constants are adjacent, the constants are moved before the first loop on fusion
+    static ForOp findPreviousLoop(const ForOp &forOp, std::vector<Operation::Ptr> &constants) {
+        const auto &body = forOp->parent->body;
+        for (auto it = forOp->position; it != body.begin();) {
+            const auto &prevOp = *--it;
+            if (prevOp->is<ConstantOp>()) {
+                constants.push_back(prevOp);
+                continue;
+            }
+            return prevOp->as<ForOp>();
+        }
+        return {};
+    }
+
+    // Values computed by the first loop are available to the second one only after all of its iterations
+    static bool usesResults(const ForOp &second, const ForOp &first) {
+        for (const auto &result : first->results)
+            for (const auto &use : result->uses)
+                if (isInside(use.lock(), second))
+                    return true;
+        return false;
+    }
+
+    // Accesses to the memory allocated by the iteration itself can not conflict with the other loop
+    static bool collectSharedEffects(const ForOp &forOp, const MemoryEffectsAnalysis &analysis,
+                                     MemoryEffects &shared, bool &performsIO) {
+        for (const auto &effect : analysis.getEffects(forOp)) {
+            if (effect.kind == MemoryEffectKind::IO)
+                performsIO = true;
+            if (!effect.isMemoryAccess())
+                continue;
+            if (!effect.ptr)
+                return false;
+            auto root = getPointerRoot(effect.ptr);
+            if (!root || !isInside(root, forOp))
+                shared.push_back(effect);
+        }
+        return true;
+    }
+
+    static bool isIndexed(const MemoryEffect &effect, const ForOp &forOp) {
+        return !effect.wholeObject && effect.kind != MemoryEffectKind::Free && effect.offset == forOp.iterator() &&
+               !isInside(effect.ptr->owner.lock(), forOp);
+    }
+
+    // Iteration i of the second loop is moved before iterations i + 1, ... of the first one, which is legal if they
+    // do not touch the same memory, or both loops access only the element indexed by the iterator
+    static bool canReorderIterations(const ForOp &first, const ForOp &second, const MemoryEffectsAnalysis &analysis) {
+        MemoryEffects firstEffects;
+        MemoryEffects secondEffects;
+        bool firstIO = false;
+        bool secondIO = false;
+        if (!collectSharedEffects(first, analysis, firstEffects, firstIO) ||
+            !collectSharedEffects(second, analysis, secondEffects, secondIO) || (firstIO && secondIO))
+            return false;
+        for (const auto &lhs : firstEffects) {
+            for (const auto &rhs : secondEffects) {
+                if (!lhs.modifiesMemory() && !rhs.modifiesMemory())
+                    continue;
+                if (isIndexed(lhs, first) && isIndexed(rhs, second))
+                    continue;
+                if (alias(lhs, rhs) != AliasResult::NoAlias)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    static void fuse(const ForOp &first, const ForOp &second, const std::vector<Operation::Ptr> &constants,
+                     OptBuilder &builder) {
+        for (const auto &constOp : utils::reversed(constants)) {
+            builder.setInsertPointBefore(first);
+            builder.replace(constOp, builder.clone(constOp));
+        }
+
+        std::vector<Value::Ptr> carried;
+        std::vector<Value::Ptr> results;
+        builder.update(first, [&first, &second, &carried, &results] {
+            for (size_t i = 1; i < second->numInwards(); i++) {
+                first->addOperand(second->operand(ForOp::numControlOperands + i - 1U));
+                carried.push_back(first->addInward(second->inward(i)->type));
+            }
+            for (const auto &result : second->results)
+                results.push_back(first->addResult(result->type));
+        });
+        builder.replace(second.iterator(), first.iterator());
+        for (size_t i = 1; i < second->numInwards(); i++)
+            builder.replace(second->inward(i), carried[i - 1U]);
+
+        auto yieldOp = first.yieldOp();
+        if (yieldOp)
+            builder.setInsertPointBefore(yieldOp);
+        else
+            builder.setInsertPointAtBodyEnd(first);
+        for (const auto &childOp : utils::advanceEarly(second->body)) {
+            if (childOp->is<YieldOp>())
+                break;
+            auto cloned = builder.clone(childOp);
+            builder.replace(childOp, cloned);
+            builder.setInsertPointAfter(cloned);
+        }
+        if (auto secondYieldOp = second.yieldOp()) {
+            if (yieldOp) {
+                builder.update(yieldOp, [&yieldOp, &secondYieldOp] {
+                    for (const auto &value : secondYieldOp->operands)
+                        yieldOp->addOperand(value);
+                });
+            } else {
+                builder.insert<YieldOp>(second->ref, secondYieldOp->operands);
+            }
+        }
+        for (const auto &[result, fusedResult] : utils::zip(second->results, results))
+            builder.replace(result, fusedResult);
+        builder.erase(second);
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        auto forOp = op->as<ForOp>();
+        std::vector<Operation::Ptr> constants;
+        auto prevOp = findPreviousLoop(forOp, constants);
+        if (!prevOp || !haveSameIterations(prevOp, forOp) || containsReturn(prevOp) || containsReturn(forOp) ||
+            usesResults(forOp, prevOp))
+            return;
+        MemoryEffectsAnalysis analysis(op);
+        if (!canReorderIterations(prevOp, forOp, analysis))
+            return;
+        fuse(prevOp, forOp, constants, builder);
+    }
+};
+
+} // namespace
+
+namespace optree {
+namespace optimizer {
+
+BaseTransform::Ptr createFuseLoops() {
+    return std::make_shared<FuseLoops>();
+}
+
+} // namespace optimizer
+} // namespace optree
@@ -1,11 +1,16 @@
 #include "optimizer/transform.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <string_view>
 #include <unordered_set>
+#include <vector>
 
 #include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/helpers.hpp"
+#include "compiler/optree/memory_effects.hpp"
 #include "compiler/optree/operation.hpp"
+#include "compiler/optree/types.hpp"
 #include "compiler/optree/value.hpp"
 #include "compiler/utils/helpers.hpp"
 
@@ -25,6 +30,14 @@ struct HoistLoopInvariants : public Transform<WhileOp, ForOp> {
 
     using LoopValues = std::unordered_set<Value::Ptr>;
 
+    static void collectValues(const Operation::Ptr &op, LoopValues &values) {
+        values.insert(op->inwards.begin(), op->inwards.end());
+        for (const auto &childOp : op->body) {
+            values.insert(childOp->results.begin(), childOp->results.end());
+            collectValues(childOp, values);
+        }
+    }
+
     static bool isInvariant(const Operation::Ptr &op, const LoopValues &values) {
         bool result = false;
         for (const auto &operand : op->operands) {
@@ -33,32 +46,73 @@ struct HoistLoopInvariants : public Transform<WhileOp, ForOp> {
         return !result;
     }
 
-    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
-        LoopValues values;
-        for (const auto &childOp : op->body) {
-            for (const auto &result : childOp->results) {
-                values.insert(result);
-            }
-            if (childOp->as<StoreOp>()) {
-                for (const auto &operand : childOp->operands) {
-                    values.insert(operand);
-                }
-            }
+    // Hoisted operations are executed even if the loop body is not, so they must not trap: the division traps on
+    // zero divisor and on INT_MIN / -1
+    static bool isSpeculatable(const Operation::Ptr &op) {
+        if (auto binaryOp = op->as<ArithBinaryOp>(); binaryOp && binaryOp.kind() == ArithBinOpKind::DivI) {
+            auto divisorOp = getValueOwnerAs<ConstantOp>(binaryOp.rhs());
+            if (!divisorOp)
+                return false;
+            auto divisor = divisorOp.value().as<NativeInt>();
+            return divisor != 0 && divisor != -1;
         }
+        if (auto loadOp = op->as<LoadOp>()) {
+            if (loadOp.result()->type->is<VectorType>())
+                return false;
+            if (!loadOp.offset())
+                return true;
+            const auto &type = loadOp.src()->type->as<PointerType>();
+            auto offsetOp = getValueOwnerAs<ConstantOp>(loadOp.offset());
+            if (!offsetOp || type.numElements == PointerType::dynamic)
+                return false;
+            auto offset = offsetOp.value().as<NativeInt>();
+            return offset >= 0 && static_cast<size_t>(offset) < type.numElements;
+        }
+        return true;
+    }
 
+    static bool mayBeModified(const LoadOp &loadOp, const MemoryEffects &writes) {
+        auto read = readEffect(loadOp);
+        return std::ranges::any_of(writes, [&read](const MemoryEffect &write) {
+            return alias(write, read) != AliasResult::NoAlias;
+        });
+    }
+
+    static bool canHoist(const Operation::Ptr &op, const MemoryEffects &writes) {
+        if (isConditionPredicate(op))
+            return false;
+        if (auto loadOp = op->as<LoadOp>())
+            return !mayBeModified(loadOp, writes) && isSpeculatable(op);
+        return utils::isAny<ConstantOp, ArithBinaryOp, ArithCastOp, ArithUnaryOp, LogicBinaryOp, LogicUnaryOp>(op) &&
+               isSpeculatable(op);
+    }
+
+    static void hoist(const Operation::Ptr &op, const Operation::Ptr &loopOp, const MemoryEffects &writes,
+                      LoopValues &values, OptBuilder &builder) {
         for (const auto &childOp : utils::advanceEarly(op->body)) {
-            if (utils::isAny<WhileOp, ForOp, LoadOp, ConditionOp, StoreOp>(childOp)) {
+            if (!childOp->body.empty()) {
+                hoist(childOp, loopOp, writes, values, builder);
                 continue;
             }
-
-            if (isInvariant(childOp, values)) {
-                builder.setInsertPointBefore(op);
-                auto cloned = builder.clone(childOp);
-                builder.replace(childOp, cloned);
-                builder.setInsertPointAfter(cloned);
-            }
+            if (!canHoist(childOp, writes) || !isInvariant(childOp, values))
+                continue;
+            builder.setInsertPointBefore(loopOp);
+            auto cloned = builder.clone(childOp);
+            for (const auto &result : childOp->results)
+                values.erase(result);
+            builder.replace(childOp, cloned);
         }
     }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        LoopValues values;
+        collectValues(op, values);
+        MemoryEffects writes;
+        for (const auto &effect : MemoryEffectsAnalysis(op).getEffects(op))
+            if (effect.modifiesMemory())
+                writes.push_back(effect);
+        hoist(op, op, writes, values, builder);
+    }
 };
 
 } // namespace
@@ -0,0 +1,223 @@
+#include "optimizer/transform.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/definitions.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/profile.hpp"
+#include "compiler/utils/helpers.hpp"
+#include "compiler/utils/language.hpp"
+
+#include "optimizer/opt_builder.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+namespace {
+
+struct CallGraph {
+    std::vector<FunctionOp> functions;
+    std::unordered_map<std::string, size_t> indices;
+    std::vector<std::unordered_set<size_t>> callees;
+    std::unordered_map<std::string, size_t> numCalls;
+
+    static void collectCalls(const Operation::Ptr &op, std::vector<FunctionCallOp> &calls) {
+        for (const auto &childOp : op->body) {
+            if (auto callOp = childOp->as<FunctionCallOp>())
+                calls.push_back(callOp);
+            collectCalls(childOp, calls);
+        }
+    }
+
+    static std::vector<FunctionCallOp> collectCalls(const Operation::Ptr &op) {
+        std::vector<FunctionCallOp> calls;
+        collectCalls(op, calls);
+        return calls;
+    }
+
+    explicit CallGraph(const Operation::Ptr &moduleOp) {
+        for (const auto &childOp : moduleOp->body) {
+            if (auto funcOp = childOp->as<FunctionOp>()) {
+                indices[funcOp.name()] = functions.size();
+                functions.push_back(funcOp);
+            }
+        }
+        callees.resize(functions.size());
+        for (size_t i = 0; i < functions.size(); i++) {
+            for (const auto &callOp : collectCalls(functions[i])) {
+                numCalls[callOp.name()]++;
+                if (auto it = indices.find(callOp.name()); it != indices.end())
+                    callees[i].insert(it->second);
+            }
+        }
+    }
+
+    // Tarjan's algorithm emits strongly connected components after all components reachable from them,
+    // so callees always precede their callers in the result
+    std::vector<std::vector<size_t>> stronglyConnectedComponents() const {
+        constexpr size_t unvisited = -1;
+        std::vector<size_t> order(functions.size(), unvisited);
+        std::vector<size_t> lowLink(functions.size());
+        std::vector<bool> onStack(functions.size(), false);
+        std::vector<size_t> stack;
+        std::vector<std::vector<size_t>> components;
+        size_t counter = 0;
+
+        std::function<void(size_t)> visit = [&](size_t v) {
+            order[v] = lowLink[v] = counter++;
+            stack.push_back(v);
+            onStack[v] = true;
+            for (size_t w : callees[v]) {
+                if (order[w] == unvisited) {
+                    visit(w);
+                    lowLink[v] = std::min(lowLink[v], lowLink[w]);
+                } else if (onStack[w]) {
+                    lowLink[v] = std::min(lowLink[v], order[w]);
+                }
+            }
+            if (lowLink[v] != order[v])
+                return;
+            auto &component = components.emplace_back();
+            size_t w = unvisited;
+            while (w != v) {
+                w = stack.back();
+                stack.pop_back();
+                onStack[w] = false;
+                component.push_back(w);
+            }
+        };
+
+        for (size_t v = 0; v < functions.size(); v++)
+            if (order[v] == unvisited)
+                visit(v);
+        return components;
+    }
+};
+
+struct InlineFunctions : public Transform<ModuleOp> {
+    size_t sizeThreshold;
+
+    // Functions of this size are not larger than the call sequence itself, so inlining them is always profitable
+    static constexpr size_t trivialSize = 8U;
+    // Functions called at least hotCallCount times by the profiled run are inlined with the larger size threshold
+    static constexpr NativeInt hotCallCount = 1000;
+    static constexpr size_t hotSizeFactor = 4U;
+
+    explicit InlineFunctions(size_t sizeThreshold) : sizeThreshold(sizeThreshold){};
+    InlineFunctions(const InlineFunctions &) = default;
+    InlineFunctions(InlineFunctions &&) = default;
+    ~InlineFunctions() override = default;
+
+    std::string_view name() const override {
+        return "InlineFunctions";
+    }
+
+    bool recurse() const override {
+        return false;
+    }
+
+    static size_t countOps(const Operation::Ptr &op) {
+        size_t count = 0;
+        for (const auto &childOp : op->body)
+            count += 1U + countOps(childOp);
+        return count;
+    }
+
+    static size_t countReturns(const Operation::Ptr &op) {
+        size_t count = 0;
+        for (const auto &childOp : op->body)
+            count += (childOp->is<ReturnOp>() ? 1U : 0U) + countReturns(childOp);
+        return count;
+    }
+
+    // Early returns from nested regions can not be expressed in the body of the caller
+    static bool hasSingleExit(const FunctionOp &funcOp) {
+        size_t numReturns = countReturns(funcOp);
+        return numReturns == 0U || (numReturns == 1U && funcOp->body.back()->is<ReturnOp>());
+    }
+
+    bool shouldInline(const FunctionOp &callee, size_t numCalls) const {
+        if (!hasSingleExit(callee))
+            return false;
+        if (callee.hasDecorator(utils::language::atInline))
+            return true;
+        size_t size = countOps(callee);
+        if (size <= trivialSize)
+            return true;
+        auto counts = getProfileCounts(callee);
+        if (counts.empty())
+            return size * numCalls <= sizeThreshold;
+        // Functions never called by the profiled run are cold, inlining them would only grow the code
+        if (counts.front() == 0)
+            return false;
+        return size * numCalls <= (counts.front() >= hotCallCount ? sizeThreshold * hotSizeFactor : sizeThreshold);
+    }
+
+    static void inlineCall(const FunctionCallOp &callOp, const FunctionOp &callee, OptBuilder &builder) {
+        auto body = callee->clone();
+        for (const auto &[inward, argument] : utils::zip(body->inwards, callOp->operands))
+            builder.replace(inward, argument);
+        builder.setInsertPointBefore(callOp);
+        for (const auto &childOp : utils::advanceEarly(body->body)) {
+            if (childOp->is<ReturnOp>()) {
+                if (childOp->numOperands() != 0U)
+                    builder.replace(callOp.result(), childOp->operand(0));
+                builder.erase(childOp);
+                continue;
+            }
+            auto cloned = builder.clone(childOp);
+            builder.replace(childOp, cloned);
+            builder.setInsertPointAfter(cloned);
+        }
+        builder.erase(body);
+        builder.erase(callOp);
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        CallGraph graph(op);
+        auto components = graph.stronglyConnectedComponents();
+        // Recursive functions would be expanded infinitely, so they are never inlined
+        std::vector<bool> recursive(graph.functions.size(), false);
+        for (const auto &component : components)
+            for (size_t v : component)
+                recursive[v] = component.size() > 1U || graph.callees[v].contains(v);
+
+        for (const auto &component : components) {
+            for (size_t caller : component) {
+                for (const auto &callOp : CallGraph::collectCalls(graph.functions[caller])) {
+                    auto it = graph.indices.find(callOp.name());
+                    if (it == graph.indices.end() || recursive[it->second])
+                        continue;
+                    const auto &callee = graph.functions[it->second];
+                    if (!shouldInline(callee, graph.numCalls[callee.name()]))
+                        continue;
+                    graph.numCalls[callee.name()]--;
+                    for (const auto &innerCallOp : CallGraph::collectCalls(callee))
+                        graph.numCalls[innerCallOp.name()]++;
+                    inlineCall(callOp, callee, builder);
+                }
+            }
+        }
+    }
+};
+
+} // namespace
+
+namespace optree {
+namespace optimizer {
+
+BaseTransform::Ptr createInlineFunctions(size_t sizeThreshold) {
+    return std::make_shared<InlineFunctions>(sizeThreshold);
+}
+
+} // namespace optimizer
+} // namespace optree
@@ -34,6 +34,11 @@ struct JoinConditionsBranches : public Transform<IfOp> {
                 builder.erase(elseOp);
                 builder.setInsertPointBefore(op);
                 for (const auto &childOp : utils::advanceEarly(thenOp->body)) {
+                    if (childOp->is<YieldOp>()) {
+                        for (const auto &[result, value] : utils::zip(op->results, childOp->operands))
+                            builder.replace(result, value);
+                        continue;
+                    }
                     auto cloned = builder.clone(childOp);
                     builder.replace(childOp, cloned);
                     builder.setInsertPointAfter(cloned);
@@ -0,0 +1,173 @@
+#include "optimizer/transform.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/attribute.hpp"
+#include "compiler/optree/helpers.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/types.hpp"
+#include "compiler/optree/value.hpp"
+#include "compiler/utils/helpers.hpp"
+#include "compiler/utils/language.hpp"
+
+#include "optimizer/opt_builder.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+namespace {
+
+struct MergeIdenticalFunctions : public Transform<ModuleOp> {
+    using Transform::Transform;
+    using CallSites = std::unordered_map<std::string, std::vector<FunctionCallOp>>;
+    // Values defined within the function are identified by the order of their definitions
+    using ValueNumbers = std::unordered_map<const Value *, size_t>;
+    using ValueMapping = std::unordered_map<const Value *, const Value *>;
+
+    std::string_view name() const override {
+        return "MergeIdenticalFunctions";
+    }
+
+    bool recurse() const override {
+        return false;
+    }
+
+    static void combine(size_t &hash, size_t value) {
+        hash ^= value + 0x9e3779b9U + (hash << 6U) + (hash >> 2U);
+    }
+
+    static size_t hashType(const Type::Ptr &type) {
+        return std::hash<std::string>{}(type->dump());
+    }
+
+    // Name of the function is its only attribute, which does not affect the structure
+    static size_t firstStructuralAttr(const Operation::Ptr &op) {
+        return op->is<FunctionOp>() ? 1U : 0U;
+    }
+
+    static void hashOp(const Operation::Ptr &op, ValueNumbers &numbers, size_t &hash) {
+        combine(hash, std::hash<std::string_view>{}(op->name));
+        combine(hash, op->body.size());
+        for (size_t i = firstStructuralAttr(op); i < op->numAttrs(); i++)
+            combine(hash, hashAttribute(op->attr(i)));
+        for (const auto &operand : op->operands) {
+            auto it = numbers.find(operand.get());
+            combine(hash, it != numbers.end() ? it->second : std::hash<Value::Ptr>{}(operand));
+        }
+        for (const auto *values : {&op->inwards, &op->results}) {
+            for (const auto &value : *values) {
+                numbers.emplace(value.get(), numbers.size());
+                combine(hash, hashType(value->type));
+            }
+        }
+        for (const auto &childOp : op->body)
+            hashOp(childOp, numbers, hash);
+    }
+
+    static size_t hashFunction(const FunctionOp &funcOp) {
+        ValueNumbers numbers;
+        size_t hash = 0U;
+        hashOp(funcOp, numbers, hash);
+        return hash;
+    }
+
+    // Operations are identical if they differ only by the values defined within the compared functions, which are
+    // defined by the corresponding operations
+    static bool identical(const Operation::Ptr &lhs, const Operation::Ptr &rhs, ValueMapping &mapping) {
+        if (lhs->name != rhs->name || lhs->numAttrs() != rhs->numAttrs() || lhs->numOperands() != rhs->numOperands() ||
+            lhs->numInwards() != rhs->numInwards() || lhs->numResults() != rhs->numResults() ||
+            lhs->body.size() != rhs->body.size())
+            return false;
+        for (size_t i = firstStructuralAttr(lhs); i < lhs->numAttrs(); i++)
+            if (!sameAttribute(lhs->attr(i), rhs->attr(i)))
+                return false;
+        for (const auto &[lhsOperand, rhsOperand] : utils::zip(lhs->operands, rhs->operands)) {
+            auto it = mapping.find(lhsOperand.get());
+            if (it != mapping.end() ? it->second != rhsOperand.get() : lhsOperand != rhsOperand)
+                return false;
+        }
+        auto mapValues = [&mapping](const auto &lhsValues, const auto &rhsValues) {
+            for (const auto &[lhsValue, rhsValue] : utils::zip(lhsValues, rhsValues)) {
+                if (!lhsValue->sameType(rhsValue))
+                    return false;
+                mapping.emplace(lhsValue.get(), rhsValue.get());
+            }
+            return true;
+        };
+        if (!mapValues(lhs->inwards, rhs->inwards) || !mapValues(lhs->results, rhs->results))
+            return false;
+        for (const auto &[lhsChild, rhsChild] : utils::zip(lhs->body, rhs->body))
+            if (!identical(lhsChild, rhsChild, mapping))
+                return false;
+        return true;
+    }
+
+    static void collectCalls(const Operation::Ptr &op, CallSites &calls) {
+        for (const auto &childOp : op->body) {
+            if (auto callOp = childOp->as<FunctionCallOp>())
+                calls[callOp.name()].push_back(callOp);
+            collectCalls(childOp, calls);
+        }
+    }
+
+    // Functions are merged into the first identical one, calls of the merged functions are redirected to it
+    static bool mergeFunctions(const Operation::Ptr &op, OptBuilder &builder) {
+        std::unordered_map<size_t, std::vector<FunctionOp>> candidates;
+        std::vector<std::pair<FunctionOp, FunctionOp>> merged;
+        for (const auto &childOp : op->body) {
+            auto funcOp = childOp->as<FunctionOp>();
+            if (!funcOp || funcOp.name() == utils::language::funcMain)
+                continue;
+            auto &sameHash = candidates[hashFunction(funcOp)];
+            bool isMerged = false;
+            for (const auto &canonicalOp : sameHash) {
+                ValueMapping mapping;
+                if (identical(funcOp, canonicalOp, mapping)) {
+                    merged.emplace_back(funcOp, canonicalOp);
+                    isMerged = true;
+                    break;
+                }
+            }
+            if (!isMerged)
+                sameHash.push_back(funcOp);
+        }
+        if (merged.empty())
+            return false;
+
+        CallSites calls;
+        collectCalls(op, calls);
+        for (const auto &[funcOp, canonicalOp] : merged) {
+            const auto &name = canonicalOp.name();
+            for (auto callOp : calls[funcOp.name()])
+                builder.update(callOp, [&callOp, &name] { callOp.setName(name); });
+            builder.erase(funcOp);
+        }
+        return true;
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        // Functions calling the merged ones may become identical after the calls are redirected
+        while (mergeFunctions(op, builder)) {
+        }
+    }
+};
+
+} // namespace
+
+namespace optree {
+namespace optimizer {
+
+BaseTransform::Ptr createMergeIdenticalFunctions() {
+    return std::make_shared<MergeIdenticalFunctions>();
+}
+
+} // namespace optimizer
+} // namespace optree
@@ -0,0 +1,283 @@
+#include "optimizer/transform.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/definitions.hpp"
+#include "compiler/optree/helpers.hpp"
+#include "compiler/optree/memory_effects.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/types.hpp"
+#include "compiler/optree/value.hpp"
+#include "compiler/utils/helpers.hpp"
+#include "compiler/utils/language.hpp"
+
+#include "optimizer/opt_builder.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+namespace {
+
+struct ParallelizeLoops : public Transform<ModuleOp> {
+    size_t minTripCount;
+
+    explicit ParallelizeLoops(size_t minTripCount) : minTripCount(minTripCount){};
+    ParallelizeLoops(const ParallelizeLoops &) = default;
+    ParallelizeLoops(ParallelizeLoops &&) = default;
+    ~ParallelizeLoops() override = default;
+
+    std::string_view name() const override {
+        return "ParallelizeLoops";
+    }
+
+    bool recurse() const override {
+        return false;
+    }
+
+    static std::optional<NativeInt> constantValue(const Value::Ptr &value) {
+        auto constOp = getValueOwnerAs<ConstantOp>(value);
+        if (!constOp || !constOp.value().is<NativeInt>())
+            return std::nullopt;
+        return constOp.value().as<NativeInt>();
+    }
+
+    static bool isInside(const Operation::Ptr &op, const Operation::Ptr &loopOp) {
+        for (auto parentOp = op; parentOp; parentOp = parentOp->parent)
+            if (parentOp == loopOp)
+                return true;
+        return false;
+    }
+
+    static bool isDefinedInside(const Value::Ptr &value, const Operation::Ptr &loopOp) {
+        return isInside(value->owner.lock(), loopOp);
+    }
+
+    static bool containsReturn(const Operation::Ptr &op) {
+        for (const auto &childOp : op->body)
+            if (childOp->is<ReturnOp>() || containsReturn(childOp))
+                return true;
+        return false;
+    }
+
+    // Values carried between the iterations can not be shared by the threads, so they are allowed only if they are
+    // never used (these remain after the promotion of variables declared inside the loop)
+    static bool hasLiveCarriedValues(const ForOp &forOp) {
+        for (size_t i = 1; i < forOp->numInwards(); i++)
+            if (!forOp->inward(i)->uses.empty())
+                return true;
+        for (const auto &result : forOp->results)
+            if (!result->uses.empty())
+                return true;
+        return false;
+    }
+
+    // Each iteration may access the memory allocated by itself and the elements of the outer memory indexed by the
+    // iterator, any other access to the outer memory must not alias with the writes made by other iterations
+    static bool hasIndependentIterations(const ForOp &forOp, const MemoryEffectsAnalysis &analysis) {
+        MemoryEffects shared;
+        for (const auto &effect : analysis.getEffects(forOp)) {
+            if (effect.kind == MemoryEffectKind::IO)
+                return false;
+            if (!effect.isMemoryAccess())
+                continue;
+            if (!effect.ptr)
+                return false;
+            auto root = getPointerRoot(effect.ptr);
+            if (!root || !isInside(root, forOp))
+                shared.push_back(effect);
+        }
+        auto isIndexed = [&forOp](const MemoryEffect &effect) {
+            return !effect.wholeObject && effect.kind != MemoryEffectKind::Free &&
+                   effect.offset == forOp.iterator() && !isDefinedInside(effect.ptr, forOp);
+        };
+        for (size_t i = 0; i < shared.size(); i++) {
+            for (size_t j = i; j < shared.size(); j++) {
+                const auto &lhs = shared[i];
+                const auto &rhs = shared[j];
+                if (!lhs.modifiesMemory() && !rhs.modifiesMemory())
+                    continue;
+                if (isIndexed(lhs) && isIndexed(rhs))
+                    continue;
+                if (alias(lhs, rhs) != AliasResult::NoAlias)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    bool isParallelizable(const ForOp &forOp, const MemoryEffectsAnalysis &analysis) const {
+        auto step = constantValue(forOp.step());
+        const auto &iteratorType = forOp.iterator()->type;
+        if (!step || *step <= 0 || !iteratorType->is<IntegerType>() || iteratorType->bitWidth() != 64U)
+            return false;
+        auto start = constantValue(forOp.start());
+        auto stop = constantValue(forOp.stop());
+        if (start && stop && (*stop <= *start || static_cast<size_t>((*stop - *start - 1) / *step + 1) < minTripCount))
+            return false;
+        return !hasLiveCarriedValues(forOp) && !containsReturn(forOp) && hasIndependentIterations(forOp, analysis);
+    }
+
+    static void collectCaptures(const Operation::Ptr &op, const ForOp &forOp, std::vector<Value::Ptr> &captures,
+                                std::unordered_set<Value::Ptr> &visited) {
+        for (const auto &childOp : op->body) {
+            for (const auto &operand : childOp->operands)
+                if (!isDefinedInside(operand, forOp) && visited.insert(operand).second)
+                    captures.push_back(operand);
+            collectCaptures(childOp, forOp, captures, visited);
+        }
+    }
+
+    static void remapOperands(const Operation::Ptr &op, const std::unordered_map<Value::Ptr, Value::Ptr> &mapping,
+                              OptBuilder &builder) {
+        for (const auto &childOp : op->body) {
+            for (size_t i = 0; i < childOp->numOperands(); i++) {
+                auto it = mapping.find(childOp->operand(i));
+                if (it != mapping.end())
+                    builder.update(childOp, [&childOp, i, &it] { childOp->setOperand(i, it->second); });
+            }
+            remapOperands(childOp, mapping, builder);
+        }
+    }
+
+    static std::string uniqueName(const std::string &base, const ModuleOp &moduleOp) {
+        for (size_t i = 1;; i++) {
+            auto name = base + ".parallel." + std::to_string(i);
+            if (!moduleOp.lookup<FunctionOp>(name))
+                return name;
+        }
+    }
+
+    // The outlined function runs the iterations of the loop from begin to end, the step of the loop is its third
+    // argument, the constants are copied into it and other values defined outside the loop are passed after the step
+    static FunctionOp outline(const ForOp &forOp, const FunctionOp &funcOp, const std::vector<Value::Ptr> &captures,
+                              const ModuleOp &moduleOp, OptBuilder &builder) {
+        const auto &ref = forOp->ref;
+        const auto &iteratorType = forOp.iterator()->type;
+        Type::PtrVector arguments = {iteratorType, iteratorType, iteratorType};
+        for (const auto &value : captures)
+            if (!getValueOwnerAs<ConstantOp>(value))
+                arguments.push_back(value->type);
+        // Outlined functions follow the function they are taken from in the order of the loops
+        Operation::Ptr prevOp = funcOp;
+        for (auto it = std::next(funcOp->position); it != moduleOp->body.end(); ++it) {
+            auto nextFuncOp = (*it)->as<FunctionOp>();
+            if (!nextFuncOp || !nextFuncOp.hasDecorator(utils::language::atParallel))
+                break;
+            prevOp = nextFuncOp;
+        }
+        builder.setInsertPointAfter(prevOp);
+        auto funcType = Type::make<FunctionType>(arguments, TypeStorage::noneType());
+        auto outlined = builder.insert<FunctionOp>(ref, uniqueName(funcOp.name(), moduleOp), funcType);
+        builder.update(outlined, [&outlined] { outlined.addDecorator(utils::language::atParallel); });
+
+        builder.setInsertPointAtBodyEnd(outlined);
+        std::unordered_map<Value::Ptr, Value::Ptr> mapping;
+        size_t index = 3U;
+        for (const auto &value : captures) {
+            if (auto constOp = getValueOwnerAs<ConstantOp>(value))
+                mapping[value] = builder.clone(constOp)->result(0);
+            else
+                mapping[value] = outlined->inward(index++);
+        }
+        // The step is passed for the runtime only, the loop keeps it constant to be vectorized and unrolled later
+        auto step = builder.clone(getValueOwnerAs<ConstantOp>(forOp.step()))->result(0);
+        auto loopOp = builder.clone(forOp);
+        builder.insert<ReturnOp>(ref);
+        if (!loopOp->body.empty() && loopOp->body.back()->is<YieldOp>())
+            builder.erase(loopOp->body.back());
+        builder.update(loopOp, [&loopOp, &outlined, &step] {
+            loopOp->setOperand(0, outlined->inward(0));
+            loopOp->setOperand(1, outlined->inward(1));
+            loopOp->setOperand(2, step);
+            while (loopOp->numOperands() > 3U)
+                loopOp->eraseOperand(loopOp->numOperands() - 1U);
+            loopOp->inwards.resize(1U);
+            loopOp->results.clear();
+        });
+        remapOperands(loopOp, mapping, builder);
+        return outlined;
+    }
+
+    // Calls the outlined function, the loop is kept for the iteration counts below the threshold
+    // if it is not known at compile time
+    void replaceLoop(const ForOp &forOp, const FunctionOp &outlined, const std::vector<Value::Ptr> &captures,
+                     OptBuilder &builder) const {
+        const auto &ref = forOp->ref;
+        std::vector<Value::Ptr> arguments = {forOp.start(), forOp.stop(), forOp.step()};
+        for (const auto &value : captures)
+            if (!getValueOwnerAs<ConstantOp>(value))
+                arguments.push_back(value);
+        builder.setInsertPointBefore(forOp);
+        bool isConstant = constantValue(forOp.start()) && constantValue(forOp.stop());
+        if (isConstant || minTripCount <= 1U) {
+            builder.insert<FunctionCallOp>(ref, outlined, arguments);
+            builder.erase(forOp);
+            return;
+        }
+        const auto &type = forOp.iterator()->type;
+        auto step = *constantValue(forOp.step());
+        auto threshold = builder.insert<ConstantOp>(ref, type, static_cast<NativeInt>(minTripCount - 1U) * step);
+        auto distance = builder.insert<ArithBinaryOp>(ref, ArithBinOpKind::SubI, forOp.stop(), forOp.start());
+        auto cond = builder.insert<LogicBinaryOp>(ref, LogicBinOpKind::GreaterI, distance.result(), threshold.result());
+        auto ifOp = builder.insert<IfOp>(ref, cond.result(), true);
+        builder.setInsertPointAtBodyEnd(ifOp.thenOp());
+        builder.insert<FunctionCallOp>(ref, outlined, arguments);
+        builder.setInsertPointAtBodyEnd(ifOp.elseOp());
+        builder.replace(forOp, builder.clone(forOp));
+    }
+
+    bool tryParallelize(const ForOp &forOp, const FunctionOp &funcOp, const ModuleOp &moduleOp,
+                        const MemoryEffectsAnalysis &analysis, OptBuilder &builder) const {
+        if (!isParallelizable(forOp, analysis))
+            return false;
+        std::vector<Value::Ptr> captures;
+        std::unordered_set<Value::Ptr> visited;
+        collectCaptures(forOp, forOp, captures, visited);
+        auto outlined = outline(forOp, funcOp, captures, moduleOp, builder);
+        replaceLoop(forOp, outlined, captures, builder);
+        return true;
+    }
+
+    // Loops are visited from the outermost ones, so the nested loops of the parallelized loop are left as is
+    void visitRegion(const Operation::Ptr &op, const FunctionOp &funcOp, const ModuleOp &moduleOp,
+                     const MemoryEffectsAnalysis &analysis, OptBuilder &builder) const {
+        for (const auto &childOp : utils::advanceEarly(op->body)) {
+            auto forOp = childOp->as<ForOp>();
+            if (forOp && tryParallelize(forOp, funcOp, moduleOp, analysis, builder))
+                continue;
+            visitRegion(childOp, funcOp, moduleOp, analysis, builder);
+        }
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        auto moduleOp = op->as<ModuleOp>();
+        MemoryEffectsAnalysis analysis(op);
+        std::vector<FunctionOp> functions;
+        for (const auto &childOp : op->body)
+            if (auto funcOp = childOp->as<FunctionOp>(); funcOp && !funcOp.hasDecorator(utils::language::atParallel))
+                functions.push_back(funcOp);
+        for (const auto &funcOp : functions)
+            visitRegion(funcOp, funcOp, moduleOp, analysis, builder);
+    }
+};
+
+} // namespace
+
+namespace optree {
+namespace optimizer {
+
+BaseTransform::Ptr createParallelizeLoops(size_t minTripCount) {
+    return std::make_shared<ParallelizeLoops>(minTripCount);
+}
+
+} // namespace optimizer
+} // namespace optree
@@ -0,0 +1,160 @@
+#include "optimizer/transform.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/definitions.hpp"
+#include "compiler/optree/helpers.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/types.hpp"
+#include "compiler/optree/value.hpp"
+#include "compiler/utils/helpers.hpp"
+
+#include "optimizer/opt_builder.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+namespace {
+
+struct PlaceAllocations : public Transform<FunctionOp> {
+    size_t heapThreshold;
+
+    explicit PlaceAllocations(size_t heapThreshold) : heapThreshold(heapThreshold){};
+    PlaceAllocations(const PlaceAllocations &) = default;
+    PlaceAllocations(PlaceAllocations &&) = default;
+    ~PlaceAllocations() override = default;
+
+    std::string_view name() const override {
+        return "PlaceAllocations";
+    }
+
+    bool recurse() const override {
+        return false;
+    }
+
+    static size_t elementSize(const Type::Ptr &type) {
+        constexpr unsigned pointerWidth = 64U;
+        unsigned width = type->bitWidth();
+        if (width == 0U)
+            width = pointerWidth;
+        return (width + 7U) / 8U;
+    }
+
+    bool needsHeap(const AllocateOp &allocOp) const {
+        // Lifetime of the allocation in the condition region can not be limited by its scope
+        if (allocOp->parent->is<ConditionOp>())
+            return false;
+        const auto &type = allocOp.result()->type->as<PointerType>();
+        size_t numElements = type.numElements;
+        if (numElements == PointerType::dynamic) {
+            auto sizeOp = constantSize(allocOp);
+            if (!sizeOp)
+                return true;
+            numElements = static_cast<size_t>(sizeOp.value().as<NativeInt>());
+        }
+        // Elements are at least a byte long, the check goes first so that the size computation does not overflow
+        return numElements > heapThreshold || numElements * elementSize(type.pointee) > heapThreshold;
+    }
+
+    // Dynamic size known at compile time, the allocation of this size is placed like the fixed size ones
+    static ConstantOp constantSize(const AllocateOp &allocOp) {
+        auto dynamicSize = allocOp.dynamicSize();
+        if (!dynamicSize)
+            return {};
+        auto sizeOp = getValueOwnerAs<ConstantOp>(dynamicSize);
+        if (!sizeOp || !sizeOp.value().is<NativeInt>() || sizeOp.value().as<NativeInt>() < 0)
+            return {};
+        return sizeOp;
+    }
+
+    static void collectAllocations(const Operation::Ptr &op, std::vector<AllocateOp> &allocOps) {
+        for (const auto &childOp : op->body) {
+            if (auto allocOp = childOp->as<AllocateOp>())
+                allocOps.push_back(allocOp);
+            collectAllocations(childOp, allocOps);
+        }
+    }
+
+    static void deallocateBeforeReturns(const Operation::Ptr &op, const HeapAllocateOp &allocOp, OptBuilder &builder) {
+        if (op->is<ReturnOp>()) {
+            builder.setInsertPointBefore(op);
+            builder.insert<DeallocateOp>(allocOp->ref, allocOp.result());
+            return;
+        }
+        for (const auto &childOp : utils::advanceEarly(op->body))
+            deallocateBeforeReturns(childOp, allocOp, builder);
+    }
+
+    static void moveToHeap(const AllocateOp &allocOp, OptBuilder &builder) {
+        builder.setInsertPointBefore(allocOp.op);
+        auto heapAllocOp = builder.insert<HeapAllocateOp>(allocOp->ref, allocOp.result()->type, allocOp.dynamicSize());
+        builder.replace(allocOp.op, heapAllocOp.op);
+
+        // The allocation is freed when the control leaves its scope: either at the end of the region (before the
+        // terminating YieldOp) or on return
+        const auto &region = heapAllocOp->parent;
+        for (auto it = std::next(heapAllocOp->position); it != region->body.end(); ++it)
+            deallocateBeforeReturns(*it, heapAllocOp, builder);
+        const auto &lastOp = region->body.back();
+        if (!lastOp->is<ReturnOp>()) {
+            if (lastOp->is<YieldOp>())
+                builder.setInsertPointBefore(lastOp);
+            else
+                builder.setInsertPointAtBodyEnd(region);
+            builder.insert<DeallocateOp>(heapAllocOp->ref, heapAllocOp.result());
+        }
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        std::vector<AllocateOp> allocOps;
+        collectAllocations(op, allocOps);
+
+        // Fixed size allocations are grouped at the beginning of the function in their original order, the constant
+        // dynamic size is placed right before its allocation
+        Operation::Ptr lastPlaced;
+        for (const auto &allocOp : allocOps) {
+            if (needsHeap(allocOp)) {
+                moveToHeap(allocOp, builder);
+                continue;
+            }
+            auto sizeOp = constantSize(allocOp);
+            auto expectedPosition = lastPlaced ? std::next(lastPlaced->position) : op->body.begin();
+            if (sizeOp && sizeOp->parent == op && sizeOp->position == expectedPosition)
+                expectedPosition = std::next(expectedPosition);
+            if (allocOp->parent == op && allocOp->position == expectedPosition) {
+                lastPlaced = allocOp.op;
+                continue;
+            }
+            if (lastPlaced)
+                builder.setInsertPointAfter(lastPlaced);
+            else
+                builder.setInsertPointBefore(op->body.front());
+            Value::Ptr placedSize;
+            if (sizeOp)
+                placedSize = builder.clone(sizeOp.op)->result(0);
+            lastPlaced = builder.clone(allocOp.op);
+            if (placedSize) {
+                auto placedOp = lastPlaced->as<AllocateOp>();
+                builder.update(lastPlaced, [&placedOp, &placedSize] { placedOp.setDynamicSize(placedSize); });
+            }
+            builder.replace(allocOp.op, lastPlaced);
+        }
+    }
+};
+
+} // namespace
+
+namespace optree {
+namespace optimizer {
+
+BaseTransform::Ptr createPlaceAllocations(size_t heapThreshold) {
+    return std::make_shared<PlaceAllocations>(heapThreshold);
+}
+
+} // namespace optimizer
+} // namespace optree
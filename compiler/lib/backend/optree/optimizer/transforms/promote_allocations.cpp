@@ -0,0 +1,250 @@
+#include "optimizer/transform.hpp"
+
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/types.hpp"
+#include "compiler/optree/value.hpp"
+#include "compiler/utils/helpers.hpp"
+
+#include "optimizer/opt_builder.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+namespace {
+
+class AllocationsRenamer {
+    using Definitions = std::unordered_map<Value::Ptr, Value::Ptr>;
+
+    OptBuilder &builder;
+    // Promoted pointers in the order of their allocations, so the created results are deterministic
+    std::vector<Value::Ptr> pointers;
+    std::unordered_set<Value::Ptr> promoted;
+    Definitions current;
+    Definitions undefined;
+
+    static Type::Ptr valueType(const Value::Ptr &ptr) {
+        return ptr->type->as<PointerType>().pointee;
+    }
+
+    Value::Ptr undefinedValue(const Value::Ptr &ptr) {
+        auto it = undefined.find(ptr);
+        if (it != undefined.end())
+            return it->second;
+        // Reading a variable before any store is undefined behavior, zero is as good as any other value
+        auto owner = ptr->owner.lock();
+        builder.setInsertPointBefore(owner);
+        const auto &type = valueType(ptr);
+        ConstantOp constOp;
+        if (type->is<BoolType>())
+            constOp = builder.insert<ConstantOp>(owner->ref, type, NativeBool(false));
+        else if (type->is<IntegerType>())
+            constOp = builder.insert<ConstantOp>(owner->ref, type, NativeInt(0));
+        else
+            constOp = builder.insert<ConstantOp>(owner->ref, type, NativeFloat(0.0));
+        return undefined[ptr] = constOp.result();
+    }
+
+    Value::Ptr valueOf(const Definitions &definitions, const Value::Ptr &ptr) {
+        auto it = definitions.find(ptr);
+        if (it != definitions.end())
+            return it->second;
+        return undefinedValue(ptr);
+    }
+
+    void collectStored(const Operation::Ptr &op, std::unordered_set<Value::Ptr> &stored) const {
+        for (const auto &childOp : op->body) {
+            if (auto storeOp = childOp->as<StoreOp>(); storeOp && promoted.contains(storeOp.dst()))
+                stored.insert(storeOp.dst());
+            collectStored(childOp, stored);
+        }
+    }
+
+    static bool isNestedIn(const Operation::Ptr &op, const Operation::Ptr &ancestor) {
+        for (auto parent = op->parent; parent; parent = parent->parent)
+            if (parent == ancestor)
+                return true;
+        return false;
+    }
+
+    // Variables allocated within the operation are not live outside of it and need no results
+    std::vector<Value::Ptr> storedWithin(const Operation::Ptr &op) const {
+        std::unordered_set<Value::Ptr> stored;
+        collectStored(op, stored);
+        std::vector<Value::Ptr> ordered;
+        for (const auto &ptr : pointers)
+            if (stored.contains(ptr) && !isNestedIn(ptr->owner.lock(), op))
+                ordered.push_back(ptr);
+        return ordered;
+    }
+
+    void appendYield(const Operation::Ptr &region, const std::vector<Value::Ptr> &values) {
+        if (!region->body.empty() && region->body.back()->is<YieldOp>()) {
+            const auto &yieldOp = region->body.back();
+            builder.update(yieldOp, [&] {
+                for (const auto &value : values)
+                    yieldOp->addOperand(value);
+            });
+            return;
+        }
+        builder.setInsertPointAtBodyEnd(region);
+        builder.insert<YieldOp>(region->ref, values);
+    }
+
+    void addResults(const Operation::Ptr &op, const std::vector<Value::Ptr> &stored) {
+        builder.update(op, [&] {
+            for (const auto &ptr : stored)
+                current[ptr] = op->addResult(valueType(ptr));
+        });
+    }
+
+    void processIfOp(const IfOp &ifOp) {
+        auto stored = storedWithin(ifOp);
+        auto before = current;
+        processBody(ifOp.thenOp());
+        auto afterThen = current;
+        current = before;
+        if (auto elseOp = ifOp.elseOp())
+            processBody(elseOp);
+        if (stored.empty())
+            return;
+        if (!ifOp.elseOp()) {
+            builder.setInsertPointAtBodyEnd(ifOp);
+            builder.insert<ElseOp>(ifOp->ref);
+        }
+        std::vector<Value::Ptr> thenValues;
+        std::vector<Value::Ptr> elseValues;
+        for (const auto &ptr : stored) {
+            thenValues.push_back(valueOf(afterThen, ptr));
+            elseValues.push_back(valueOf(current, ptr));
+        }
+        appendYield(ifOp.thenOp(), thenValues);
+        appendYield(ifOp.elseOp(), elseValues);
+        addResults(ifOp, stored);
+    }
+
+    void processLoopOp(const Operation::Ptr &loopOp) {
+        auto stored = storedWithin(loopOp);
+        builder.update(loopOp, [&] {
+            for (const auto &ptr : stored) {
+                loopOp->addOperand(valueOf(current, ptr));
+                current[ptr] = loopOp->addInward(valueType(ptr));
+            }
+        });
+        processBody(loopOp);
+        if (stored.empty())
+            return;
+        std::vector<Value::Ptr> nextValues;
+        for (const auto &ptr : stored)
+            nextValues.push_back(valueOf(current, ptr));
+        appendYield(loopOp, nextValues);
+        addResults(loopOp, stored);
+    }
+
+    void processOp(const Operation::Ptr &op) {
+        if (auto loadOp = op->as<LoadOp>(); loadOp && promoted.contains(loadOp.src())) {
+            builder.replace(loadOp.result(), valueOf(current, loadOp.src()));
+            builder.erase(op);
+            return;
+        }
+        if (auto storeOp = op->as<StoreOp>(); storeOp && promoted.contains(storeOp.dst())) {
+            current[storeOp.dst()] = storeOp.valueToStore();
+            builder.erase(op);
+            return;
+        }
+        if (auto ifOp = op->as<IfOp>()) {
+            processIfOp(ifOp);
+            return;
+        }
+        if (utils::isAny<WhileOp, ForOp>(op)) {
+            processLoopOp(op);
+            return;
+        }
+        processBody(op);
+    }
+
+    void processBody(const Operation::Ptr &op) {
+        for (const auto &childOp : utils::advanceEarly(op->body))
+            processOp(childOp);
+    }
+
+  public:
+    AllocationsRenamer(OptBuilder &builder, const std::vector<Value::Ptr> &pointers)
+        : builder(builder), pointers(pointers), promoted(pointers.begin(), pointers.end()){};
+
+    void run(const Operation::Ptr &funcOp) {
+        processBody(funcOp);
+    }
+};
+
+struct PromoteAllocations : public Transform<FunctionOp> {
+    using Transform::Transform;
+
+    std::string_view name() const override {
+        return "PromoteAllocations";
+    }
+
+    bool recurse() const override {
+        return false;
+    }
+
+    static bool isPromotable(const AllocateOp &allocOp) {
+        const auto &type = allocOp.result()->type->as<PointerType>();
+        if (type.numElements != 1U || !utils::isAny<IntegerType, FloatType>(type.pointee))
+            return false;
+        // The pointer must not escape: it is only loaded from and stored to without offsets
+        for (const auto &use : allocOp.result()->uses) {
+            auto user = use.lock();
+            if (use.operandNumber != 0U)
+                return false;
+            if (auto loadOp = user->as<LoadOp>(); loadOp && !loadOp.offset())
+                continue;
+            // Condition region can not produce values for the loop except for the predicate
+            if (auto storeOp = user->as<StoreOp>(); storeOp && !storeOp.offset() && !user->parent->is<ConditionOp>())
+                continue;
+            return false;
+        }
+        return true;
+    }
+
+    static void collectAllocations(const Operation::Ptr &op, std::vector<AllocateOp> &allocOps) {
+        for (const auto &childOp : op->body) {
+            if (auto allocOp = childOp->as<AllocateOp>(); allocOp && isPromotable(allocOp))
+                allocOps.push_back(allocOp);
+            collectAllocations(childOp, allocOps);
+        }
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        std::vector<AllocateOp> allocOps;
+        collectAllocations(op, allocOps);
+        if (allocOps.empty())
+            return;
+        std::vector<Value::Ptr> pointers;
+        pointers.reserve(allocOps.size());
+        for (const auto &allocOp : allocOps)
+            pointers.push_back(allocOp.result());
+
+        AllocationsRenamer(builder, pointers).run(op);
+        for (const auto &allocOp : allocOps)
+            builder.erase(allocOp);
+    }
+};
+
+} // namespace
+
+namespace optree {
+namespace optimizer {
+
+BaseTransform::Ptr createPromoteAllocations() {
+    return std::make_shared<PromoteAllocations>();
+}
+
+} // namespace optimizer
+} // namespace optree
@@ -0,0 +1,493 @@
+#include "optimizer/transform.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/attribute.hpp"
+#include "compiler/optree/evaluator.hpp"
+#include "compiler/optree/helpers.hpp"
+#include "compiler/optree/memory_effects.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/types.hpp"
+#include "compiler/optree/value.hpp"
+#include "compiler/utils/helpers.hpp"
+
+#include "optimizer/opt_builder.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+namespace {
+
+// Value is unknown until its definition is found to be executable, then it either holds a constant or becomes
+// overdefined if it may take different values
+struct LatticeValue {
+    enum class State {
+        Unknown,
+        Constant,
+        Overdefined,
+    };
+
+    State state = State::Unknown;
+    Attribute constant;
+
+    static LatticeValue makeConstant(const Attribute &value) {
+        return {State::Constant, value};
+    }
+
+    static LatticeValue makeOverdefined() {
+        return {State::Overdefined, {}};
+    }
+
+    bool isUnknown() const {
+        return state == State::Unknown;
+    }
+
+    bool isConstant() const {
+        return state == State::Constant;
+    }
+
+    bool isOverdefined() const {
+        return state == State::Overdefined;
+    }
+
+    bool operator==(const LatticeValue &other) const {
+        if (state != other.state)
+            return false;
+        if (state != State::Constant)
+            return true;
+        // Zeros of different signs and NaNs must be distinguished, so floats are compared bitwise
+        if (constant.is<NativeFloat>() && other.constant.is<NativeFloat>())
+            return std::bit_cast<uint64_t>(constant.as<NativeFloat>()) ==
+                   std::bit_cast<uint64_t>(other.constant.as<NativeFloat>());
+        return constant == other.constant;
+    }
+
+    void join(const LatticeValue &other) {
+        if (other.isUnknown() || *this == other)
+            return;
+        if (isUnknown())
+            *this = other;
+        else
+            *this = makeOverdefined();
+    }
+};
+
+// Loop with such bounds never executes its body
+bool isEmptyRange(const LatticeValue &start, const LatticeValue &stop) {
+    return start.isConstant() && stop.isConstant() && start.constant.as<NativeInt>() >= stop.constant.as<NativeInt>();
+}
+
+// Joint propagation of constants through values, memory and control flow over the whole module. Regions are
+// executed only if the conditions guarding them may take a corresponding value, and function arguments are
+// constant if all executable calls pass the same constant.
+class ConstantsSolver {
+    // Values stored to the first elements of memory, a missing pointer means unknown contents, and an empty
+    // state means that the point of the program is not executable
+    using MemoryState = std::optional<std::unordered_map<Value::Ptr, LatticeValue>>;
+
+    const MemoryEffectsAnalysis &effects;
+    std::unordered_map<Value::Ptr, LatticeValue> values;
+    std::unordered_map<std::string, std::vector<LatticeValue>> callArguments;
+
+    void set(const Value::Ptr &value, const LatticeValue &lattice) {
+        values[value] = lattice;
+    }
+
+    static void join(MemoryState &state, const MemoryState &other) {
+        if (!other)
+            return;
+        if (!state) {
+            state = other;
+            return;
+        }
+        for (auto &[ptr, value] : *state) {
+            auto it = other->find(ptr);
+            value.join(it != other->end() ? it->second : LatticeValue::makeOverdefined());
+        }
+        std::erase_if(*state, [](const auto &entry) { return entry.second.isOverdefined(); });
+    }
+
+    static void invalidate(MemoryState &state, const MemoryEffects &writes) {
+        std::erase_if(*state, [&writes](const auto &entry) {
+            MemoryEffect read{MemoryEffectKind::Read, entry.first, {}};
+            return std::ranges::any_of(writes, [&read](const MemoryEffect &write) {
+                return write.modifiesMemory() && alias(write, read) != AliasResult::NoAlias;
+            });
+        });
+    }
+
+    LatticeValue evaluate(const Operation::Ptr &op) const {
+        std::vector<Attribute> operands;
+        bool unknown = false;
+        for (const auto &operand : op->operands) {
+            auto lattice = get(operand);
+            if (lattice.isOverdefined())
+                return LatticeValue::makeOverdefined();
+            unknown |= lattice.isUnknown();
+            operands.push_back(lattice.constant);
+        }
+        if (unknown)
+            return {};
+        auto folded = fold(op, operands);
+        return folded ? LatticeValue::makeConstant(*folded) : LatticeValue::makeOverdefined();
+    }
+
+    std::vector<LatticeValue> yieldedValues(const Operation::Ptr &op) const {
+        std::vector<LatticeValue> yielded;
+        if (auto yieldOp = op->body.empty() ? YieldOp() : op->body.back()->as<YieldOp>())
+            for (const auto &operand : yieldOp->operands)
+                yielded.push_back(get(operand));
+        return yielded;
+    }
+
+    void visitIfOp(const IfOp &op, MemoryState &state) {
+        auto cond = get(op.cond());
+        std::vector<LatticeValue> results(op->numResults());
+        MemoryState merged;
+        auto visitBranch = [&](const Operation::Ptr &branchOp) {
+            MemoryState branchState = state;
+            if (branchOp)
+                visitRegion(branchOp, branchState);
+            if (!branchState)
+                return;
+            if (branchOp) {
+                auto yielded = yieldedValues(branchOp);
+                for (size_t i = 0; i < results.size() && i < yielded.size(); i++)
+                    results[i].join(yielded[i]);
+            }
+            join(merged, branchState);
+        };
+        if (!cond.isUnknown() && (!cond.isConstant() || cond.constant.as<NativeBool>()))
+            visitBranch(op.thenOp());
+        if (!cond.isUnknown() && (!cond.isConstant() || !cond.constant.as<NativeBool>()))
+            visitBranch(op.elseOp());
+        for (const auto &[result, value] : utils::zip(op->results, results))
+            set(result, value);
+        state = merged;
+    }
+
+    void visitLoop(const Operation::Ptr &op, MemoryState &state) {
+        auto forOp = op->as<ForOp>();
+        size_t firstInit = forOp ? ForOp::numControlOperands : 0U;
+        size_t firstCarried = forOp ? 1U : 0U;
+        std::vector<LatticeValue> carried;
+        for (size_t i = firstInit; i < op->numOperands(); i++)
+            carried.push_back(get(op->operand(i)));
+        if (forOp) {
+            auto start = get(forOp.start());
+            auto stop = get(forOp.stop());
+            if (start.isUnknown() || stop.isUnknown() || get(forOp.step()).isUnknown()) {
+                state.reset();
+                return;
+            }
+            set(forOp.iterator(), LatticeValue::makeOverdefined());
+            if (isEmptyRange(start, stop)) {
+                for (const auto &[result, value] : utils::zip(op->results, carried))
+                    set(result, value);
+                return;
+            }
+        }
+        // Values and memory at the loop header only move towards overdefined, so the iteration terminates
+        MemoryState head = state;
+        MemoryState exit;
+        while (true) {
+            for (size_t i = 0; i < carried.size(); i++)
+                set(op->inward(firstCarried + i), carried[i]);
+            MemoryState bodyState = head;
+            bool mayEnter = true;
+            if (auto whileOp = op->as<WhileOp>()) {
+                visitRegion(whileOp.conditionOp(), bodyState);
+                auto cond = bodyState ? get(whileOp.conditionOp().terminator()) : LatticeValue();
+                mayEnter = !cond.isUnknown() && (!cond.isConstant() || cond.constant.as<NativeBool>());
+                if (!cond.isUnknown() && (!cond.isConstant() || !cond.constant.as<NativeBool>()))
+                    exit = bodyState;
+            } else {
+                exit = head;
+            }
+            if (!mayEnter)
+                break;
+            visitRegion(op, bodyState);
+            if (!bodyState)
+                break;
+            bool changed = false;
+            auto yielded = yieldedValues(op);
+            for (size_t i = 0; i < carried.size() && i < yielded.size(); i++) {
+                auto joined = carried[i];
+                joined.join(yielded[i]);
+                changed |= joined != carried[i];
+                carried[i] = joined;
+            }
+            auto joinedHead = head;
+            join(joinedHead, bodyState);
+            changed |= joinedHead != head;
+            head = joinedHead;
+            if (!changed)
+                break;
+        }
+        for (const auto &[result, value] : utils::zip(op->results, carried))
+            set(result, value);
+        state = exit;
+    }
+
+    void visitOp(const Operation::Ptr &op, MemoryState &state) {
+        if (auto ifOp = op->as<IfOp>()) {
+            visitIfOp(ifOp, state);
+            return;
+        }
+        if (utils::isAny<WhileOp, ForOp>(op)) {
+            visitLoop(op, state);
+            return;
+        }
+        if (op->is<ReturnOp>()) {
+            state.reset();
+            return;
+        }
+        if (utils::isAny<ArithBinaryOp, ArithCastOp, ArithUnaryOp, LogicBinaryOp, LogicUnaryOp>(op)) {
+            set(op->result(0), evaluate(op));
+            return;
+        }
+        if (auto loadOp = op->as<LoadOp>()) {
+            auto it = state->find(loadOp.src());
+            bool isKnown = !loadOp.offset() && it != state->end();
+            set(loadOp.result(), isKnown ? it->second : LatticeValue::makeOverdefined());
+            return;
+        }
+        if (auto callOp = op->as<FunctionCallOp>()) {
+            auto &arguments = callArguments[callOp.name()];
+            arguments.resize(op->numOperands());
+            for (size_t i = 0; i < op->numOperands(); i++)
+                arguments[i].join(get(op->operand(i)));
+        }
+        invalidate(state, effects.getEffects(op));
+        if (auto storeOp = op->as<StoreOp>(); storeOp && !storeOp.offset())
+            (*state)[storeOp.dst()] = get(storeOp.valueToStore());
+        for (const auto &result : op->results)
+            set(result, LatticeValue::makeOverdefined());
+    }
+
+    // Terminators are visited by the operations owning the regions
+    void visitRegion(const Operation::Ptr &op, MemoryState &state) {
+        for (const auto &childOp : op->body) {
+            if (!state)
+                return;
+            if (!utils::isAny<ConditionOp, YieldOp, ConstantOp>(childOp))
+                visitOp(childOp, state);
+        }
+    }
+
+  public:
+    explicit ConstantsSolver(const MemoryEffectsAnalysis &effects) : effects{effects} {};
+
+    LatticeValue get(const Value::Ptr &value) const {
+        if (auto constOp = getValueOwnerAs<ConstantOp>(value))
+            return LatticeValue::makeConstant(constOp.value());
+        auto it = values.find(value);
+        return it != values.end() ? it->second : LatticeValue();
+    }
+
+    void solve(const Operation::Ptr &moduleOp) {
+        std::vector<FunctionOp> functions;
+        std::unordered_set<std::string> called;
+        std::vector<Operation::Ptr> worklist = {moduleOp};
+        while (!worklist.empty()) {
+            auto op = worklist.back();
+            worklist.pop_back();
+            if (auto funcOp = op->as<FunctionOp>())
+                functions.push_back(funcOp);
+            if (auto callOp = op->as<FunctionCallOp>())
+                called.insert(callOp.name());
+            worklist.insert(worklist.end(), op->body.begin(), op->body.end());
+        }
+        // Functions without calls are entry points and may receive any arguments
+        std::unordered_map<std::string, std::vector<LatticeValue>> arguments;
+        for (const auto &funcOp : functions) {
+            auto initial = called.contains(funcOp.name()) ? LatticeValue() : LatticeValue::makeOverdefined();
+            arguments[funcOp.name()].assign(funcOp->numInwards(), initial);
+        }
+        bool changed = true;
+        while (changed) {
+            values.clear();
+            callArguments.clear();
+            for (const auto &funcOp : functions) {
+                for (const auto &[inward, value] : utils::zip(funcOp->inwards, arguments[funcOp.name()]))
+                    set(inward, value);
+                MemoryState state{std::in_place};
+                visitRegion(funcOp, state);
+            }
+            changed = false;
+            for (const auto &funcOp : functions) {
+                auto it = callArguments.find(funcOp.name());
+                if (it == callArguments.end())
+                    continue;
+                auto &funcArguments = arguments[funcOp.name()];
+                for (size_t i = 0; i < funcArguments.size() && i < it->second.size(); i++) {
+                    auto joined = funcArguments[i];
+                    joined.join(it->second[i]);
+                    changed |= joined != funcArguments[i];
+                    funcArguments[i] = joined;
+                }
+            }
+        }
+    }
+};
+
+struct PropagateConditionalConstants : public Transform<ModuleOp> {
+    using Transform::Transform;
+
+    std::string_view name() const override {
+        return "PropagateConditionalConstants";
+    }
+
+    static bool isErasable(const Operation::Ptr &op) {
+        if (isConditionPredicate(op))
+            return false;
+        bool isUnused = std::ranges::all_of(op->results, [](const Value::Ptr &result) {
+            return result->uses.empty();
+        });
+        return isUnused &&
+               utils::isAny<ArithBinaryOp, ArithCastOp, ArithUnaryOp, LogicBinaryOp, LogicUnaryOp, LoadOp>(op);
+    }
+
+    static bool replaceWithConstant(const Value::Ptr &value, const ConstantsSolver &solver,
+                                    std::vector<Operation::Ptr> &inserted, OptBuilder &builder) {
+        auto lattice = solver.get(value);
+        if (!lattice.isConstant() || value->uses.empty() || getValueOwnerAs<ConstantOp>(value))
+            return false;
+        auto constOp = builder.insert<ConstantOp>(value->type, lattice.constant);
+        builder.replace(value, constOp.result());
+        inserted.push_back(constOp);
+        return true;
+    }
+
+    static void replaceValues(const Operation::Ptr &op, const ConstantsSolver &solver,
+                              std::vector<Operation::Ptr> &inserted, OptBuilder &builder) {
+        for (const auto &childOp : utils::advanceEarly(op->body)) {
+            builder.setInsertPointBefore(childOp);
+            // Inwards of the loops are defined before the first iteration
+            for (const auto &inward : childOp->inwards)
+                replaceWithConstant(inward, solver, inserted, builder);
+            bool replaced = false;
+            for (const auto &result : childOp->results)
+                replaced |= replaceWithConstant(result, solver, inserted, builder);
+            replaceValues(childOp, solver, inserted, builder);
+            if (replaced && isErasable(childOp))
+                builder.erase(childOp);
+        }
+    }
+
+    static void hoistBody(const Operation::Ptr &op, const Operation::Ptr &parentOp, OptBuilder &builder) {
+        builder.setInsertPointBefore(parentOp);
+        for (const auto &childOp : utils::advanceEarly(op->body)) {
+            if (childOp->is<YieldOp>()) {
+                for (const auto &[result, value] : utils::zip(parentOp->results, childOp->operands))
+                    builder.replace(result, value);
+                continue;
+            }
+            auto cloned = builder.clone(childOp);
+            builder.replace(childOp, cloned);
+            builder.setInsertPointAfter(cloned);
+        }
+    }
+
+    static void collectFoldable(const Operation::Ptr &op, const ConstantsSolver &solver,
+                                std::vector<Operation::Ptr> &foldable) {
+        for (const auto &childOp : op->body) {
+            collectFoldable(childOp, solver, foldable);
+            if (auto ifOp = childOp->as<IfOp>(); ifOp && solver.get(ifOp.cond()).isConstant()) {
+                foldable.push_back(childOp);
+            } else if (auto whileOp = childOp->as<WhileOp>()) {
+                auto cond = solver.get(whileOp.conditionOp().terminator());
+                if (cond.isConstant() && !cond.constant.as<NativeBool>())
+                    foldable.push_back(childOp);
+            } else if (auto forOp = childOp->as<ForOp>()) {
+                if (isEmptyRange(solver.get(forOp.start()), solver.get(forOp.stop())))
+                    foldable.push_back(childOp);
+            }
+        }
+    }
+
+    // Only the regions which are executed are kept, the operations are folded from the innermost ones
+    static void fold(const Operation::Ptr &op, const ConstantsSolver &solver, OptBuilder &builder) {
+        if (auto ifOp = op->as<IfOp>()) {
+            auto branchOp = solver.get(ifOp.cond()).constant.as<NativeBool>() ? ifOp.thenOp().op : ifOp.elseOp().op;
+            if (branchOp)
+                hoistBody(branchOp, op, builder);
+            builder.erase(op);
+            return;
+        }
+        size_t firstInit = op->is<ForOp>() ? ForOp::numControlOperands : 0U;
+        size_t firstCarried = op->is<ForOp>() ? 1U : 0U;
+        for (size_t i = firstInit; i < op->numOperands(); i++) {
+            builder.replace(op->inward(firstCarried + i - firstInit), op->operand(i));
+            builder.replace(op->result(i - firstInit), op->operand(i));
+        }
+        // Condition of the loop is evaluated once even if the body is never executed
+        if (auto whileOp = op->as<WhileOp>())
+            hoistBody(whileOp.conditionOp(), op, builder);
+        builder.erase(op);
+    }
+
+    // Operations following the return are never executed, which is usual after folding the branches
+    static void eraseUnreachable(const Operation::Ptr &op, OptBuilder &builder) {
+        auto returnIt = std::ranges::find_if(op->body, [](const Operation::Ptr &childOp) {
+            return childOp->is<ReturnOp>();
+        });
+        // Terminators passing values to the parent operation are kept for the verifier
+        if (returnIt != op->body.end() && !op->body.back()->is<YieldOp>())
+            while (op->body.back() != *returnIt)
+                builder.erase(op->body.back());
+        for (const auto &childOp : op->body)
+            eraseUnreachable(childOp, builder);
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        MemoryEffectsAnalysis effects(op);
+        ConstantsSolver solver(effects);
+        solver.solve(op);
+        std::vector<Operation::Ptr> inserted;
+        for (const auto &funcOp : op->body) {
+            if (funcOp->body.empty())
+                continue;
+            builder.setInsertPointBefore(funcOp->body.front());
+            for (const auto &inward : funcOp->inwards)
+                replaceWithConstant(inward, solver, inserted, builder);
+            replaceValues(funcOp, solver, inserted, builder);
+        }
+        std::vector<Operation::Ptr> foldable;
+        collectFoldable(op, solver, foldable);
+        for (const auto &foldableOp : foldable)
+            fold(foldableOp, solver, builder);
+        // Constants replacing the values which are folded themselves or used only in the erased regions
+        for (const auto &constOp : inserted)
+            if (!constOp->results.empty() && constOp->result(0)->uses.empty())
+                builder.erase(constOp);
+        eraseUnreachable(op, builder);
+    }
+
+    bool recurse() const override {
+        return false;
+    }
+};
+
+} // namespace
+
+namespace optree {
+namespace optimizer {
+
+BaseTransform::Ptr createPropagateConditionalConstants() {
+    return std::make_shared<PropagateConditionalConstants>();
+}
+
+} // namespace optimizer
+} // namespace optree
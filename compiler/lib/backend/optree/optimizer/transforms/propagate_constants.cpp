@@ -1,12 +1,13 @@
 #include "optimizer/transform.hpp"
 
+#include <algorithm>
 #include <deque>
 #include <memory>
-#include <set>
 #include <string_view>
 #include <unordered_map>
 
 #include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/memory_effects.hpp"
 #include "compiler/optree/operation.hpp"
 #include "compiler/optree/value.hpp"
 #include "compiler/utils/helpers.hpp"
@@ -20,11 +21,16 @@ namespace {
 
 struct Context {
 
-    Context(OptBuilder &builder) : builder{builder} {};
+    Context(OptBuilder &builder, const MemoryEffectsAnalysis &effects) : builder{builder}, effects{effects} {};
     using Scope = std::unordered_map<Value::Ptr, Value::Ptr>;
     using Scopes = std::deque<Scope>;
 
     void setValueAttribute(const StoreOp &op, bool invalidateDeps = true) {
+        // Only the first element of the memory is tracked, stores to the others only invalidate it
+        if (op.offset()) {
+            invalidate(getWritesForBlock(op));
+            return;
+        }
         auto storeValue = op.valueToStore();
         auto valueOwner = storeValue->owner.lock();
         auto dst = op.dst();
@@ -47,6 +53,8 @@ struct Context {
     }
 
     void replaceValue(const LoadOp &op) {
+        if (op.offset())
+            return;
         auto scr = op.src();
         Value::Ptr value = nullptr;
         for (const auto &scope : scopes) {
@@ -69,15 +77,24 @@ struct Context {
         }
     }
 
-    std::set<Value::Ptr> getStoresForBlock(const Operation::Ptr &op) {
-        std::set<Value::Ptr> stores;
-        for (const auto &child : op->body) {
-            if (auto storeOp = child->as<StoreOp>()) {
-                stores.emplace(storeOp.dst());
+    MemoryEffects getWritesForBlock(const Operation::Ptr &op) {
+        MemoryEffects writes;
+        for (const auto &effect : effects.getEffects(op))
+            if (effect.modifiesMemory())
+                writes.push_back(effect);
+        return writes;
+    }
+
+    void invalidate(const MemoryEffects &writes) {
+        for (auto &scope : scopes)
+            for (auto &[ptr, value] : scope) {
+                MemoryEffect read{MemoryEffectKind::Read, ptr, {}};
+                auto isClobbered = [&read](const MemoryEffect &write) {
+                    return alias(write, read) != AliasResult::NoAlias;
+                };
+                if (std::ranges::any_of(writes, isClobbered))
+                    value = nullptr;
             }
-            stores.merge(getStoresForBlock(child));
-        }
-        return stores;
     }
 
     void iterateThrowChildrens(const Operation::Ptr &op, bool invalidateDeps = true) {
@@ -89,6 +106,8 @@ struct Context {
             }
             if (auto loadOp = child->as<LoadOp>()) {
                 replaceValue(loadOp);
+            } else if (child->body.empty()) {
+                invalidate(getWritesForBlock(child));
             }
             traverseOps(child);
         }
@@ -100,23 +119,15 @@ struct Context {
             auto ifOp = op->as<IfOp>();
             auto thenOp = ifOp.thenOp();
             auto elseOp = ifOp.elseOp();
-            auto mergedValues = getStoresForBlock(thenOp);
-            mergedValues.merge(getStoresForBlock(elseOp));
+            auto writes = getWritesForBlock(op);
             iterateThrowChildrens(thenOp, false);
             iterateThrowChildrens(elseOp, false);
-            for (auto &scope : scopes)
-                for (const auto &value : mergedValues)
-                    if (auto it = scope.find(value); it != scope.end()) {
-                        it->second = nullptr;
-                    }
+            invalidate(writes);
         } else if (utils::isAny<ForOp, WhileOp>(op)) {
-            auto values = getStoresForBlock(op);
-            for (auto &scope : scopes)
-                for (const auto &value : values)
-                    if (auto it = scope.find(value); it != scope.end()) {
-                        it->second = nullptr;
-                    }
+            auto writes = getWritesForBlock(op);
+            invalidate(writes);
             iterateThrowChildrens(op, false);
+            invalidate(writes);
         } else if (utils::isAny<FunctionOp, IfOp, ThenOp, ConditionOp>(op)) {
             iterateThrowChildrens(op);
         }
@@ -124,6 +135,7 @@ struct Context {
 
     Scopes scopes;
     OptBuilder &builder;
+    const MemoryEffectsAnalysis &effects;
 };
 
 struct PropagateConstants : public Transform<FunctionOp> {
@@ -134,7 +146,8 @@ struct PropagateConstants : public Transform<FunctionOp> {
     }
 
     void run(const Operation::Ptr &op, OptBuilder &builder) const override {
-        Context propagationContext{builder};
+        MemoryEffectsAnalysis effects(op);
+        Context propagationContext{builder, effects};
         propagationContext.traverseOps(op);
     }
 };
@@ -0,0 +1,261 @@
+#include "optimizer/transform.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/attribute.hpp"
+#include "compiler/optree/definitions.hpp"
+#include "compiler/optree/helpers.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/types.hpp"
+#include "compiler/optree/value.hpp"
+#include "compiler/utils/language.hpp"
+
+#include "optimizer/opt_builder.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+namespace {
+
+// Constant arguments of a call, an empty element stands for an argument which is not a constant
+using ConstantArgs = std::vector<ConstantOp>;
+
+struct PropagateInterproceduralConstants : public Transform<ModuleOp> {
+    size_t sizeBudget;
+
+    // Specialization for a single call does not save anything compared to inlining it
+    static constexpr size_t minSpecializedCalls = 2U;
+
+    explicit PropagateInterproceduralConstants(size_t sizeBudget) : sizeBudget(sizeBudget){};
+    PropagateInterproceduralConstants(const PropagateInterproceduralConstants &) = default;
+    PropagateInterproceduralConstants(PropagateInterproceduralConstants &&) = default;
+    ~PropagateInterproceduralConstants() override = default;
+
+    std::string_view name() const override {
+        return "PropagateInterproceduralConstants";
+    }
+
+    bool recurse() const override {
+        return false;
+    }
+
+    using CallSites = std::unordered_map<std::string, std::vector<FunctionCallOp>>;
+
+    static void collectCalls(const Operation::Ptr &op, CallSites &calls) {
+        for (const auto &childOp : op->body) {
+            if (auto callOp = childOp->as<FunctionCallOp>())
+                calls[callOp.name()].push_back(callOp);
+            collectCalls(childOp, calls);
+        }
+    }
+
+    static size_t countOps(const Operation::Ptr &op) {
+        size_t count = 0;
+        for (const auto &childOp : op->body)
+            count += 1U + countOps(childOp);
+        return count;
+    }
+
+    static bool isSameConstant(const ConstantOp &lhs, const ConstantOp &rhs) {
+        return lhs && rhs && lhs.result()->sameType(rhs.result()) && sameAttribute(lhs.value(), rhs.value());
+    }
+
+    // Recursive calls passing a parameter through at the same position do not change its value
+    static bool isPassedThrough(const FunctionCallOp &callOp, const FunctionOp &funcOp, size_t index) {
+        return callOp->findParent<FunctionOp>().op == funcOp.op && callOp->operand(index) == funcOp->inward(index);
+    }
+
+    static ConstantArgs getConstantArgs(const FunctionCallOp &callOp) {
+        ConstantArgs args;
+        for (const auto &operand : callOp->operands)
+            args.push_back(operand->owner.lock()->as<ConstantOp>());
+        return args;
+    }
+
+    static void replaceInward(const FunctionOp &funcOp, size_t index, const ConstantOp &constOp, OptBuilder &builder) {
+        builder.setInsertPointBefore(funcOp->body.front());
+        auto cloned = builder.clone(constOp);
+        builder.replace(funcOp->inward(index), cloned->result(0));
+    }
+
+    // Parameters which take the same constant at all call sites are replaced with this constant
+    static void propagateConstants(const FunctionOp &funcOp, const std::vector<FunctionCallOp> &calls,
+                                   OptBuilder &builder) {
+        for (size_t i = 0; i < funcOp->numInwards(); i++) {
+            if (funcOp->inward(i)->uses.empty())
+                continue;
+            ConstantOp common;
+            bool isConstant = true;
+            for (const auto &callOp : calls) {
+                if (isPassedThrough(callOp, funcOp, i))
+                    continue;
+                auto constOp = callOp->operand(i)->owner.lock()->as<ConstantOp>();
+                if (!constOp || (common && !isSameConstant(common, constOp))) {
+                    isConstant = false;
+                    break;
+                }
+                common = constOp;
+            }
+            if (isConstant && common)
+                replaceInward(funcOp, i, common, builder);
+        }
+    }
+
+    static bool isSameKey(const ConstantArgs &lhs, const ConstantArgs &rhs) {
+        return std::ranges::equal(lhs, rhs, [](const ConstantOp &l, const ConstantOp &r) {
+            return (!l && !r) || isSameConstant(l, r);
+        });
+    }
+
+    static std::string uniqueName(const std::string &base, const ModuleOp &moduleOp) {
+        for (size_t i = 1;; i++) {
+            auto name = base + ".specialized." + std::to_string(i);
+            if (!moduleOp.lookup<FunctionOp>(name))
+                return name;
+        }
+    }
+
+    // Calls sharing the same tuple of constant arguments are redirected to a copy of the callee where these
+    // arguments are replaced with constants, the most frequent tuples are specialized first while the budget lasts
+    void specialize(const FunctionOp &funcOp, const std::vector<FunctionCallOp> &calls, const ModuleOp &moduleOp,
+                    size_t &budget, OptBuilder &builder) const {
+        std::vector<std::pair<ConstantArgs, std::vector<FunctionCallOp>>> groups;
+        for (const auto &callOp : calls) {
+            if (callOp->findParent<FunctionOp>().op == funcOp.op)
+                continue;
+            auto args = getConstantArgs(callOp);
+            for (size_t i = 0; i < args.size(); i++)
+                if (funcOp->inward(i)->uses.empty())
+                    args[i] = {};
+            if (std::ranges::none_of(args, [](const ConstantOp &constOp) { return bool(constOp); }))
+                continue;
+            auto it = std::ranges::find_if(groups, [&args](const auto &group) { return isSameKey(group.first, args); });
+            if (it == groups.end())
+                groups.emplace_back(std::move(args), std::vector<FunctionCallOp>{callOp});
+            else
+                it->second.push_back(callOp);
+        }
+        std::ranges::stable_sort(groups, std::ranges::greater{},
+                                 [](const auto &group) { return group.second.size(); });
+
+        size_t size = countOps(funcOp);
+        for (const auto &[args, groupCalls] : groups) {
+            if (groupCalls.size() < minSpecializedCalls || size > budget)
+                break;
+            budget -= size;
+            builder.setInsertPointAfter(funcOp);
+            auto specialized = builder.clone(funcOp)->as<FunctionOp>();
+            auto name = uniqueName(funcOp.name(), moduleOp);
+            builder.update(specialized, [&specialized, &name] { specialized.setName(name); });
+            for (size_t i = 0; i < args.size(); i++)
+                if (args[i])
+                    replaceInward(specialized, i, args[i], builder);
+            for (auto callOp : groupCalls)
+                builder.update(callOp, [&callOp, &name] { callOp.setName(name); });
+        }
+    }
+
+    static void updateType(const FunctionOp &funcOp, const Type::PtrVector &arguments, const Type::Ptr &result,
+                           OptBuilder &builder) {
+        builder.update(funcOp, [&] { funcOp->attr(1).set(Type::Ptr(Type::make<FunctionType>(arguments, result))); });
+    }
+
+    static void eraseUnusedParameters(const FunctionOp &funcOp, const std::vector<FunctionCallOp> &calls,
+                                      OptBuilder &builder) {
+        Type::PtrVector arguments = funcOp.type().arguments;
+        bool changed = false;
+        for (size_t i = funcOp->numInwards(); i-- > 0;) {
+            if (!funcOp->inward(i)->uses.empty())
+                continue;
+            builder.update(funcOp, [&funcOp, i] { funcOp->inwards.erase(funcOp->inwards.begin() + i); });
+            for (const auto &callOp : calls)
+                builder.update(callOp, [&callOp, i] { callOp->eraseOperand(i); });
+            arguments.erase(arguments.begin() + i);
+            changed = true;
+        }
+        if (changed)
+            updateType(funcOp, arguments, funcOp.type().result, builder);
+    }
+
+    static void collectReturns(const Operation::Ptr &op, std::vector<ReturnOp> &returns) {
+        for (const auto &childOp : op->body) {
+            if (auto returnOp = childOp->as<ReturnOp>())
+                returns.push_back(returnOp);
+            collectReturns(childOp, returns);
+        }
+    }
+
+    // Recursive calls do not make the result used, since they only forward it to the same unused result
+    static void eraseUnusedResult(const FunctionOp &funcOp, const std::vector<FunctionCallOp> &calls,
+                                  OptBuilder &builder) {
+        if (funcOp.type().result->is<NoneType>())
+            return;
+        std::vector<ReturnOp> returns;
+        collectReturns(funcOp, returns);
+        for (const auto &callOp : calls) {
+            for (const auto &use : callOp.result()->uses) {
+                auto user = use.lock();
+                if (!user->is<ReturnOp>() || user->findParent<FunctionOp>().op != funcOp.op)
+                    return;
+            }
+        }
+        for (const auto &returnOp : returns)
+            builder.update(returnOp, [&returnOp] { returnOp->eraseOperand(0); });
+        for (const auto &callOp : calls)
+            builder.update(callOp, [&callOp] { callOp.result()->type = TypeStorage::noneType(); });
+        updateType(funcOp, funcOp.type().arguments, TypeStorage::noneType(), builder);
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        auto moduleOp = op->as<ModuleOp>();
+        std::vector<FunctionOp> functions;
+        for (const auto &childOp : op->body)
+            if (auto funcOp = childOp->as<FunctionOp>(); funcOp && funcOp.name() != utils::language::funcMain)
+                functions.push_back(funcOp);
+
+        CallSites calls;
+        collectCalls(op, calls);
+        size_t budget = sizeBudget;
+        for (const auto &funcOp : functions) {
+            const auto &funcCalls = calls[funcOp.name()];
+            if (funcCalls.empty())
+                continue;
+            propagateConstants(funcOp, funcCalls, builder);
+            specialize(funcOp, funcCalls, moduleOp, budget, builder);
+        }
+
+        calls.clear();
+        collectCalls(op, calls);
+        for (const auto &childOp : op->body) {
+            auto funcOp = childOp->as<FunctionOp>();
+            if (!funcOp || funcOp.name() == utils::language::funcMain)
+                continue;
+            const auto &funcCalls = calls[funcOp.name()];
+            if (funcCalls.empty())
+                continue;
+            eraseUnusedParameters(funcOp, funcCalls, builder);
+            eraseUnusedResult(funcOp, funcCalls, builder);
+        }
+    }
+};
+
+} // namespace
+
+namespace optree {
+namespace optimizer {
+
+BaseTransform::Ptr createPropagateInterproceduralConstants(size_t sizeBudget) {
+    return std::make_shared<PropagateInterproceduralConstants>(sizeBudget);
+}
+
+} // namespace optimizer
+} // namespace optree
@@ -0,0 +1,280 @@
+#include "optimizer/transform.hpp"
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/attribute.hpp"
+#include "compiler/optree/definitions.hpp"
+#include "compiler/optree/evaluator.hpp"
+#include "compiler/optree/helpers.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/types.hpp"
+#include "compiler/optree/value.hpp"
+
+#include "optimizer/opt_builder.hpp"
+#include "optimizer/patterns.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+namespace {
+
+std::optional<NativeInt> intConstant(const Value::Ptr &value) {
+    auto constOp = getValueOwnerAs<ConstantOp>(value);
+    if (!constOp || !constOp.value().is<NativeInt>())
+        return std::nullopt;
+    return constOp.value().as<NativeInt>();
+}
+
+std::optional<NativeFloat> floatConstant(const Value::Ptr &value) {
+    auto constOp = getValueOwnerAs<ConstantOp>(value);
+    if (!constOp || !constOp.value().is<NativeFloat>())
+        return std::nullopt;
+    return constOp.value().as<NativeFloat>();
+}
+
+// Constants are combined with the wrapping arithmetic of the generated code, so that the overflow is not undefined
+NativeInt combine(ArithBinOpKind kind, NativeInt lhs, NativeInt rhs) {
+    return foldArithBinary(kind, Attribute(lhs), Attribute(rhs))->as<NativeInt>();
+}
+
+std::optional<NativeInt> exactLog2(NativeInt value) {
+    if (value <= 0 || !std::has_single_bit(static_cast<uint64_t>(value)))
+        return std::nullopt;
+    return std::countr_zero(static_cast<uint64_t>(value));
+}
+
+// The iterator of a loop starting from a non-negative value and going up never becomes negative
+bool isNonNegative(const Value::Ptr &value) {
+    if (auto constant = intConstant(value))
+        return *constant >= 0;
+    if (auto forOp = getValueOwnerAs<ForOp>(value); forOp && forOp.iterator() == value) {
+        auto step = intConstant(forOp.step());
+        return step && *step > 0 && isNonNegative(forOp.start());
+    }
+    if (auto binaryOp = getValueOwnerAs<ArithBinaryOp>(value)) {
+        auto rhs = intConstant(binaryOp.rhs());
+        if (binaryOp.kind() == ArithBinOpKind::DivI)
+            return rhs && *rhs > 0 && isNonNegative(binaryOp.lhs());
+        if (binaryOp.kind() == ArithBinOpKind::ShrI)
+            return isNonNegative(binaryOp.lhs());
+    }
+    return false;
+}
+
+struct ReduceStrength : public Transform<ArithBinaryOp, ArithUnaryOp, ForOp> {
+    using Transform::Transform;
+
+    std::string_view name() const override {
+        return "ReduceStrength";
+    }
+
+    static void replaceWith(const Operation::Ptr &op, const Value::Ptr &value, OptBuilder &builder) {
+        builder.replace(op->result(0), value);
+        builder.erase(op);
+    }
+
+    static void replaceWithBinary(const Operation::Ptr &op, ArithBinOpKind kind, const Value::Ptr &lhs,
+                                  const Value::Ptr &rhs, OptBuilder &builder) {
+        auto newOp = builder.insert<ArithBinaryOp>(op->ref, kind, lhs, rhs);
+        replaceWith(op, newOp.result(), builder);
+    }
+
+    static void replaceWithBinary(const Operation::Ptr &op, ArithBinOpKind kind, const Value::Ptr &lhs, NativeInt rhs,
+                                  OptBuilder &builder) {
+        auto constOp = builder.insert<ConstantOp>(op->ref, lhs->type, rhs);
+        replaceWithBinary(op, kind, lhs, constOp.result(), builder);
+    }
+
+    // Identities of a single operation, float ones hold for signed zeros, infinities and NaNs
+    static const patterns::RuleSet &rules() {
+        using namespace patterns;
+        using enum ArithBinOpKind;
+        constexpr Placeholder<0> x;
+        constexpr Placeholder<1> y;
+        static const RuleSet ruleSet(
+            m_Commuted(m_ArithBinary(AddI, m_Any(x), m_Const(0))) >> x,
+            m_Commuted(m_ArithBinary(AddI, m_Any(x), m_ArithUnary(ArithUnaryOpKind::NegI, m_Any(y)))) >>
+                r_ArithBinary(SubI, x, y),
+            m_ArithBinary(SubI, m_Any(x), m_Any(x)) >> r_Const(0),
+            m_ArithBinary(SubI, m_Any(x), m_Const(0)) >> x,
+            m_ArithBinary(SubI, m_Any(x), m_ArithUnary(ArithUnaryOpKind::NegI, m_Any(y))) >> r_ArithBinary(AddI, x, y),
+            m_Commuted(m_ArithBinary(MulI, m_Any(x), m_Const(0))) >> r_Const(0),
+            m_Commuted(m_ArithBinary(MulI, m_Any(x), m_Const(1))) >> x,
+            m_Commuted(m_ArithBinary(MulI, m_Any(x), m_Const(-1))) >> r_ArithUnary(ArithUnaryOpKind::NegI, x),
+            m_ArithBinary(DivI, m_Any(x), m_Const(1)) >> x,
+            m_ArithBinary(ShlI, m_Any(x), m_Const(0)) >> x,
+            m_ArithBinary(ShrI, m_Any(x), m_Const(0)) >> x,
+            m_Commuted(m_ArithBinary(AddF, m_Any(x), m_Const(-0.0))) >> x,
+            m_ArithBinary(SubF, m_Any(x), m_Const(0.0)) >> x,
+            m_Commuted(m_ArithBinary(MulF, m_Any(x), m_Const(1.0))) >> x,
+            m_Commuted(m_ArithBinary(MulF, m_Any(x), m_Const(-1.0))) >> r_ArithUnary(ArithUnaryOpKind::NegF, x),
+            m_ArithBinary(DivF, m_Any(x), m_Const(1.0)) >> x,
+            m_ArithUnary(ArithUnaryOpKind::NegI, m_ArithUnary(ArithUnaryOpKind::NegI, m_Any(x))) >> x,
+            m_ArithUnary(ArithUnaryOpKind::NegF, m_ArithUnary(ArithUnaryOpKind::NegF, m_Any(x))) >> x);
+        return ruleSet;
+    }
+
+    // Chains of operations with constants are reassociated to a single operation with the combined constant
+    static bool reassociate(const ArithBinaryOp &op, const Value::Ptr &lhs, NativeInt constant, OptBuilder &builder) {
+        auto innerOp = getValueOwnerAs<ArithBinaryOp>(lhs);
+        auto innerConstant = innerOp ? intConstant(innerOp.rhs()) : std::nullopt;
+        if (!innerConstant)
+            return false;
+        auto outerKind = op.kind();
+        auto innerKind = innerOp.kind();
+        if (outerKind == ArithBinOpKind::MulI) {
+            if (innerKind != ArithBinOpKind::MulI)
+                return false;
+            replaceWithBinary(op, ArithBinOpKind::MulI, innerOp.lhs(), combine(outerKind, *innerConstant, constant),
+                              builder);
+            return true;
+        }
+        if (innerKind != ArithBinOpKind::AddI && innerKind != ArithBinOpKind::SubI)
+            return false;
+        auto inner = innerKind == ArithBinOpKind::AddI ? *innerConstant : combine(innerKind, 0, *innerConstant);
+        auto sum = combine(outerKind, inner, constant);
+        replaceWithBinary(op, ArithBinOpKind::AddI, innerOp.lhs(), sum, builder);
+        return true;
+    }
+
+    // Reciprocals of powers of two are exact, unless they overflow
+    static void reduceFloatDivision(const ArithBinaryOp &op, OptBuilder &builder) {
+        auto constant = floatConstant(op.rhs());
+        int exponent;
+        if (!constant || std::frexp(*constant, &exponent) != 0.5 || !std::isnormal(1.0 / *constant))
+            return;
+        auto constOp = builder.insert<ConstantOp>(op->ref, op.rhs()->type, NativeFloat(1.0 / *constant));
+        replaceWithBinary(op, ArithBinOpKind::MulF, op.lhs(), constOp.result(), builder);
+    }
+
+    static void reduceBinary(const ArithBinaryOp &op, OptBuilder &builder) {
+        if (op.kind() == ArithBinOpKind::DivF) {
+            reduceFloatDivision(op, builder);
+            return;
+        }
+        // Constant operands of commutative operations are matched on the right
+        auto lhs = op.lhs();
+        auto rhs = op.rhs();
+        bool isCommutative = op.kind() == ArithBinOpKind::AddI || op.kind() == ArithBinOpKind::MulI;
+        if (isCommutative && intConstant(lhs) && !intConstant(rhs))
+            std::swap(lhs, rhs);
+        auto constant = intConstant(rhs);
+        if (!constant)
+            return;
+        switch (op.kind()) {
+        case ArithBinOpKind::AddI:
+        case ArithBinOpKind::SubI:
+            reassociate(op, lhs, *constant, builder);
+            return;
+        case ArithBinOpKind::MulI:
+            if (reassociate(op, lhs, *constant, builder))
+                return;
+            if (auto shift = exactLog2(*constant))
+                replaceWithBinary(op, ArithBinOpKind::ShlI, lhs, *shift, builder);
+            return;
+        case ArithBinOpKind::DivI:
+            // Signed division rounds towards zero, so only non-negative values are divided by shifting
+            if (auto shift = exactLog2(*constant); shift && isNonNegative(lhs))
+                replaceWithBinary(op, ArithBinOpKind::ShrI, lhs, *shift, builder);
+            return;
+        default:
+            return;
+        }
+    }
+
+    // Stride of the value computed as the iterator multiplied by a constant
+    static std::optional<NativeInt> iteratorStride(const Operation::Ptr &op, const Value::Ptr &iterator) {
+        auto binaryOp = op->as<ArithBinaryOp>();
+        if (!binaryOp)
+            return std::nullopt;
+        if (binaryOp.kind() == ArithBinOpKind::MulI) {
+            auto other = binaryOp.lhs() == iterator ? binaryOp.rhs() : binaryOp.lhs();
+            return intConstant(other);
+        }
+        if (binaryOp.kind() == ArithBinOpKind::ShlI && binaryOp.lhs() == iterator) {
+            auto shift = intConstant(binaryOp.rhs());
+            if (shift && *shift >= 0 && *shift < 63)
+                return NativeInt(1) << *shift;
+        }
+        return std::nullopt;
+    }
+
+    static Value::Ptr multiplied(const Operation::Ptr &loopOp, const Value::Ptr &value, NativeInt stride,
+                                 OptBuilder &builder) {
+        if (auto constant = intConstant(value)) {
+            auto product = combine(ArithBinOpKind::MulI, *constant, stride);
+            return builder.insert<ConstantOp>(loopOp->ref, value->type, product).result();
+        }
+        auto strideOp = builder.insert<ConstantOp>(loopOp->ref, value->type, stride);
+        return builder.insert<ArithBinaryOp>(loopOp->ref, ArithBinOpKind::MulI, value, strideOp.result()).result();
+    }
+
+    // Multiplications of the iterator by a constant are replaced with a loop-carried value incremented by the
+    // multiplied step on each iteration
+    static void reduceInductionVariables(const ForOp &op, OptBuilder &builder) {
+        auto iterator = op.iterator();
+        std::vector<Operation::Ptr> users;
+        for (const auto &use : iterator->uses)
+            users.push_back(use.lock());
+        std::map<NativeInt, Value::Ptr> carried;
+        for (const auto &user : users) {
+            auto stride = iteratorStride(user, iterator);
+            if (!stride)
+                continue;
+            auto it = carried.find(*stride);
+            if (it == carried.end()) {
+                builder.setInsertPointBefore(op);
+                auto init = multiplied(op, op.start(), *stride, builder);
+                auto increment = multiplied(op, op.step(), *stride, builder);
+                Value::Ptr inward;
+                builder.update(op, [&op, &init, &inward]() {
+                    op->addOperand(init);
+                    inward = op->addInward(init->type);
+                    op->addResult(init->type);
+                });
+                auto yieldOp = op.yieldOp();
+                if (yieldOp)
+                    builder.setInsertPointBefore(yieldOp);
+                else
+                    builder.setInsertPointAtBodyEnd(op);
+                auto next = builder.insert<ArithBinaryOp>(op->ref, ArithBinOpKind::AddI, inward, increment);
+                if (yieldOp)
+                    builder.update(yieldOp, [&yieldOp, &next]() { yieldOp->addOperand(next.result()); });
+                else
+                    builder.insert<YieldOp>(op->ref, std::vector<Value::Ptr>{next.result()});
+                it = carried.emplace(*stride, inward).first;
+            }
+            replaceWith(user, it->second, builder);
+        }
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        if (rules().apply(op, builder))
+            return;
+        if (auto binaryOp = op->as<ArithBinaryOp>())
+            reduceBinary(binaryOp, builder);
+        else if (auto forOp = op->as<ForOp>())
+            reduceInductionVariables(forOp, builder);
+    }
+};
+
+} // namespace
+
+namespace optree {
+namespace optimizer {
+
+BaseTransform::Ptr createReduceStrength() {
+    return std::make_shared<ReduceStrength>();
+}
+
+} // namespace optimizer
+} // namespace optree
@@ -50,7 +50,7 @@ struct ControlFlowSinkHelper {
 
     void sinkOperation(const Operation::Ptr &child) {
         uint32_t childPos = regionMap[child].id;
-        if (child->results.size() != 1)
+        if (child->results.size() != 1 || !child->body.empty())
             return;
         for (const auto &result : child->results) {
             std::vector<Region> usingIn;
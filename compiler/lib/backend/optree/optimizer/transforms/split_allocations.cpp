@@ -0,0 +1,110 @@
+#include "optimizer/transform.hpp"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/helpers.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/types.hpp"
+#include "compiler/optree/value.hpp"
+#include "compiler/utils/helpers.hpp"
+
+#include "optimizer/opt_builder.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+namespace {
+
+struct SplitAllocations : public Transform<AllocateOp> {
+    size_t maxElements;
+
+    explicit SplitAllocations(size_t maxElements) : maxElements(maxElements){};
+    SplitAllocations(const SplitAllocations &) = default;
+    SplitAllocations(SplitAllocations &&) = default;
+    ~SplitAllocations() override = default;
+
+    std::string_view name() const override {
+        return "SplitAllocations";
+    }
+
+    // Index of the element accessed by the load or store, the access without an offset is made to the first one
+    static std::optional<size_t> elementIndex(const Value::Ptr &offset, size_t numElements) {
+        if (!offset)
+            return 0U;
+        auto constOp = getValueOwnerAs<ConstantOp>(offset);
+        if (!constOp || !constOp.value().is<NativeInt>())
+            return std::nullopt;
+        auto index = constOp.value().as<NativeInt>();
+        if (index < 0 || static_cast<size_t>(index) >= numElements)
+            return std::nullopt;
+        return static_cast<size_t>(index);
+    }
+
+    // The list must not escape: it is only loaded from and stored to element by element at constant offsets
+    static bool collectAccesses(const AllocateOp &allocOp, std::vector<std::pair<Operation::Ptr, size_t>> &accesses) {
+        const auto &type = allocOp.result()->type->as<PointerType>();
+        for (const auto &use : allocOp.result()->uses) {
+            auto user = use.lock();
+            if (use.operandNumber != 0U)
+                return false;
+            std::optional<size_t> index;
+            if (auto loadOp = user->as<LoadOp>(); loadOp && *loadOp.result()->type == *type.pointee)
+                index = elementIndex(loadOp.offset(), type.numElements);
+            else if (auto storeOp = user->as<StoreOp>(); storeOp && *storeOp.valueToStore()->type == *type.pointee)
+                index = elementIndex(storeOp.offset(), type.numElements);
+            if (!index)
+                return false;
+            accesses.emplace_back(user, *index);
+        }
+        return true;
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        auto allocOp = op->as<AllocateOp>();
+        const auto &type = allocOp.result()->type->as<PointerType>();
+        if (allocOp.dynamicSize() || type.numElements < 2U || type.numElements > maxElements ||
+            !utils::isAny<IntegerType, FloatType>(type.pointee))
+            return;
+        std::vector<std::pair<Operation::Ptr, size_t>> accesses;
+        if (!collectAccesses(allocOp, accesses))
+            return;
+
+        // Only the accessed elements get allocations, which are created in the order of the elements
+        std::map<size_t, Value::Ptr> elements;
+        for (const auto &[accessOp, index] : accesses)
+            elements[index] = nullptr;
+        builder.setInsertPointBefore(allocOp);
+        auto elementType = Type::make<PointerType>(type.pointee);
+        for (auto &[index, ptr] : elements)
+            ptr = builder.insert<AllocateOp>(allocOp->ref, elementType).result();
+
+        for (const auto &[accessOp, index] : accesses) {
+            const auto &ptr = elements[index];
+            builder.setInsertPointBefore(accessOp);
+            if (accessOp->is<LoadOp>())
+                builder.replace(accessOp, builder.insert<LoadOp>(accessOp->ref, ptr));
+            else
+                builder.replace(accessOp, builder.insert<StoreOp>(accessOp->ref, ptr, accessOp->operand(1)));
+        }
+        builder.erase(allocOp);
+    }
+};
+
+} // namespace
+
+namespace optree {
+namespace optimizer {
+
+BaseTransform::Ptr createSplitAllocations(size_t maxElements) {
+    return std::make_shared<SplitAllocations>(maxElements);
+}
+
+} // namespace optimizer
+} // namespace optree
@@ -0,0 +1,200 @@
+#include "optimizer/transform.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/definitions.hpp"
+#include "compiler/optree/helpers.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/profile.hpp"
+#include "compiler/optree/value.hpp"
+#include "compiler/utils/helpers.hpp"
+
+#include "optimizer/opt_builder.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+namespace {
+
+struct UnrollLoops : public Transform<ForOp> {
+    size_t factor;
+    size_t sizeThreshold;
+
+    UnrollLoops(size_t factor, size_t sizeThreshold) : factor(factor), sizeThreshold(sizeThreshold){};
+    UnrollLoops(const UnrollLoops &) = default;
+    UnrollLoops(UnrollLoops &&) = default;
+    ~UnrollLoops() override = default;
+
+    std::string_view name() const override {
+        return "UnrollLoops";
+    }
+
+    using Values = std::vector<Value::Ptr>;
+
+    static std::optional<NativeInt> constantValue(const Value::Ptr &value) {
+        auto constOp = getValueOwnerAs<ConstantOp>(value);
+        if (!constOp || !constOp.value().is<NativeInt>())
+            return std::nullopt;
+        return constOp.value().as<NativeInt>();
+    }
+
+    static size_t countOps(const Operation::Ptr &op) {
+        size_t count = 0;
+        for (const auto &childOp : op->body)
+            count += (childOp->is<YieldOp>() ? 0U : 1U) + countOps(childOp);
+        return count;
+    }
+
+    static bool containsReturn(const Operation::Ptr &op) {
+        for (const auto &childOp : op->body)
+            if (childOp->is<ReturnOp>() || containsReturn(childOp))
+                return true;
+        return false;
+    }
+
+    static Values carriedInits(const ForOp &forOp) {
+        return Values(std::next(forOp->operands.begin(), ForOp::numControlOperands), forOp->operands.end());
+    }
+
+    // Copies the loop body before the insertion point, returns the values yielded to the next iteration
+    static Values cloneIteration(const ForOp &forOp, const Value::Ptr &iterator, const Values &carried,
+                                 OptBuilder &builder) {
+        auto copy = forOp->clone();
+        builder.replace(copy->inward(0), iterator);
+        for (size_t i = 0; i < carried.size(); i++)
+            builder.replace(copy->inward(i + 1U), carried[i]);
+        Values next = carried;
+        for (const auto &childOp : utils::advanceEarly(copy->body)) {
+            if (childOp->is<YieldOp>()) {
+                next = childOp->operands;
+                continue;
+            }
+            auto cloned = builder.clone(childOp);
+            builder.replace(childOp, cloned);
+            builder.setInsertPointAfter(cloned);
+        }
+        // The copy has never been inserted, erasing it through the builder would move the insertion point into it
+        copy->erase();
+        return next;
+    }
+
+    static Value::Ptr insertIterator(const ForOp &forOp, NativeInt value, OptBuilder &builder) {
+        return builder.insert<ConstantOp>(forOp->ref, forOp.iterator()->type, value).result();
+    }
+
+    static void finish(const ForOp &forOp, const Values &results, OptBuilder &builder) {
+        for (const auto &[result, value] : utils::zip(forOp->results, results))
+            builder.replace(result, value);
+        builder.erase(forOp);
+    }
+
+    // Iterator of the given iteration is computed with wrapping, since the distance from the start may not fit
+    static NativeInt iteratorValue(NativeInt start, NativeInt step, uint64_t iteration) {
+        return static_cast<NativeInt>(static_cast<uint64_t>(start) + iteration * static_cast<uint64_t>(step));
+    }
+
+    static void unrollFully(const ForOp &forOp, NativeInt start, NativeInt step, uint64_t tripCount,
+                            OptBuilder &builder) {
+        builder.setInsertPointBefore(forOp);
+        auto carried = carriedInits(forOp);
+        for (uint64_t i = 0; i < tripCount; i++)
+            carried = cloneIteration(forOp, insertIterator(forOp, iteratorValue(start, step, i), builder), carried,
+                                     builder);
+        finish(forOp, carried, builder);
+    }
+
+    void unrollPartially(const ForOp &forOp, NativeInt start, NativeInt step, uint64_t tripCount,
+                         OptBuilder &builder) const {
+        auto unrolledFactor = static_cast<NativeInt>(factor);
+        uint64_t unrolledTripCount = tripCount - tripCount % factor;
+        NativeInt unrolledStop = iteratorValue(start, step, unrolledTripCount);
+        const auto &type = forOp.iterator()->type;
+        builder.setInsertPointBefore(forOp);
+        auto stopOp = builder.insert<ConstantOp>(forOp->ref, type, unrolledStop);
+        auto stepOp = builder.insert<ConstantOp>(forOp->ref, type, step * unrolledFactor);
+        auto unrolledOp = builder.insert<ForOp>(forOp->ref, type, forOp.start(), stopOp.result(), stepOp.result());
+        Values carried;
+        builder.update(unrolledOp, [&] {
+            for (const auto &init : carriedInits(forOp)) {
+                unrolledOp->addOperand(init);
+                carried.push_back(unrolledOp->addInward(init->type));
+            }
+        });
+
+        builder.setInsertPointAtBodyEnd(unrolledOp);
+        carried = cloneIteration(forOp, unrolledOp.iterator(), carried, builder);
+        for (NativeInt i = 1; i < unrolledFactor; i++) {
+            auto offsetOp = builder.insert<ConstantOp>(forOp->ref, type, i * step);
+            auto iterator = builder.insert<ArithBinaryOp>(forOp->ref, ArithBinOpKind::AddI, unrolledOp.iterator(),
+                                                          offsetOp.result());
+            carried = cloneIteration(forOp, iterator.result(), carried, builder);
+        }
+        if (!carried.empty()) {
+            builder.insert<YieldOp>(forOp->ref, carried);
+            builder.update(unrolledOp, [&] {
+                carried.clear();
+                for (const auto &result : forOp->results)
+                    carried.push_back(unrolledOp->addResult(result->type));
+            });
+        }
+
+        // The remaining iterations are fewer than the unroll factor, so they are not worth a separate loop
+        builder.setInsertPointAfter(unrolledOp);
+        for (uint64_t i = unrolledTripCount; i < tripCount; i++)
+            carried = cloneIteration(forOp, insertIterator(forOp, iteratorValue(start, step, i), builder), carried,
+                                     builder);
+        finish(forOp, carried, builder);
+    }
+
+    // Loops never entered by the profiled run are cold, unrolling them would only grow the code
+    static bool isCold(const ForOp &forOp) {
+        auto counts = getProfileCounts(forOp);
+        return !counts.empty() && counts.front() == 0;
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        auto forOp = op->as<ForOp>();
+        auto start = constantValue(forOp.start());
+        auto stop = constantValue(forOp.stop());
+        auto step = constantValue(forOp.step());
+        if (!start || !stop || !step || *step <= 0 || containsReturn(op) || isCold(forOp))
+            return;
+        auto distance = static_cast<uint64_t>(*stop) - static_cast<uint64_t>(*start);
+        uint64_t tripCount = *stop > *start ? (distance - 1U) / static_cast<uint64_t>(*step) + 1U : 0U;
+        // Each unrolled iteration takes at least the constant of the iterator
+        size_t size = std::max<size_t>(countOps(op), 1U);
+        if (tripCount <= sizeThreshold / size) {
+            unrollFully(forOp, *start, *step, tripCount, builder);
+            return;
+        }
+        if (factor <= 1U || factor > sizeThreshold / size)
+            return;
+        // The unrolled loop stops at the iterator following the last iteration and advances by the unrolled step
+        constexpr auto maxValue = std::numeric_limits<NativeInt>::max();
+        NativeInt lastIterator = iteratorValue(*start, *step, tripCount - 1U);
+        if (lastIterator > maxValue - *step || *step > maxValue / static_cast<NativeInt>(factor))
+            return;
+        unrollPartially(forOp, *start, *step, tripCount, builder);
+    }
+};
+
+} // namespace
+
+namespace optree {
+namespace optimizer {
+
+BaseTransform::Ptr createUnrollLoops(size_t factor, size_t sizeThreshold) {
+    return std::make_shared<UnrollLoops>(factor, sizeThreshold);
+}
+
+} // namespace optimizer
+} // namespace optree
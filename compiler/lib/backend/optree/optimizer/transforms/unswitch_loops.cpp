@@ -0,0 +1,157 @@
+#include "optimizer/transform.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/helpers.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/types.hpp"
+#include "compiler/optree/value.hpp"
+#include "compiler/utils/helpers.hpp"
+
+#include "optimizer/opt_builder.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+namespace {
+
+struct UnswitchLoops : public Transform<WhileOp, ForOp> {
+    size_t sizeBudget;
+
+    explicit UnswitchLoops(size_t sizeBudget) : sizeBudget(sizeBudget){};
+    UnswitchLoops(const UnswitchLoops &) = default;
+    UnswitchLoops(UnswitchLoops &&) = default;
+    ~UnswitchLoops() override = default;
+
+    std::string_view name() const override {
+        return "UnswitchLoops";
+    }
+
+    using LoopValues = std::unordered_set<Value::Ptr>;
+
+    static void collectValues(const Operation::Ptr &op, LoopValues &values) {
+        values.insert(op->inwards.begin(), op->inwards.end());
+        for (const auto &childOp : op->body) {
+            values.insert(childOp->results.begin(), childOp->results.end());
+            collectValues(childOp, values);
+        }
+    }
+
+    static size_t countOps(const Operation::Ptr &op) {
+        size_t count = 0;
+        for (const auto &childOp : op->body)
+            count += 1U + countOps(childOp);
+        return count;
+    }
+
+    // Nested loops are unswitched before the outer one, so the branches hoisted out of them are found here as well
+    static IfOp findInvariantBranch(const Operation::Ptr &op, const LoopValues &values) {
+        for (const auto &childOp : op->body) {
+            if (utils::isAny<ForOp, WhileOp>(childOp))
+                continue;
+            if (auto ifOp = childOp->as<IfOp>(); ifOp && !values.contains(ifOp.cond()) &&
+                                                 !getValueOwnerAs<ConstantOp>(ifOp.cond()))
+                return ifOp;
+            if (auto ifOp = findInvariantBranch(childOp, values))
+                return ifOp;
+        }
+        return {};
+    }
+
+    // Positions of the operation in the bodies of its parents up to the loop, so it can be found in the loop copies
+    static std::vector<size_t> getPath(const Operation::Ptr &op, const Operation::Ptr &loopOp) {
+        std::vector<size_t> path;
+        for (auto childOp = op; childOp != loopOp; childOp = childOp->parent)
+            path.push_back(static_cast<size_t>(std::distance(childOp->parent->body.begin(), childOp->position)));
+        return path;
+    }
+
+    static Operation::Ptr followPath(const Operation::Ptr &loopOp, const std::vector<size_t> &path) {
+        auto op = loopOp;
+        for (auto it = path.rbegin(); it != path.rend(); ++it)
+            op = *std::next(op->body.begin(), static_cast<std::ptrdiff_t>(*it));
+        return op;
+    }
+
+    // The branch taken for the known condition replaces the whole IfOp, as in FoldControlFlowOps
+    static void foldBranch(const IfOp &ifOp, bool condition, OptBuilder &builder) {
+        Operation::Ptr branchOp = condition ? ifOp.thenOp().op : ifOp.elseOp().op;
+        if (branchOp) {
+            builder.setInsertPointBefore(ifOp);
+            for (const auto &childOp : utils::advanceEarly(branchOp->body)) {
+                if (childOp->is<YieldOp>()) {
+                    for (const auto &[result, value] : utils::zip(ifOp->results, childOp->operands))
+                        builder.replace(result, value);
+                    continue;
+                }
+                auto cloned = builder.clone(childOp);
+                builder.replace(childOp, cloned);
+                builder.setInsertPointAfter(cloned);
+            }
+        }
+        builder.erase(ifOp);
+    }
+
+    static Operation::Ptr cloneLoop(const Operation::Ptr &loopOp, const std::vector<size_t> &path, bool condition,
+                                    OptBuilder &builder) {
+        auto clonedOp = builder.clone(loopOp);
+        if (!loopOp->results.empty()) {
+            builder.insert<YieldOp>(loopOp->ref,
+                                    std::vector<Value::Ptr>(clonedOp->results.begin(), clonedOp->results.end()));
+        }
+        foldBranch(followPath(clonedOp, path)->as<IfOp>(), condition, builder);
+        return clonedOp;
+    }
+
+    // Every unswitching duplicates the loop, the rest of the budget is shared by the copies for other conditions
+    static void unswitch(const Operation::Ptr &loopOp, size_t budget, OptBuilder &builder) {
+        size_t size = countOps(loopOp);
+        if (size > budget)
+            return;
+        LoopValues values;
+        collectValues(loopOp, values);
+        auto ifOp = findInvariantBranch(loopOp, values);
+        if (!ifOp)
+            return;
+
+        const auto &ref = loopOp->ref;
+        auto path = getPath(ifOp, loopOp);
+        builder.setInsertPointBefore(loopOp);
+        auto outerOp = builder.insert<IfOp>(ref, ifOp.cond(), true);
+        builder.update(outerOp, [&outerOp, &loopOp] {
+            for (const auto &result : loopOp->results)
+                outerOp->addResult(result->type);
+        });
+        builder.setInsertPointAtBodyEnd(outerOp.thenOp());
+        auto thenLoopOp = cloneLoop(loopOp, path, true, builder);
+        builder.setInsertPointAtBodyEnd(outerOp.elseOp());
+        auto elseLoopOp = cloneLoop(loopOp, path, false, builder);
+        builder.replace(loopOp, outerOp);
+
+        size_t remaining = (budget - size) / 2U;
+        unswitch(thenLoopOp, remaining, builder);
+        unswitch(elseLoopOp, remaining, builder);
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        unswitch(op, sizeBudget, builder);
+    }
+};
+
+} // namespace
+
+namespace optree {
+namespace optimizer {
+
+BaseTransform::Ptr createUnswitchLoops(size_t sizeBudget) {
+    return std::make_shared<UnswitchLoops>(sizeBudget);
+}
+
+} // namespace optimizer
+} // namespace optree
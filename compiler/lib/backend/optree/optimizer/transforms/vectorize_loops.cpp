@@ -0,0 +1,195 @@
+#include "optimizer/transform.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/definitions.hpp"
+#include "compiler/optree/helpers.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/types.hpp"
+#include "compiler/optree/value.hpp"
+
+#include "optimizer/opt_builder.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+namespace {
+
+struct VectorizeLoops : public Transform<ForOp> {
+    unsigned vectorBits;
+
+    explicit VectorizeLoops(unsigned vectorBits) : vectorBits(vectorBits){};
+    VectorizeLoops(const VectorizeLoops &) = default;
+    VectorizeLoops(VectorizeLoops &&) = default;
+    ~VectorizeLoops() override = default;
+
+    std::string_view name() const override {
+        return "VectorizeLoops";
+    }
+
+    using ValueMapping = std::unordered_map<Value::Ptr, Value::Ptr>;
+
+    static std::optional<NativeInt> constantValue(const Value::Ptr &value) {
+        auto constOp = getValueOwnerAs<ConstantOp>(value);
+        if (!constOp || !constOp.value().is<NativeInt>())
+            return std::nullopt;
+        return constOp.value().as<NativeInt>();
+    }
+
+    static bool isElementType(const Type::Ptr &type) {
+        bool isNumeric = (type->is<IntegerType>() && !type->is<BoolType>()) || type->is<FloatType>();
+        return isNumeric && type->bitWidth() == 64U;
+    }
+
+    static bool isElementwise(ArithBinOpKind kind) {
+        switch (kind) {
+        case ArithBinOpKind::AddI:
+        case ArithBinOpKind::SubI:
+        case ArithBinOpKind::MulI:
+        case ArithBinOpKind::ShlI:
+        case ArithBinOpKind::ShrI:
+        case ArithBinOpKind::AddF:
+        case ArithBinOpKind::SubF:
+        case ArithBinOpKind::MulF:
+        case ArithBinOpKind::DivF:
+            return true;
+        default:
+            // Integer division traps on zero, so it cannot be executed for the lanes in one go
+            return false;
+        }
+    }
+
+    static bool isDefinedOutside(const Value::Ptr &value, const Operation::Ptr &loopOp) {
+        auto owner = value->owner.lock();
+        for (auto op = owner; op; op = op->parent)
+            if (op == loopOp)
+                return false;
+        return true;
+    }
+
+    // Every memory access of the iteration is made by the iterator itself, so the iterations are independent,
+    // and a lane of the vectorized iteration touches the same elements in the same order as the original one
+    static bool isVectorizable(const ForOp &forOp) {
+        const auto &iterator = forOp.iterator();
+        if (!forOp->results.empty() || forOp->numInwards() != 1U || constantValue(forOp.step()) != 1 ||
+            !isElementType(iterator->type))
+            return false;
+        auto isOffset = [&forOp](const Value::Ptr &value, const Value::Ptr &ptr) {
+            return value == forOp.iterator() && isDefinedOutside(ptr, forOp);
+        };
+        // Invariant values are broadcast to the lanes, which is possible only for constants for now
+        auto isLaneValue = [&forOp, &iterator](const Value::Ptr &value) {
+            return value != iterator && (!isDefinedOutside(value, forOp) || getValueOwnerAs<ConstantOp>(value));
+        };
+        bool hasStores = false;
+        for (const auto &op : forOp->body) {
+            if (!op->body.empty())
+                return false;
+            if (auto loadOp = op->as<LoadOp>()) {
+                if (!isOffset(loadOp.offset(), loadOp.src()) || !isElementType(loadOp.result()->type))
+                    return false;
+            } else if (auto storeOp = op->as<StoreOp>()) {
+                const auto &value = storeOp.valueToStore();
+                if (!isOffset(storeOp.offset(), storeOp.dst()) || !isElementType(value->type) || !isLaneValue(value))
+                    return false;
+                hasStores = true;
+            } else if (auto binaryOp = op->as<ArithBinaryOp>()) {
+                if (!isElementwise(binaryOp.kind()) || !isElementType(binaryOp.result()->type) ||
+                    !isLaneValue(binaryOp.lhs()) || !isLaneValue(binaryOp.rhs()))
+                    return false;
+            } else if (auto constOp = op->as<ConstantOp>()) {
+                if (!isElementType(constOp.result()->type))
+                    return false;
+            } else {
+                return false;
+            }
+        }
+        return hasStores;
+    }
+
+    Type::Ptr vectorType(const Type::Ptr &element) const {
+        return Type::make<VectorType>(element, vectorBits / element->bitWidth());
+    }
+
+    Value::Ptr vectorOperand(const Value::Ptr &value, const ValueMapping &mapping, const utils::SourceRef &ref,
+                             OptBuilder &builder) const {
+        if (auto it = mapping.find(value); it != mapping.end())
+            return it->second;
+        auto constOp = getValueOwnerAs<ConstantOp>(value);
+        return builder.insert<ConstantOp>(ref, vectorType(value->type), constOp.value()).result();
+    }
+
+    // Stop of the vectorized loop, so the number of its iterations is multiple of the number of lanes
+    static Value::Ptr vectorStop(const ForOp &forOp, NativeInt numLanes, OptBuilder &builder) {
+        const auto &type = forOp.iterator()->type;
+        const auto &ref = forOp->ref;
+        auto start = constantValue(forOp.start());
+        auto stop = constantValue(forOp.stop());
+        if (start && stop)
+            return builder.insert<ConstantOp>(ref, type, *start + (*stop - *start) / numLanes * numLanes).result();
+        auto lanesOp = builder.insert<ConstantOp>(ref, type, numLanes);
+        auto tripOp = builder.insert<ArithBinaryOp>(ref, ArithBinOpKind::SubI, forOp.stop(), forOp.start());
+        auto divOp = builder.insert<ArithBinaryOp>(ref, ArithBinOpKind::DivI, tripOp.result(), lanesOp.result());
+        auto mulOp = builder.insert<ArithBinaryOp>(ref, ArithBinOpKind::MulI, divOp.result(), lanesOp.result());
+        return builder.insert<ArithBinaryOp>(ref, ArithBinOpKind::AddI, forOp.start(), mulOp.result()).result();
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        auto forOp = op->as<ForOp>();
+        auto numLanes = static_cast<NativeInt>(vectorBits / forOp.iterator()->type->bitWidth());
+        if (numLanes < 2 || !isVectorizable(forOp))
+            return;
+        auto start = constantValue(forOp.start());
+        auto stop = constantValue(forOp.stop());
+        if (start && stop && *stop - *start < numLanes)
+            return;
+
+        const auto &type = forOp.iterator()->type;
+        builder.setInsertPointBefore(forOp);
+        auto stopValue = vectorStop(forOp, numLanes, builder);
+        auto stepOp = builder.insert<ConstantOp>(forOp->ref, type, numLanes);
+        auto vectorOp = builder.insert<ForOp>(forOp->ref, type, forOp.start(), stopValue, stepOp.result());
+        builder.setInsertPointAtBodyEnd(vectorOp);
+        ValueMapping mapping;
+        for (const auto &childOp : forOp->body) {
+            const auto &ref = childOp->ref;
+            if (auto loadOp = childOp->as<LoadOp>()) {
+                auto resultType = vectorType(loadOp.result()->type);
+                auto vectorLoad = builder.insert<LoadOp>(ref, resultType, loadOp.src(), vectorOp.iterator());
+                mapping[loadOp.result()] = vectorLoad.result();
+            } else if (auto storeOp = childOp->as<StoreOp>()) {
+                auto value = vectorOperand(storeOp.valueToStore(), mapping, ref, builder);
+                builder.insert<StoreOp>(ref, storeOp.dst(), value, vectorOp.iterator());
+            } else if (auto binaryOp = childOp->as<ArithBinaryOp>()) {
+                auto lhs = vectorOperand(binaryOp.lhs(), mapping, ref, builder);
+                auto rhs = vectorOperand(binaryOp.rhs(), mapping, ref, builder);
+                auto resultType = vectorType(binaryOp.result()->type);
+                auto vectorBinary = builder.insert<ArithBinaryOp>(ref, binaryOp.kind(), resultType, lhs, rhs);
+                mapping[binaryOp.result()] = vectorBinary.result();
+            } else if (auto constOp = childOp->as<ConstantOp>()) {
+                auto resultType = vectorType(constOp.result()->type);
+                mapping[constOp.result()] = builder.insert<ConstantOp>(ref, resultType, constOp.value()).result();
+            }
+        }
+
+        // The original loop remains as an epilogue for the iterations not covered by the vectorized loop
+        builder.update(forOp, [&] { forOp->setOperand(0, stopValue); });
+    }
+};
+
+} // namespace
+
+namespace optree {
+namespace optimizer {
+
+BaseTransform::Ptr createVectorizeLoops(unsigned vectorBits) {
+    return std::make_shared<VectorizeLoops>(vectorBits);
+}
+
+} // namespace optimizer
+} // namespace optree
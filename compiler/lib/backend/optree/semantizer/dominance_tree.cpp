@@ -51,7 +51,7 @@ void DominanceTree::dump(std::ostream &str) const {
 
 void DominanceTree::traverseOp(Node *parent, const Operation::Ptr &op) {
     bool isSSAOp = true;
-    if (utils::isAny<ModuleOp, IfOp>(op))
+    if (utils::isAny<ModuleOp, IfOp, SwitchOp>(op))
         isSSAOp = false;
     traverseOpImpl(parent, op, isSSAOp);
 }
@@ -5,14 +5,18 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_set>
+#include <vector>
 
 #include "compiler/optree/adaptors.hpp"
 #include "compiler/optree/definitions.hpp"
 #include "compiler/optree/operation.hpp"
+#include "compiler/optree/profile.hpp"
 #include "compiler/optree/program.hpp"
 #include "compiler/optree/types.hpp"
 #include "compiler/optree/value.hpp"
 #include "compiler/utils/debug.hpp"
+#include "compiler/utils/helpers.hpp"
 
 #include "semantizer/dominance_tree.hpp"
 #include "semantizer/semantizer_context.hpp"
@@ -54,6 +58,30 @@ std::optional<Type::Ptr> valuesHaveSameType(ValueRange &&values) {
 
 bool verify(const Operation::Ptr &op, SemantizerContext &ctx);
 
+// Region producing values for results of the parent operation must be terminated by YieldOp of the result types
+template <typename TypeRange>
+bool verifyYield(const Operation::Ptr &region, TypeRange &&types, SemantizerContext &ctx) {
+    if (std::empty(types) && (region->body.empty() || !region->body.back()->is<YieldOp>()))
+        return true;
+    if (region->body.empty() || !region->body.back()->is<YieldOp>()) {
+        ctx.pushOpError(region) << "must have YieldOp as last operation within body";
+        return false;
+    }
+    if (!valuesHaveTypes(region->body.back()->operands, types)) {
+        ctx.pushOpError(region->body.back()) << "must have operands with types of results of parent operation";
+        return false;
+    }
+    return true;
+}
+
+std::vector<Type::Ptr> valueTypes(const std::vector<Value::Ptr> &values) {
+    std::vector<Type::Ptr> types;
+    types.reserve(values.size());
+    for (const auto &value : values)
+        types.push_back(value->type);
+    return types;
+}
+
 bool verify(const Operation::Body &body, SemantizerContext &ctx) {
     bool verified = true;
     for (const auto &op : body)
@@ -72,11 +100,21 @@ VERIFY(ModuleOp, op, ctx, verifier) {
 }
 
 VERIFY(FunctionOp, op, ctx, verifier) {
+    if (op->numAttrs() < FunctionOp::numRequiredAttrs) {
+        ctx.pushOpError(op) << "must have at least " << FunctionOp::numRequiredAttrs << " attributes";
+        return false;
+    }
     verifier.verify<HasOperands>(0)
         .verify<HasResults>(0)
-        .verify<HasAttributes>(2)
         .verify<HasNthAttrOfType<std::string>>(0)
         .verify<HasNthAttrOfType<FunctionType>>(1);
+    for (size_t i = FunctionOp::numRequiredAttrs; i < op->numAttrs(); i++)
+        if (!op->attr(i).is<NativeInt>())
+            verifier.verify<HasNthAttrOfType<std::string>>(i);
+    if (getProfileCounts(op).size() > 1U) {
+        ctx.pushOpError(op) << "must have at most one profile count";
+        return false;
+    }
     RETURN_ON_FAILURE(verifier);
     ctx.functions[op.name()] = op;
     const auto &argTypes = op.type().arguments;
@@ -246,6 +284,28 @@ VERIFY(AllocateOp, op, ctx, verifier) {
     return false;
 }
 
+VERIFY(HeapAllocateOp, op, ctx, verifier) {
+    verifier.verify<HasResults>(1).verify<HasInwards>(0).verify<HasAttributes>(0);
+    RETURN_ON_FAILURE(verifier);
+    if (op->numOperands() > 1U) {
+        ctx.pushOpError(op) << "must have at most one operand";
+        return false;
+    }
+    if (op.result()->type->is<PointerType>())
+        return true;
+    ctx.pushOpError(op) << "must have pointer result";
+    return false;
+}
+
+VERIFY(DeallocateOp, op, ctx, verifier) {
+    verifier.verify<HasOperands>(1).verify<HasResults>(0).verify<HasInwards>(0).verify<HasAttributes>(0);
+    RETURN_ON_FAILURE(verifier);
+    if (op.ptr()->owner.lock()->is<HeapAllocateOp>())
+        return true;
+    ctx.pushOpError(op) << "must have operand allocated on the heap";
+    return false;
+}
+
 VERIFY(LoadOp, op, ctx, verifier) {
     verifier.verify<HasOperands>(1).verify<HasResults>(1).verify<HasInwards>(0).verify<HasAttributes>(0);
     RETURN_ON_FAILURE(verifier);
@@ -266,15 +326,16 @@ VERIFY(StoreOp, op, ctx, verifier) {
 
 VERIFY(IfOp, op, ctx, verifier) {
     verifier.verify<HasOperandsOfType>(1, TypeStorage::boolType())
-        .verify<HasResults>(0)
         .verify<HasInwards>(0)
-        .verify<HasAttributes>(0);
+        .verify<HasOptionalProfileCounts>(2);
     RETURN_ON_FAILURE(verifier);
+    auto resultTypes = valueTypes(op->results);
     if (op->body.size() >= 1 && op->body.front()->is<ThenOp>()) {
-        if (op->body.size() == 1)
-            return verify(op.thenOp(), ctx);
+        if (op->body.size() == 1 && resultTypes.empty())
+            return verify(op.thenOp(), ctx) && verifyYield(op.thenOp().op, resultTypes, ctx);
         if (op->body.size() == 2 && op->body.back()->is<ElseOp>())
-            return verify(op.thenOp(), ctx) && verify(op.elseOp(), ctx);
+            return verify(op.thenOp(), ctx) && verify(op.elseOp(), ctx) &&
+                   verifyYield(op.thenOp().op, resultTypes, ctx) && verifyYield(op.elseOp().op, resultTypes, ctx);
     }
     ctx.pushOpError(op) << "must have one operation (ThenOp) or two operations (ThenOp, ElseOp) within body";
     return false;
@@ -304,11 +365,74 @@ VERIFY(ElseOp, op, ctx, verifier) {
     return verify(op->body, ctx);
 }
 
-VERIFY(WhileOp, op, ctx, verifier) {
+VERIFY(SwitchOp, op, ctx, verifier) {
+    verifier.verify<HasOperands>(1).verify<HasInwards>(0).verify<HasAttributes>(0);
+    RETURN_ON_FAILURE(verifier);
+    if (!op.value()->type->is<IntegerType>()) {
+        ctx.pushOpError(op) << "must have integer operand";
+        return false;
+    }
+    auto resultTypes = valueTypes(op->results);
+    auto defaultOp = op.defaultOp();
+    if (!resultTypes.empty() && !defaultOp) {
+        ctx.pushOpError(op) << "must have DefaultOp within body to produce results";
+        return false;
+    }
+    std::unordered_set<NativeInt> caseValues;
+    bool verified = true;
+    for (size_t i = 0; i < op.numCases(); i++) {
+        auto caseOp = op.caseOp(i);
+        if (!caseOp) {
+            ctx.pushOpError(op) << "must have CaseOp operations followed by optional DefaultOp within body";
+            return false;
+        }
+        verified &= verify(caseOp, ctx) && verifyYield(caseOp.op, resultTypes, ctx);
+        if (verified && !caseValues.insert(caseOp.value()).second) {
+            ctx.pushOpError(caseOp) << "must have value distinct from other cases";
+            verified = false;
+        }
+    }
+    if (defaultOp)
+        verified &= verify(defaultOp, ctx) && verifyYield(defaultOp.op, resultTypes, ctx);
+    return verified;
+}
+
+VERIFY(CaseOp, op, ctx, verifier) {
+    verifier.verify<HasOperands>(0).verify<HasResults>(0).verify<HasInwards>(0).verify<HasAttributes>(1);
+    RETURN_ON_FAILURE(verifier);
+    if (!op->attr(0).is<NativeInt>()) {
+        ctx.pushOpError(op) << "must have integer value attribute";
+        return false;
+    }
+    if (op->parent && !op->parent->is<SwitchOp>()) {
+        ctx.pushOpError(op) << "must be within body of parent SwitchOp";
+        return false;
+    }
+    return verify(op->body, ctx);
+}
+
+VERIFY(DefaultOp, op, ctx, verifier) {
     verifier.verify<HasOperands>(0).verify<HasResults>(0).verify<HasInwards>(0).verify<HasAttributes>(0);
     RETURN_ON_FAILURE(verifier);
+    if (op->parent) {
+        if (!op->parent->is<SwitchOp>() || op->parent->body.back() != op.op) {
+            ctx.pushOpError(op) << "must be last operation within body of parent SwitchOp";
+            return false;
+        }
+    }
+    return verify(op->body, ctx);
+}
+
+VERIFY(WhileOp, op, ctx, verifier) {
+    verifier.verify<HasOptionalProfileCounts>(2);
+    RETURN_ON_FAILURE(verifier);
+    auto carriedTypes = valueTypes(op->inwards);
+    if (!valuesHaveTypes(op->operands, carriedTypes) || !valuesHaveTypes(op->results, carriedTypes)) {
+        ctx.pushOpError(op) << "must have operands and results with types of inwards";
+        return false;
+    }
     if (op->body.size() >= 1 && op->body.front()->is<ConditionOp>())
-        return verify(op->body, ctx);
+        return verify(op->body, ctx) && verifyYield(op.op, carriedTypes, ctx);
     ctx.pushOpError(op) << "must have one operation (ConditionOp) within body";
     return false;
 }
@@ -333,12 +457,37 @@ VERIFY(ConditionOp, op, ctx, verifier) {
 }
 
 VERIFY(ForOp, op, ctx, verifier) {
-    verifier.verify<HasOperandsOfType>(3, TypeStorage::integerType())
-        .verify<HasResults>(0)
-        .verify<HasInwardsOfType>(1, TypeStorage::integerType())
-        .verify<HasAttributes>(0);
+    verifier.verify<HasOptionalProfileCounts>(2);
     RETURN_ON_FAILURE(verifier);
-    return verify(op->body, ctx);
+    if (op->numOperands() < ForOp::numControlOperands || op->numInwards() < 1U ||
+        !valuesHaveTypes(std::vector(op->operands.begin(), op->operands.begin() + ForOp::numControlOperands),
+                         std::vector(ForOp::numControlOperands, TypeStorage::integerType())) ||
+        !op.iterator()->hasType(TypeStorage::integerType())) {
+        ctx.pushOpError(op) << "must have integer start, stop, step operands and integer iterator inward";
+        return false;
+    }
+    auto carriedTypes = valueTypes(op->inwards);
+    carriedTypes.erase(carriedTypes.begin());
+    if (!valuesHaveTypes(std::vector(op->operands.begin() + ForOp::numControlOperands, op->operands.end()),
+                         carriedTypes) ||
+        !valuesHaveTypes(op->results, carriedTypes)) {
+        ctx.pushOpError(op) << "must have carried operands and results with types of inwards following iterator";
+        return false;
+    }
+    return verify(op->body, ctx) && verifyYield(op.op, carriedTypes, ctx);
+}
+
+VERIFY(YieldOp, op, ctx, verifier) {
+    verifier.verify<HasResults>(0).verify<HasInwards>(0).verify<HasAttributes>(0);
+    RETURN_ON_FAILURE(verifier);
+    const auto &parent = op->parent;
+    if (!parent || !utils::isAny<ThenOp, ElseOp, CaseOp, DefaultOp, WhileOp, ForOp>(parent) ||
+        parent->body.back() != op.op) {
+        ctx.pushOpError(op)
+            << "must be last operation within body of ThenOp, ElseOp, CaseOp, DefaultOp, WhileOp or ForOp";
+        return false;
+    }
+    return true;
 }
 
 VERIFY(InputOp, op, ctx, verifier) {
@@ -377,6 +526,10 @@ bool verify(const Operation::Ptr &op, SemantizerContext &ctx) {
         return verify(concreteOp, ctx, verifier);
     if (auto concreteOp = op->as<AllocateOp>())
         return verify(concreteOp, ctx, verifier);
+    if (auto concreteOp = op->as<HeapAllocateOp>())
+        return verify(concreteOp, ctx, verifier);
+    if (auto concreteOp = op->as<DeallocateOp>())
+        return verify(concreteOp, ctx, verifier);
     if (auto concreteOp = op->as<LoadOp>())
         return verify(concreteOp, ctx, verifier);
     if (auto concreteOp = op->as<StoreOp>())
@@ -387,12 +540,20 @@ bool verify(const Operation::Ptr &op, SemantizerContext &ctx) {
         return verify(concreteOp, ctx, verifier);
     if (auto concreteOp = op->as<ElseOp>())
         return verify(concreteOp, ctx, verifier);
+    if (auto concreteOp = op->as<SwitchOp>())
+        return verify(concreteOp, ctx, verifier);
+    if (auto concreteOp = op->as<CaseOp>())
+        return verify(concreteOp, ctx, verifier);
+    if (auto concreteOp = op->as<DefaultOp>())
+        return verify(concreteOp, ctx, verifier);
     if (auto concreteOp = op->as<WhileOp>())
         return verify(concreteOp, ctx, verifier);
     if (auto concreteOp = op->as<ConditionOp>())
         return verify(concreteOp, ctx, verifier);
     if (auto concreteOp = op->as<ForOp>())
         return verify(concreteOp, ctx, verifier);
+    if (auto concreteOp = op->as<YieldOp>())
+        return verify(concreteOp, ctx, verifier);
     if (auto concreteOp = op->as<InputOp>())
         return verify(concreteOp, ctx, verifier);
     if (auto concreteOp = op->as<PrintOp>())
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cstddef>
 
+#include "compiler/optree/attribute.hpp"
 #include "compiler/optree/operation.hpp"
 #include "compiler/optree/types.hpp"
 #include "compiler/optree/value.hpp"
@@ -66,3 +67,12 @@ bool HasAttributes::verify(const Operation::Ptr &op, SemantizerContext &ctx, siz
     ctx.pushOpError(op) << "must have " << numAttrs << " attributes";
     return false;
 }
+
+bool HasOptionalProfileCounts::verify(const Operation::Ptr &op, SemantizerContext &ctx, size_t numCounts) {
+    auto isCount = [](const Attribute &attr) { return attr.is<NativeInt>() && attr.as<NativeInt>() >= 0; };
+    if (op->numAttrs() == 0U ||
+        (op->numAttrs() == numCounts && std::all_of(op->attributes.begin(), op->attributes.end(), isCount)))
+        return true;
+    ctx.pushOpError(op) << "must have no attributes or " << numCounts << " non-negative profile counts";
+    return false;
+}
@@ -2,6 +2,7 @@
 #include "compiler/backend/optree/optimizer/transform.hpp"
 
 #include <exception>
+#include <fstream>
 #include <iostream>
 #include <iterator>
 #include <string>
@@ -9,10 +10,14 @@
 #include <vector>
 
 #ifdef LLVMIR_CODEGEN_ENABLED
+#include <algorithm>
+#include <cstddef>
 #include <cstdlib>
 #include <filesystem>
 #include <functional>
+#include <future>
 #include <ostream>
+#include <thread>
 #endif
 
 #include "compiler/backend/ast/optimizer/optimizer.hpp"
@@ -23,8 +28,13 @@
 #include "compiler/frontend/lexer/lexer.hpp"
 #include "compiler/frontend/parser/parser.hpp"
 #include "compiler/frontend/preprocessor/preprocessor.hpp"
+#include "compiler/interpreter/bytecode.hpp"
+#include "compiler/interpreter/bytecode_generator.hpp"
+#include "compiler/interpreter/virtual_machine.hpp"
+#include "compiler/optree/profile.hpp"
 #include "compiler/utils/debug.hpp"
 #include "compiler/utils/error_buffer.hpp"
+#include "compiler/utils/language.hpp"
 #include "compiler/utils/source_files.hpp"
 #include "compiler/utils/timer.hpp"
 
@@ -74,15 +84,26 @@ std::string llToObj(const std::string &llcBin, const std::filesystem::path &llFi
     return makeCommand(cmd);
 }
 
-std::string objToExe(const std::string &clangBin, const std::filesystem::path &objFile,
-                     const std::filesystem::path &exeFile) {
+std::string objToExe(const std::string &clangBin, const std::vector<std::filesystem::path> &objFiles,
+                     const std::filesystem::path &exeFile, const std::string &runtimeLibrary) {
     std::vector<std::string> cmd = {
         clangBin,
 #ifdef COMPILER_PLATFORM_LINUX
         "-fPIE",
 #endif
-        objFile.string(), "-o", exeFile.string(),
     };
+    for (const auto &objFile : objFiles)
+        cmd.push_back(objFile.string());
+    if (!runtimeLibrary.empty()) {
+        cmd.push_back(runtimeLibrary);
+#ifdef COMPILER_PLATFORM_LINUX
+        // Runtime library is written in C++ and uses threads
+        cmd.push_back("-lstdc++");
+        cmd.push_back("-pthread");
+#endif
+    }
+    cmd.push_back("-o");
+    cmd.push_back(exeFile.string());
     return makeCommand(cmd);
 }
 
@@ -94,39 +115,42 @@ int runCommand(const std::string &cmd) {
     return ret;
 }
 
-int runLLVMIRGenerator(const Options &opt, const std::function<void(std::ostream &)> &dumpToStream,
-                       const std::function<void(const std::string &)> &dumpToFile) {
-    if (opt.debug) {
-        std::cerr << "LLVMIR GENERATOR:\n";
-        dumpToStream(std::cerr);
-    }
-    bool printOutput = opt.output == "-";
-    if (!opt.compile) {
-        if (printOutput)
-            dumpToStream(std::cout);
-        else
-            dumpToFile(opt.output);
-        return 0;
-    }
-    if (printOutput) {
+using ModuleDumper = std::function<void(const std::string &)>;
+
+// Emits every module into a separate object file (concurrently if there are several of them) and links the objects
+int compileModules(const Options &opt, const std::vector<ModuleDumper> &dumpers) {
+    if (opt.output == "-") {
         std::cerr << "Unable to print binary file to stdout. Please, provide --output argument.\n";
         return 3;
     }
-    TemporaryDirectory tempDir;
     try {
-        auto llFile = tempDir.path() / "out.ll";
-        dumpToFile(llFile.string());
-        auto objFile = tempDir.path() / "out.obj";
+        TemporaryDirectory tempDir;
+        std::vector<std::filesystem::path> objFiles;
+        std::vector<std::string> llcCmds;
+        for (size_t i = 0; i < dumpers.size(); i++) {
+            auto suffix = dumpers.size() == 1U ? std::string() : std::to_string(i);
+            auto llFile = tempDir.path() / ("out" + suffix + ".ll");
+            dumpers[i](llFile.string());
+            const auto &objFile = objFiles.emplace_back(tempDir.path() / ("out" + suffix + ".obj"));
+            llcCmds.push_back(llToObj(opt.llc, llFile, objFile));
+        }
         auto exeFile = tempDir.path() / "out.exe";
-        auto llcCmd = llToObj(opt.llc, llFile, objFile);
-        auto clangCmd = objToExe(opt.clang, objFile, exeFile);
+        bool needsRuntime = opt.parallelize || !opt.profileGenerate.empty();
+        auto clangCmd = objToExe(opt.clang, objFiles, exeFile, needsRuntime ? opt.runtimeLibrary : std::string());
         if (opt.debug) {
-            std::cerr << "Executing commands:\n"
-                      << "  " << llcCmd << "\n"
-                      << "  " << clangCmd << "\n";
+            std::cerr << "Executing commands:\n";
+            for (const auto &llcCmd : llcCmds)
+                std::cerr << "  " << llcCmd << "\n";
+            std::cerr << "  " << clangCmd << "\n";
         }
-        bool cmdFailed = (runCommand(llcCmd) || runCommand(clangCmd));
-        if (cmdFailed)
+        std::vector<std::future<int>> llcResults;
+        llcResults.reserve(llcCmds.size());
+        for (const auto &llcCmd : llcCmds)
+            llcResults.push_back(std::async(std::launch::async, runCommand, llcCmd));
+        bool cmdFailed = false;
+        for (auto &result : llcResults)
+            cmdFailed = (result.get() != 0) || cmdFailed;
+        if (cmdFailed || runCommand(clangCmd))
             return 3;
         std::filesystem::copy_file(exeFile, opt.output, std::filesystem::copy_options::overwrite_existing);
     } catch (std::exception &e) {
@@ -135,6 +159,21 @@ int runLLVMIRGenerator(const Options &opt, const std::function<void(std::ostream
     }
     return 0;
 }
+
+int runLLVMIRGenerator(const Options &opt, const std::function<void(std::ostream &)> &dumpToStream,
+                       const ModuleDumper &dumpToFile) {
+    if (opt.debug) {
+        std::cerr << "LLVMIR GENERATOR:\n";
+        dumpToStream(std::cerr);
+    }
+    if (opt.compile)
+        return compileModules(opt, {dumpToFile});
+    if (opt.output == "-")
+        dumpToStream(std::cout);
+    else
+        dumpToFile(opt.output);
+    return 0;
+}
 #endif
 
 } // namespace
@@ -240,6 +279,25 @@ int Compiler::runConverter() {
     return 0;
 }
 
+int Compiler::runProfileReader() {
+    try {
+        std::ifstream stream(opt.profileUse);
+        if (!stream.is_open()) {
+            std::cerr << "Unable to read profile " << opt.profileUse << '\n';
+            return 2;
+        }
+        optree::attachProfile(program.root, optree::readProfile(stream));
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+        return 3;
+    }
+    if (opt.debug) {
+        std::cerr << "PROFILE:\n";
+        program.root->dump(std::cerr);
+    }
+    return 0;
+}
+
 int Compiler::runAstSemantizer() {
     Timer timer;
     try {
@@ -305,7 +363,44 @@ int Compiler::runOptreeOptimizer() {
         canonicalizer->add(createEraseUnusedOps());
         canonicalizer->add(createFoldConstants());
         optimizer.add(canonicalizer);
+        optimizer.add(createMergeIdenticalFunctions());
+        optimizer.add(createEliminateTailRecursion());
+        optimizer.add(createEvaluatePureCalls());
+        optimizer.add(createInlineFunctions());
+        optimizer.add(createEraseUnusedFunctions());
+        optimizer.add(createPlaceAllocations(opt.heapThreshold));
+        optimizer.add(createSplitAllocations());
+        optimizer.add(createPromoteAllocations());
+        optimizer.add(createPropagateConditionalConstants());
+        optimizer.add(createEvaluatePureCalls());
+        optimizer.add(createPropagateInterproceduralConstants());
         optimizer.add(createEraseUnusedFunctions());
+        optimizer.add(createPropagateConditionalConstants());
+        // Invariant conditions are hoisted first, so the loops branching on them can be unswitched
+        optimizer.add(createHoistLoopInvariants());
+        optimizer.add(createUnswitchLoops());
+        // Parallel calls are run sequentially by the interpreter, so the loops are not outlined for it
+        if (opt.parallelize && !opt.interpret)
+            optimizer.add(createParallelizeLoops(opt.parallelThreshold));
+        // Loops are fused after the parallelization, so the fused loops carrying values do not prevent it, and their
+        // bounds are deduplicated first to be recognized as the same
+        optimizer.add(createEliminateCommonSubexpressions());
+        optimizer.add(createFuseLoops());
+        // Vector operations are not supported by the interpreter
+        if (!opt.interpret)
+            optimizer.add(createVectorizeLoops(hostVectorBits()));
+        optimizer.add(createUnrollLoops());
+        optimizer.add(createEliminateDeadStores());
+        optimizer.add(createEliminateCommonSubexpressions());
+        optimizer.add(createHoistLoopInvariants());
+        optimizer.add(createReduceStrength());
+        optimizer.add(canonicalizer);
+        // Offsets of the unrolled loops become constant only after the folding, so the lists are split once more
+        optimizer.add(createSplitAllocations());
+        optimizer.add(createPromoteAllocations());
+        // Switches are formed last, so the other transforms deal only with IfOp
+        optimizer.add(createConvertIfChainsToSwitches());
+        optimizer.add(canonicalizer);
         timer.start();
         optimizer.process(program);
         timer.stop();
@@ -322,10 +417,56 @@ int Compiler::runOptreeOptimizer() {
     return 0;
 }
 
+int Compiler::runOptreeInterpreter() {
+    using namespace optree::interpreter;
+    Timer timer;
+    try {
+        timer.start();
+        auto bytecode = generateBytecode(program);
+        if (opt.debug) {
+            std::cerr << "INTERPRETER:\n";
+            bytecode.dump(std::cerr);
+        }
+        VirtualMachine vm(bytecode, std::cin, std::cout);
+        vm.call(utils::language::funcMain);
+        timer.stop();
+    } catch (const InterpreterError &error) {
+        std::cout.flush();
+        std::cerr << "Interpreter error: " << error.what() << '\n';
+        return 4;
+    }
+    if (opt.time)
+        measuredTimes.emplace_back(stage::interpreter, timer.elapsed());
+    return 0;
+}
+
 #ifdef ENABLE_CODEGEN_OPTREE_TO_LLVMIR
 int Compiler::runOptreeLLVMIRGenerator() {
+    using optree::llvmir_generator::LLVMIRGenerator;
     Timer timer;
-    optree::llvmir_generator::LLVMIRGenerator generator(opt.files.front());
+    auto numJobs = opt.codegenJobs != 0U ? opt.codegenJobs : std::max(std::thread::hardware_concurrency(), 1U);
+    // Executables write the profile into the path given relative to the working directory of the compiler
+    auto profilePath =
+        opt.profileGenerate.empty() ? std::string() : std::filesystem::absolute(opt.profileGenerate).string();
+    if (opt.compile && numJobs > 1U) {
+        timer.start();
+        auto generators = LLVMIRGenerator::processInParallel(program, opt.files.front(), numJobs, profilePath);
+        timer.stop();
+        std::vector<ModuleDumper> dumpers;
+        for (const auto &generator : generators) {
+            if (opt.debug) {
+                std::cerr << "LLVMIR GENERATOR:\n" << generator->dump();
+            }
+            dumpers.emplace_back([&g = *generator](const std::string &str) { g.dumpToFile(str); });
+        }
+        RETURN_IF_NONZERO(compileModules(opt, dumpers));
+        if (opt.time)
+            measuredTimes.emplace_back(stage::codegen, timer.elapsed());
+        return 0;
+    }
+    LLVMIRGenerator generator(opt.files.front());
+    if (!profilePath.empty())
+        generator.instrument(profilePath);
     timer.start();
     generator.process(program);
     timer.stop();
@@ -369,10 +510,14 @@ int Compiler::run() {
     } else if (opt.backend == backend::optree) {
         RETURN_IF_NONZERO(runConverter());
         RETURN_IF_STOPAFTER(opt, stage::converter);
+        if (!opt.profileUse.empty())
+            RETURN_IF_NONZERO(runProfileReader());
         if (opt.optimize) {
             RETURN_IF_NONZERO(runOptreeOptimizer());
             RETURN_IF_STOPAFTER(opt, stage::optimizer);
         }
+        if (opt.interpret)
+            return runOptreeInterpreter();
 #ifdef ENABLE_CODEGEN_OPTREE_TO_LLVMIR
         if (opt.codegen == codegen::llvm) {
             RETURN_IF_NONZERO(runOptreeLLVMIRGenerator());
@@ -12,6 +12,9 @@
 #include <stdio.h> // NOLINT(misc-include-cleaner)
 #include <string_view>
 #elif defined(COMPILER_PLATFORM_LINUX)
+#include <cerrno>
+#include <system_error>
+
 #include <stdlib.h> // NOLINT(misc-include-cleaner)
 #endif
 
@@ -21,12 +24,15 @@ TemporaryDirectory::TemporaryDirectory() {
 #if defined(COMPILER_PLATFORM_WINDOWS)
     std::array<char, L_tmpnam_s> tmpnamArg;
     tmpnam_s(tmpnamArg.data(), L_tmpnam_s);
-    char *tmpnamResult = tmpnamArg.data();
-    std::filesystem::create_directory(std::string_view(tmpnamArg.data()));
+    dir = std::string_view(tmpnamArg.data());
+    std::filesystem::create_directory(dir);
 #elif defined(COMPILER_PLATFORM_LINUX)
     auto templatePath = std::filesystem::temp_directory_path() / "XXXXXX";
     std::string tmpnamArg(templatePath.string());
-    mkstemp(tmpnamArg.data());
+    if (mkdtemp(tmpnamArg.data()) == nullptr)
+        throw std::filesystem::filesystem_error("unable to create a temporary directory", templatePath,
+                                                std::make_error_code(std::errc(errno)));
+    dir = tmpnamArg;
 #endif
 }
 
@@ -44,6 +50,15 @@ std::string wrapQuotes(const std::string &str) {
     return "\"" + str + "\"";
 }
 
+unsigned hostVectorBits() {
+#if defined(COMPILER_ARCH_X86) && defined(COMPILER_TOOLCHAIN_GCC_COMPATIBLE)
+    if (__builtin_cpu_supports("avx2"))
+        return 256U;
+#endif
+    // SSE2 on x86-64 and NEON on ARM are always available
+    return 128U;
+}
+
 std::string makeCommand(const std::vector<std::string> &args) {
     if (args.empty())
         return {};
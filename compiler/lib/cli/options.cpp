@@ -1,5 +1,6 @@
 #include "options.hpp"
 
+#include <cstddef>
 #include <iostream>
 #include <stdexcept>
 #include <string>
@@ -12,12 +13,16 @@
 namespace cli {
 
 void Options::dump() const {
-    std::cerr << "debug=" << debug << ", backend=" << backend << ", time=" << time << ", optimize=" << optimize;
+    std::cerr << "debug=" << debug << ", backend=" << backend << ", time=" << time << ", optimize=" << optimize
+              << ", heapThreshold=" << heapThreshold << ", parallelize=" << parallelize
+              << ", parallelThreshold=" << parallelThreshold;
     if (stopAfter.has_value())
         std::cerr << ", stopAfter=" << stopAfter.value();
+    std::cerr << ", interpret=" << interpret << ", profileUse=" << profileUse;
 #ifdef LLVMIR_CODEGEN_ENABLED
     std::cerr << ", codegen=" << codegen << ", compile=" << compile << ", clang=" << clang << ", llc=" << llc
-              << ", output=" << output;
+              << ", output=" << output << ", codegenJobs=" << codegenJobs << ", runtimeLibrary=" << runtimeLibrary
+              << ", profileGenerate=" << profileGenerate;
 #endif
     std::cerr << ", files=[ ";
     for (const auto &file : files)
@@ -42,6 +47,24 @@ Options parseArguments(int argc, const char *const *argv) {
 #endif
         );
     program.add_argument("-O", arg::optimize).help("perform optimizations").flag();
+    program.add_argument(arg::heapThreshold)
+        .help("size in bytes of lists allocated on the heap instead of the stack (used with --optimize)")
+        .default_value(size_t(4096U))
+        .scan<'u', size_t>();
+    program.add_argument(arg::parallelize)
+        .help("run loops without dependences between iterations on multiple threads (used with --optimize)")
+        .flag();
+    program.add_argument(arg::parallelThreshold)
+        .help("minimum number of iterations of the loop run on multiple threads (used with --parallelize)")
+        .default_value(size_t(1000U))
+        .scan<'u', size_t>();
+    program.add_argument(arg::interpret)
+        .help("run the program with the bytecode interpreter instead of generating code (optree backend only)")
+        .flag();
+    program.add_argument(arg::profileUse)
+        .help("profile written by the executable built with --profile-generate, its execution counts guide the "
+              "optimizations and the branch layout (optree backend only)")
+        .default_value(std::string());
 #ifdef LLVMIR_CODEGEN_ENABLED
     program.add_argument(arg::codegen)
         .help("code generator")
@@ -51,6 +74,17 @@ Options parseArguments(int argc, const char *const *argv) {
     program.add_argument(arg::clang).help("path to clang executable").default_value("clang");
     program.add_argument(arg::llc).help("path to llc executable").default_value("llc");
     program.add_argument("-o", arg::output).help("output file").default_value("-");
+    program.add_argument(arg::codegenJobs)
+        .help("number of threads generating and emitting code with --compile (0 means all available cores)")
+        .default_value(1U)
+        .scan<'u', unsigned>();
+    program.add_argument(arg::runtimeLibrary)
+        .help("path to runtime library linked into executables (used with --parallelize and --profile-generate)")
+        .default_value(std::string(COMPILER_RUNTIME_LIBRARY));
+    program.add_argument(arg::profileGenerate)
+        .help("instrument the executable to write execution counts of functions, branches and loops to the given "
+              "profile at the exit (optree backend only)")
+        .default_value(std::string());
 #endif
     program.add_argument(arg::files)
         .help("source files (separated by spaces)")
@@ -68,14 +102,29 @@ Options parseArguments(int argc, const char *const *argv) {
     options.backend = program.get<std::string>(arg::backend);
     options.time = program.get<bool>(arg::time);
     options.optimize = program.get<bool>(arg::optimize);
+    options.heapThreshold = program.get<size_t>(arg::heapThreshold);
+    options.parallelize = program.get<bool>(arg::parallelize);
+    options.parallelThreshold = program.get<size_t>(arg::parallelThreshold);
     if (program.is_used(arg::stopAfter))
         options.stopAfter = program.get<std::string>(arg::stopAfter);
+    options.interpret = program.get<bool>(arg::interpret);
+    if (options.interpret && options.backend != backend::optree)
+        throw OptionsError(std::string(arg::interpret) + " is supported by the optree backend only");
+    options.profileUse = program.get<std::string>(arg::profileUse);
+    if (!options.profileUse.empty() && options.backend != backend::optree)
+        throw OptionsError(std::string(arg::profileUse) + " is supported by the optree backend only");
 #ifdef LLVMIR_CODEGEN_ENABLED
     options.codegen = program.get<std::string>(arg::codegen);
     options.compile = program.get<bool>(arg::compile);
     options.clang = program.get<std::string>(arg::clang);
     options.llc = program.get<std::string>(arg::llc);
     options.output = program.get<std::string>(arg::output);
+    options.codegenJobs = program.get<unsigned>(arg::codegenJobs);
+    options.runtimeLibrary = program.get<std::string>(arg::runtimeLibrary);
+    options.profileGenerate = program.get<std::string>(arg::profileGenerate);
+    if (!options.profileGenerate.empty() && (options.backend != backend::optree || options.interpret))
+        throw OptionsError(std::string(arg::profileGenerate) +
+                           " is supported by the optree backend generating code only");
 #endif
     if (program.is_used(arg::files))
         options.files = program.get<std::vector<std::string>>(arg::files);
@@ -1,16 +1,26 @@
 #include "llvmir_generator.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include <llvm/ADT/STLExtras.h>
 #include <llvm/IR/CFG.h>
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/GlobalValue.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/MDBuilder.h>
 #include <llvm/IR/Type.h>
 #include <llvm/IR/Value.h>
 #include <llvm/Support/Casting.h>
@@ -19,10 +29,12 @@
 #include "compiler/optree/adaptors.hpp"
 #include "compiler/optree/definitions.hpp"
 #include "compiler/optree/operation.hpp"
+#include "compiler/optree/profile.hpp"
 #include "compiler/optree/program.hpp"
 #include "compiler/optree/types.hpp"
 #include "compiler/optree/value.hpp"
 #include "compiler/utils/debug.hpp"
+#include "compiler/utils/language.hpp"
 
 using namespace optree;
 using namespace optree::llvmir_generator;
@@ -34,6 +46,12 @@ namespace external {
 
 constexpr std::string_view printf = "printf";
 constexpr std::string_view scanf = "scanf";
+constexpr std::string_view malloc = "malloc";
+constexpr std::string_view free = "free";
+// Runtime library function running the outlined loop body on the thread pool
+constexpr std::string_view parallelFor = "__compiler_parallel_for";
+// Runtime library function registering the counters of the instrumented module
+constexpr std::string_view profileRegister = "__compiler_profile_register";
 
 } // namespace external
 
@@ -51,10 +69,114 @@ std::string_view getFormatSpecifier(const Type::Ptr &type) {
     COMPILER_UNREACHABLE("unexpected type for a format specifier");
 }
 
+std::string getFormat(const PrintOp &op) {
+    std::string format;
+    format.reserve(4U * op->numOperands());
+    for (const auto &operand : op->operands)
+        format += getFormatSpecifier(operand->type);
+    return format;
+}
+
+std::string getFormat(const InputOp &op) {
+    return std::string(getFormatSpecifier(op.dst()->type->as<PointerType>().pointee));
+}
+
+void collectGlobalStrings(const Operation::Ptr &op, LLVMIRGenerator::SharedStrings &strings) {
+    auto save = [&strings](const std::string &str) {
+        if (!strings.contains(str))
+            strings.emplace(str, ".str.shared." + std::to_string(strings.size()));
+    };
+    if (auto constOp = op->as<ConstantOp>()) {
+        if (constOp.result()->type->is<StrType>())
+            save(constOp.value().as<NativeStr>());
+    } else if (auto printOp = op->as<PrintOp>()) {
+        save(getFormat(printOp));
+    } else if (auto inputOp = op->as<InputOp>()) {
+        save(getFormat(inputOp));
+    }
+    for (const auto &inner : op->body)
+        collectGlobalStrings(inner, strings);
+}
+
+size_t countOperations(const Operation::Ptr &op) {
+    size_t count = 1U;
+    for (const auto &inner : op->body)
+        count += countOperations(inner);
+    return count;
+}
+
+// Greedily assigns the heaviest functions to the least loaded shards, keeping the source order inside each shard
+std::vector<std::vector<FunctionOp>> partitionFunctions(const Operation::Ptr &root, size_t numShards) {
+    std::vector<std::pair<size_t, size_t>> weights;
+    std::vector<FunctionOp> functions;
+    for (const auto &op : root->body) {
+        if (auto funcOp = op->as<FunctionOp>()) {
+            weights.emplace_back(countOperations(op), functions.size());
+            functions.push_back(funcOp);
+        }
+    }
+    std::ranges::stable_sort(weights, [](const auto &lhs, const auto &rhs) { return lhs.first > rhs.first; });
+
+    std::vector<std::vector<size_t>> indices(std::max<size_t>(numShards, 1U));
+    std::vector<size_t> loads(indices.size(), 0U);
+    for (const auto &[weight, index] : weights) {
+        auto lightest = static_cast<size_t>(std::distance(loads.begin(), std::ranges::min_element(loads)));
+        indices[lightest].push_back(index);
+        loads[lightest] += weight;
+    }
+
+    std::vector<std::vector<FunctionOp>> shards;
+    for (auto &shardIndices : indices) {
+        if (shardIndices.empty() && !shards.empty())
+            continue;
+        std::ranges::sort(shardIndices);
+        auto &shard = shards.emplace_back();
+        for (auto index : shardIndices)
+            shard.push_back(functions[index]);
+    }
+    return shards;
+}
+
+// Stack memory is accessed only by the function itself unless its pointer is passed somewhere
+bool exposesStack(const Operation::Ptr &op) {
+    for (const auto &inner : op->body) {
+        if (inner->is<AllocateOp>()) {
+            for (const auto &use : inner->result(0)->uses) {
+                auto user = use.lock();
+                if (!user->is<LoadOp>() && !(user->is<StoreOp>() && use.operandNumber == 0))
+                    return true;
+            }
+        }
+        if (exposesStack(inner))
+            return true;
+    }
+    return false;
+}
+
+// Callee of the call which is immediately returned can reuse the stack frame of the caller,
+// provided that it does not access the memory of this frame
+bool isTailCall(const FunctionCallOp &op) {
+    auto nextIt = std::next(op->position);
+    if (nextIt == op->parent->body.end() || !(*nextIt)->is<ReturnOp>())
+        return false;
+    const auto &returnOp = *nextIt;
+    if (returnOp->numOperands() == 0 ? !op.result()->type->is<NoneType>() : returnOp->operand(0) != op.result())
+        return false;
+    if (std::ranges::any_of(op->operands, [](const Value::Ptr &arg) { return arg->type->is<PointerType>(); }))
+        return false;
+    auto funcOp = op->findParent<FunctionOp>();
+    return funcOp && !exposesStack(funcOp);
+}
+
 } // namespace
 
 LLVMIRGenerator::LLVMIRGenerator(const std::string &moduleName)
-    : context(), builder(context), mod(moduleName, context), currentFunction(nullptr) {
+    : context(), builder(context), mod(moduleName, context), currentFunction(nullptr), sharedStrings(nullptr),
+      profileCountersArray(nullptr) {
+}
+
+void LLVMIRGenerator::instrument(const std::string &path) {
+    profilePath = path;
 }
 
 llvm::Value *LLVMIRGenerator::findValue(const Value::Ptr &value) const {
@@ -81,9 +203,17 @@ llvm::Type *LLVMIRGenerator::convertType(const Type::Ptr &type) {
         return llvm::Type::getIntNPtrTy(context, type->as<StrType>().charWidth);
     if (type->is<PointerType>())
         return llvm::PointerType::getUnqual(context);
+    if (type->is<VectorType>()) {
+        const auto &vectorType = type->as<VectorType>();
+        return llvm::FixedVectorType::get(convertType(vectorType.element), vectorType.numLanes);
+    }
     COMPILER_UNREACHABLE("unexpected type");
 }
 
+llvm::Align LLVMIRGenerator::alignOf(llvm::Type *type) const {
+    return mod.getDataLayout().getABITypeAlign(type);
+}
+
 llvm::BasicBlock *LLVMIRGenerator::createBlock() {
     auto *bb = llvm::BasicBlock::Create(context, "bb", currentFunction);
     basicBlocks.push_back(bb);
@@ -95,6 +225,8 @@ void LLVMIRGenerator::eraseDeadBlocks() {
         if (bb == nullptr)
             continue;
         if (llvm::pred_empty(bb) && !bb->isEntryBlock()) {
+            for (auto *succ : llvm::successors(bb))
+                succ->removePredecessor(bb);
             bb->eraseFromParent();
             bb = nullptr;
         }
@@ -116,6 +248,19 @@ llvm::Value *LLVMIRGenerator::getGlobalString(const std::string &str) {
     auto it = globalStrings.find(str);
     if (it != globalStrings.end())
         return it->second;
+    if (sharedStrings) {
+        auto nameIt = sharedStrings->find(str);
+        if (nameIt != sharedStrings->end()) {
+            // The same constant is emitted by every module using it, the linker keeps a single copy
+            auto *init = llvm::ConstantDataArray::getString(context, str);
+            auto *global = new llvm::GlobalVariable(mod, init->getType(), /*isConstant*/ true,
+                                                    llvm::GlobalValue::LinkOnceODRLinkage, init, nameIt->second);
+            global->setComdat(mod.getOrInsertComdat(nameIt->second));
+            global->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+            global->setAlignment(llvm::Align(1));
+            return globalStrings[str] = global;
+        }
+    }
     return globalStrings[str] = builder.CreateGlobalString(str);
 }
 
@@ -138,9 +283,76 @@ llvm::FunctionCallee LLVMIRGenerator::loadExternalFunction(std::string_view name
         return createVarArgFunction(name);
     if (name == external::scanf)
         return createVarArgFunction(name);
+    if (name == external::malloc) {
+        auto *llvmType = llvm::FunctionType::get(llvm::PointerType::getUnqual(context),
+                                                 {llvm::Type::getInt64Ty(context)}, /*isVarArg*/ false);
+        return mod.getOrInsertFunction(name, llvmType);
+    }
+    if (name == external::free) {
+        auto *llvmType = llvm::FunctionType::get(llvm::Type::getVoidTy(context),
+                                                 {llvm::PointerType::getUnqual(context)}, /*isVarArg*/ false);
+        return mod.getOrInsertFunction(name, llvmType);
+    }
+    if (name == external::parallelFor) {
+        auto *i64Type = llvm::Type::getInt64Ty(context);
+        auto *ptrType = llvm::PointerType::getUnqual(context);
+        auto *llvmType = llvm::FunctionType::get(llvm::Type::getVoidTy(context),
+                                                 {i64Type, i64Type, i64Type, ptrType, ptrType}, /*isVarArg*/ false);
+        return mod.getOrInsertFunction(name, llvmType);
+    }
+    if (name == external::profileRegister) {
+        auto *ptrType = llvm::PointerType::getUnqual(context);
+        auto *llvmType = llvm::FunctionType::get(llvm::Type::getVoidTy(context),
+                                                 {ptrType, ptrType, ptrType, llvm::Type::getInt64Ty(context)},
+                                                 /*isVarArg*/ false);
+        return mod.getOrInsertFunction(name, llvmType);
+    }
     COMPILER_UNREACHABLE("unexpected external function");
 }
 
+llvm::Function *LLVMIRGenerator::declareFunction(const FunctionOp &op) {
+    const auto &funcType = op.type();
+    std::vector<llvm::Type *> arguments;
+    arguments.reserve(funcType.arguments.size());
+    for (const auto &arg : funcType.arguments)
+        arguments.push_back(convertType(arg));
+    auto *llvmType = llvm::FunctionType::get(convertType(funcType.result), arguments, /*isVarArg*/ false);
+    return llvm::cast<llvm::Function>(mod.getOrInsertFunction(op.name(), llvmType).getCallee());
+}
+
+llvm::AllocaInst *LLVMIRGenerator::createEntryAlloca(llvm::Type *type, size_t numElements) {
+    // Allocas of the entry block are static, so they do not grow the stack inside loops
+    auto &entryBlock = currentFunction->getEntryBlock();
+    IRBuilder entryBuilder(&entryBlock, entryBlock.getFirstInsertionPt());
+    llvm::Value *size = nullptr;
+    if (numElements > 1U)
+        size = llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), numElements);
+    return entryBuilder.CreateAlloca(type, size);
+}
+
+std::vector<llvm::PHINode *> LLVMIRGenerator::createCarriedPhis(const std::vector<Value::Ptr> &inits,
+                                                                const std::vector<Value::Ptr> &inwards,
+                                                                const std::vector<Value::Ptr> &results,
+                                                                llvm::BasicBlock *preheader) {
+    // Both the loop body and the code after the loop observe the values carried at the condition check
+    std::vector<llvm::PHINode *> phis;
+    phis.reserve(inwards.size());
+    for (size_t i = 0; i < inwards.size(); i++) {
+        auto *phi = builder.CreatePHI(convertType(inwards[i]->type), 2U);
+        phi->addIncoming(findValue(inits[i]), preheader);
+        saveValue(inwards[i], phi);
+        saveValue(results[i], phi);
+        phis.push_back(phi);
+    }
+    return phis;
+}
+
+void LLVMIRGenerator::addCarriedIncomings(const std::vector<llvm::PHINode *> &phis, const YieldOp &yieldOp,
+                                          llvm::BasicBlock *latch) {
+    for (size_t i = 0; i < phis.size(); i++)
+        phis[i]->addIncoming(findValue(yieldOp->operand(i)), latch);
+}
+
 void LLVMIRGenerator::visit(const Operation::Ptr &op) {
     if (auto concreteOp = op->as<ModuleOp>())
         return visit(concreteOp);
@@ -164,6 +376,10 @@ void LLVMIRGenerator::visit(const Operation::Ptr &op) {
         return visit(concreteOp);
     if (auto concreteOp = op->as<AllocateOp>())
         return visit(concreteOp);
+    if (auto concreteOp = op->as<HeapAllocateOp>())
+        return visit(concreteOp);
+    if (auto concreteOp = op->as<DeallocateOp>())
+        return visit(concreteOp);
     if (auto concreteOp = op->as<LoadOp>())
         return visit(concreteOp);
     if (auto concreteOp = op->as<StoreOp>())
@@ -174,12 +390,20 @@ void LLVMIRGenerator::visit(const Operation::Ptr &op) {
         return visit(concreteOp);
     if (auto concreteOp = op->as<ElseOp>())
         return visit(concreteOp);
+    if (auto concreteOp = op->as<SwitchOp>())
+        return visit(concreteOp);
+    if (auto concreteOp = op->as<CaseOp>())
+        return visit(concreteOp);
+    if (auto concreteOp = op->as<DefaultOp>())
+        return visit(concreteOp);
     if (auto concreteOp = op->as<WhileOp>())
         return visit(concreteOp);
     if (auto concreteOp = op->as<ConditionOp>())
         return visit(concreteOp);
     if (auto concreteOp = op->as<ForOp>())
         return visit(concreteOp);
+    if (auto concreteOp = op->as<YieldOp>())
+        return visit(concreteOp);
     if (auto concreteOp = op->as<InputOp>())
         return visit(concreteOp);
     if (auto concreteOp = op->as<PrintOp>())
@@ -193,40 +417,183 @@ void LLVMIRGenerator::visitBody(const Operation::Ptr &op) {
 }
 
 void LLVMIRGenerator::visit(const ModuleOp &op) {
-    for (const auto &inner : op->body)
-        visit(inner);
+    parallelFunctions.clear();
+    for (const auto &inner : op->body) {
+        if (auto funcOp = inner->as<FunctionOp>()) {
+            declareFunction(funcOp);
+            if (funcOp.hasDecorator(utils::language::atParallel))
+                parallelFunctions.insert(funcOp.name());
+        }
+    }
+    if (!profilePath.empty()) {
+        for (const auto &inner : op->body)
+            if (definedFunctions.empty() || definedFunctions.contains(inner.get()))
+                collectProfileCounters(inner);
+        if (!profileKeys.empty())
+            createProfileCounters();
+    }
+    for (const auto &inner : op->body) {
+        if (definedFunctions.empty() || definedFunctions.contains(inner.get()))
+            visit(inner);
+    }
 }
 
 void LLVMIRGenerator::visit(const FunctionOp &op) {
     const auto &funcType = op.type();
-    std::vector<llvm::Type *> arguments;
-    std::vector<llvm::Type *> elemTypes;
-    for (const auto &arg : funcType.arguments) {
-        arguments.push_back(convertType(arg));
-        elemTypes.push_back(arg->is<PointerType>() ? convertType(arg->as<PointerType>().pointee) : nullptr);
-    }
-    auto *llvmType = llvm::FunctionType::get(convertType(funcType.result), arguments, /*isVarArg*/ false);
-    currentFunction = llvm::cast<llvm::Function>(mod.getOrInsertFunction(op.name(), llvmType).getCallee());
+    currentFunction = declareFunction(op);
     for (size_t i = 0; i < op->numInwards(); i++) {
         auto *argValue = currentFunction->getArg(i);
         saveValue(op->inward(i), argValue);
-        if (auto *elemType = elemTypes[i])
-            typedValues[argValue] = elemType;
+        const auto &argType = funcType.arguments[i];
+        if (argType->is<PointerType>())
+            typedValues[argValue] = convertType(argType->as<PointerType>().pointee);
     }
+    if (auto counts = getProfileCounts(op); !counts.empty())
+        currentFunction->setEntryCount(static_cast<uint64_t>(counts.front()));
     auto *bb = createBlock();
     builder.SetInsertPoint(bb);
+    incrementProfileCounter(op, 0U);
     visitBody(op);
 }
 
 void LLVMIRGenerator::visit(const FunctionCallOp &op) {
+    if (parallelFunctions.contains(op.name()))
+        return createParallelCall(op);
     std::vector<llvm::Value *> arguments;
     for (const auto &arg : op->operands)
         arguments.push_back(findValue(arg));
-    auto *inst = builder.CreateCall(mod.getFunction(op.name()), arguments);
+    auto *callee = mod.getFunction(op.name());
+    auto *inst = builder.CreateCall(callee, arguments);
+    if (isTailCall(op)) {
+        // Musttail guarantees the reuse of the frame, but requires the same prototypes of the caller and the callee
+        bool isSamePrototype = callee->getFunctionType() == builder.GetInsertBlock()->getParent()->getFunctionType();
+        inst->setTailCallKind(isSamePrototype ? llvm::CallInst::TCK_MustTail : llvm::CallInst::TCK_Tail);
+    }
     if (op->numResults() != 0)
         saveValue(op.result(), inst);
 }
 
+// Task function called by the runtime for a chunk of iterations, it unpacks the captured arguments from the context
+// and passes them to the outlined loop
+llvm::Function *LLVMIRGenerator::getParallelTask(llvm::Function *callee, llvm::StructType *contextType) {
+    auto name = (callee->getName() + ".task").str();
+    if (auto *task = mod.getFunction(name))
+        return task;
+    auto *i64Type = llvm::Type::getInt64Ty(context);
+    auto *taskType = llvm::FunctionType::get(llvm::Type::getVoidTy(context),
+                                             {i64Type, i64Type, i64Type, llvm::PointerType::getUnqual(context)},
+                                             /*isVarArg*/ false);
+    auto *task = llvm::Function::Create(taskType, llvm::Function::InternalLinkage, name, mod);
+    IRBuilder taskBuilder(llvm::BasicBlock::Create(context, "", task));
+    std::vector<llvm::Value *> arguments = {task->getArg(0), task->getArg(1), task->getArg(2)};
+    for (unsigned i = 0; i < contextType->getNumElements(); i++) {
+        auto *field = taskBuilder.CreateStructGEP(contextType, task->getArg(3), i);
+        arguments.push_back(taskBuilder.CreateLoad(contextType->getElementType(i), field));
+    }
+    taskBuilder.CreateCall(callee, arguments);
+    taskBuilder.CreateRetVoid();
+    return task;
+}
+
+// Calls of the outlined parallel loops pass the bounds and the step of the loop directly to the runtime,
+// while the rest of the arguments are stored into the context on the stack of the caller
+void LLVMIRGenerator::createParallelCall(const FunctionCallOp &op) {
+    constexpr size_t numBounds = 3U;
+    std::vector<llvm::Value *> captured;
+    std::vector<llvm::Type *> fields;
+    for (size_t i = numBounds; i < op->numOperands(); i++) {
+        auto *value = captured.emplace_back(findValue(op->operand(i)));
+        fields.push_back(value->getType());
+    }
+    auto *contextType = llvm::StructType::get(context, fields);
+    auto *ptrType = llvm::PointerType::getUnqual(context);
+    llvm::Value *contextPtr = llvm::ConstantPointerNull::get(ptrType);
+    if (!captured.empty()) {
+        contextPtr = builder.CreatePointerCast(createEntryAlloca(contextType), ptrType);
+        for (size_t i = 0; i < captured.size(); i++)
+            builder.CreateStore(captured[i], builder.CreateStructGEP(contextType, contextPtr, i));
+    }
+    auto *task = builder.CreatePointerCast(getParallelTask(mod.getFunction(op.name()), contextType), ptrType);
+    auto *start = findValue(op->operand(0));
+    auto *stop = findValue(op->operand(1));
+    auto *step = findValue(op->operand(2));
+    builder.CreateCall(getExternalFunction(external::parallelFor), {start, stop, step, task, contextPtr});
+}
+
+void LLVMIRGenerator::collectProfileCounters(const Operation::Ptr &op) {
+    auto keys = getProfileKeys(op);
+    if (!keys.empty()) {
+        profileCounters[op.get()] = profileKeys.size();
+        profileKeys.insert(profileKeys.end(), keys.begin(), keys.end());
+    }
+    for (const auto &inner : op->body)
+        collectProfileCounters(inner);
+}
+
+// Every module keeps its own counters and registers them in the runtime library from its constructor
+void LLVMIRGenerator::createProfileCounters() {
+    auto *i64Type = llvm::Type::getInt64Ty(context);
+    auto *ptrType = llvm::PointerType::getUnqual(context);
+    auto *countersType = llvm::ArrayType::get(i64Type, profileKeys.size());
+    profileCountersArray =
+        new llvm::GlobalVariable(mod, countersType, /*isConstant*/ false, llvm::GlobalValue::InternalLinkage,
+                                 llvm::ConstantAggregateZero::get(countersType), "__compiler_profile_counters");
+    auto createString = [&](const std::string &str) -> llvm::Constant * {
+        auto *init = llvm::ConstantDataArray::getString(context, str);
+        return new llvm::GlobalVariable(mod, init->getType(), /*isConstant*/ true, llvm::GlobalValue::PrivateLinkage,
+                                        init);
+    };
+    std::vector<llvm::Constant *> keys;
+    keys.reserve(profileKeys.size());
+    for (const auto &key : profileKeys)
+        keys.push_back(createString(key));
+    auto *keysType = llvm::ArrayType::get(ptrType, keys.size());
+    auto *keysArray = new llvm::GlobalVariable(mod, keysType, /*isConstant*/ true, llvm::GlobalValue::PrivateLinkage,
+                                               llvm::ConstantArray::get(keysType, keys));
+
+    auto *ctorType = llvm::FunctionType::get(llvm::Type::getVoidTy(context), /*isVarArg*/ false);
+    auto *ctor = llvm::Function::Create(ctorType, llvm::Function::InternalLinkage, "__compiler_profile_init", mod);
+    IRBuilder ctorBuilder(llvm::BasicBlock::Create(context, "", ctor));
+    ctorBuilder.CreateCall(getExternalFunction(external::profileRegister),
+                           {createString(profilePath), keysArray, profileCountersArray,
+                            llvm::ConstantInt::get(i64Type, profileKeys.size())});
+    ctorBuilder.CreateRetVoid();
+
+    auto *i32Type = llvm::Type::getInt32Ty(context);
+    auto *entryType = llvm::StructType::get(i32Type, ptrType, ptrType);
+    auto *entry = llvm::ConstantStruct::get(entryType, {llvm::ConstantInt::get(i32Type, 65535U), ctor,
+                                                        llvm::ConstantPointerNull::get(ptrType)});
+    auto *ctorsType = llvm::ArrayType::get(entryType, 1U);
+    new llvm::GlobalVariable(mod, ctorsType, /*isConstant*/ false, llvm::GlobalValue::AppendingLinkage,
+                             llvm::ConstantArray::get(ctorsType, {entry}), "llvm.global_ctors");
+}
+
+// Increments are atomic, since the bodies of the parallelized loops run on multiple threads. Their order does not
+// matter, so the monotonic ordering is enough
+void LLVMIRGenerator::incrementProfileCounter(const Operation::Ptr &op, size_t index) {
+    auto it = profileCounters.find(op.get());
+    if (it == profileCounters.end())
+        return;
+    auto *i64Type = llvm::Type::getInt64Ty(context);
+    auto *counter = builder.CreateConstInBoundsGEP2_64(profileCountersArray->getValueType(), profileCountersArray, 0U,
+                                                       it->second + index);
+    builder.CreateAtomicRMW(llvm::AtomicRMWInst::Add, counter, llvm::ConstantInt::get(i64Type, 1U), llvm::MaybeAlign(),
+                            llvm::AtomicOrdering::Monotonic);
+}
+
+// Weights of the branches taken at the condition of IfOp (ThenOp, ElseOp) and loops (iteration, exit), they are
+// 32-bit, so large counts are scaled down keeping their ratio
+llvm::MDNode *LLVMIRGenerator::createBranchWeights(const Operation::Ptr &op) {
+    auto counts = getProfileCounts(op);
+    if (counts.size() != 2U || (counts[0] == 0 && counts[1] == 0))
+        return nullptr;
+    auto taken = static_cast<uint64_t>(op->is<IfOp>() ? counts[0] : counts[1]);
+    auto notTaken = static_cast<uint64_t>(op->is<IfOp>() ? counts[1] : counts[0]);
+    uint64_t scale = std::max(taken, notTaken) / std::numeric_limits<uint32_t>::max() + 1U;
+    return llvm::MDBuilder(context).createBranchWeights(static_cast<uint32_t>(taken / scale),
+                                                        static_cast<uint32_t>(notTaken / scale));
+}
+
 void LLVMIRGenerator::visit(const ReturnOp &op) {
     if (op->numOperands() == 0)
         builder.CreateRetVoid();
@@ -238,18 +605,27 @@ void LLVMIRGenerator::visit(const ReturnOp &op) {
 
 void LLVMIRGenerator::visit(const ConstantOp &op) {
     const auto &type = op.result()->type;
-    auto result = [&](llvm::Value *v) -> void { saveValue(op.result(), v); };
+    if (type->is<VectorType>()) {
+        // Vector constant holds a scalar broadcasted to all of the lanes
+        const auto &vectorType = type->as<VectorType>();
+        auto *element = llvm::cast<llvm::Constant>(convertConstant(vectorType.element, op));
+        auto numLanes = llvm::ElementCount::getFixed(vectorType.numLanes);
+        return saveValue(op.result(), llvm::ConstantVector::getSplat(numLanes, element));
+    }
+    saveValue(op.result(), convertConstant(type, op));
+}
+
+llvm::Value *LLVMIRGenerator::convertConstant(const Type::Ptr &type, const ConstantOp &op) {
     if (type->is<BoolType>())
-        return result(llvm::ConstantInt::get(convertType(type), op.value().as<bool>()));
+        return llvm::ConstantInt::get(convertType(type), op.value().as<bool>());
     if (type->is<IntegerType>()) {
         auto num = static_cast<int64_t>(op.value().as<NativeInt>());
-        auto *value = llvm::ConstantInt::get(convertType(type), reinterpret_cast<uint64_t &>(num), /*IsSigned*/ true);
-        return result(value);
+        return llvm::ConstantInt::get(convertType(type), reinterpret_cast<uint64_t &>(num), /*IsSigned*/ true);
     }
     if (type->is<FloatType>())
-        return result(llvm::ConstantFP::get(convertType(type), static_cast<double>(op.value().as<NativeFloat>())));
+        return llvm::ConstantFP::get(convertType(type), static_cast<double>(op.value().as<NativeFloat>()));
     if (type->is<StrType>())
-        return result(getGlobalString(op.value().as<NativeStr>()));
+        return getGlobalString(op.value().as<NativeStr>());
     COMPILER_UNREACHABLE("unexpected result type in ConstantOp");
 }
 
@@ -274,6 +650,10 @@ void LLVMIRGenerator::visit(const ArithBinaryOp &op) {
         return result(builder.CreateFMul(lhs, rhs));
     case ArithBinOpKind::DivF:
         return result(builder.CreateFDiv(lhs, rhs));
+    case ArithBinOpKind::ShlI:
+        return result(builder.CreateShl(lhs, rhs));
+    case ArithBinOpKind::ShrI:
+        return result(builder.CreateAShr(lhs, rhs));
     default:
         COMPILER_UNREACHABLE("unexpected kind in ArithBinaryOp");
     }
@@ -367,16 +747,34 @@ void LLVMIRGenerator::visit(const LogicUnaryOp &op) {
 void LLVMIRGenerator::visit(const AllocateOp &op) {
     const auto &type = op.result()->type->as<PointerType>();
     auto *llvmType = convertType(type.pointee);
-    llvm::Value *size = nullptr;
+    llvm::Value *inst = nullptr;
     if (type.numElements == PointerType::dynamic)
-        size = findValue(op.dynamicSize());
-    else if (type.numElements > 1U)
-        size = llvm::ConstantInt::get(llvm::Type::getIntNTy(context, 64U), type.numElements);
-    auto *inst = builder.CreateAlloca(llvmType, size);
+        inst = builder.CreateAlloca(llvmType, findValue(op.dynamicSize()));
+    else
+        inst = createEntryAlloca(llvmType, type.numElements);
     saveValue(op.result(), inst);
     typedValues[inst] = llvmType;
 }
 
+void LLVMIRGenerator::visit(const HeapAllocateOp &op) {
+    const auto &type = op.result()->type->as<PointerType>();
+    auto *llvmType = convertType(type.pointee);
+    auto *i64Type = llvm::Type::getInt64Ty(context);
+    llvm::Value *numElements = nullptr;
+    if (type.numElements == PointerType::dynamic)
+        numElements = builder.CreateSExtOrTrunc(findValue(op.dynamicSize()), i64Type);
+    else
+        numElements = llvm::ConstantInt::get(i64Type, type.numElements);
+    auto *elementSize = llvm::ConstantExpr::getSizeOf(llvmType);
+    auto *inst = builder.CreateCall(getExternalFunction(external::malloc), {builder.CreateMul(numElements, elementSize)});
+    saveValue(op.result(), inst);
+    typedValues[inst] = llvmType;
+}
+
+void LLVMIRGenerator::visit(const DeallocateOp &op) {
+    builder.CreateCall(getExternalFunction(external::free), {findValue(op.ptr())});
+}
+
 void LLVMIRGenerator::visit(const LoadOp &op) {
     auto *ptr = findValue(op.src());
     auto *type = typedValues[ptr];
@@ -384,14 +782,24 @@ void LLVMIRGenerator::visit(const LoadOp &op) {
         auto *index = findValue(offset);
         ptr = builder.CreateGEP(type, ptr, index);
     }
+    // Vector loads take consecutive elements, which are aligned only as a single element
+    if (op.result()->type->is<VectorType>()) {
+        auto *vectorType = convertType(op.result()->type);
+        return saveValue(op.result(), builder.CreateAlignedLoad(vectorType, ptr, alignOf(type)));
+    }
     saveValue(op.result(), builder.CreateLoad(type, ptr));
 }
 
 void LLVMIRGenerator::visit(const StoreOp &op) {
     auto *ptr = findValue(op.dst());
+    auto *type = typedValues[ptr];
     if (auto offset = op.offset()) {
         auto *index = findValue(offset);
-        ptr = builder.CreateGEP(typedValues[ptr], ptr, index);
+        ptr = builder.CreateGEP(type, ptr, index);
+    }
+    if (op.valueToStore()->type->is<VectorType>()) {
+        builder.CreateAlignedStore(findValue(op.valueToStore()), ptr, alignOf(type));
+        return;
     }
     builder.CreateStore(findValue(op.valueToStore()), ptr);
 }
@@ -400,21 +808,34 @@ void LLVMIRGenerator::visit(const IfOp &op) {
     auto *prevBlock = builder.GetInsertBlock();
     auto *thenBlock = createBlock();
     builder.SetInsertPoint(thenBlock);
+    incrementProfileCounter(op, 0U);
     visit(op.thenOp());
     auto *newThenBlock = builder.GetInsertBlock();
     auto *elseBlock = createBlock();
     auto *nextBlock = elseBlock;
-    if (auto elseOp = op.elseOp()) {
+    llvm::BasicBlock *newElseBlock = nullptr;
+    auto elseOp = op.elseOp();
+    // Counter of the missing ElseOp is placed into a separate block on the edge skipping ThenOp
+    if (elseOp || profileCounters.contains(op.op.get())) {
         builder.SetInsertPoint(elseBlock);
-        visit(elseOp);
+        incrementProfileCounter(op, 1U);
+        if (elseOp)
+            visit(elseOp);
+        newElseBlock = builder.GetInsertBlock();
         nextBlock = createBlock();
         builder.CreateBr(nextBlock);
     }
     builder.SetInsertPoint(newThenBlock);
     builder.CreateBr(nextBlock);
     builder.SetInsertPoint(prevBlock);
-    builder.CreateCondBr(normalizePredicate(op.cond()), thenBlock, elseBlock);
+    builder.CreateCondBr(normalizePredicate(op.cond()), thenBlock, elseBlock, createBranchWeights(op));
     builder.SetInsertPoint(nextBlock);
+    for (size_t i = 0; i < op->numResults(); i++) {
+        auto *phi = builder.CreatePHI(convertType(op->result(i)->type), 2U);
+        phi->addIncoming(findValue(op.thenOp().yieldOp()->operand(i)), newThenBlock);
+        phi->addIncoming(findValue(op.elseOp().yieldOp()->operand(i)), newElseBlock);
+        saveValue(op->result(i), phi);
+    }
 }
 
 void LLVMIRGenerator::visit(const ThenOp &op) {
@@ -425,18 +846,68 @@ void LLVMIRGenerator::visit(const ElseOp &op) {
     visitBody(op);
 }
 
+// Cases are dispatched by the switch instruction, which LLVM lowers to a jump table or a binary search
+void LLVMIRGenerator::visit(const SwitchOp &op) {
+    auto *prevBlock = builder.GetInsertBlock();
+    std::vector<llvm::BasicBlock *> entryBlocks;
+    std::vector<llvm::BasicBlock *> exitBlocks;
+    // Regions producing the results are terminated by YieldOp
+    std::vector<Operation::Ptr> terminators;
+    for (const auto &region : op->body) {
+        auto *block = createBlock();
+        builder.SetInsertPoint(block);
+        visit(region);
+        entryBlocks.push_back(block);
+        exitBlocks.push_back(builder.GetInsertBlock());
+        terminators.push_back(region->body.empty() ? nullptr : region->body.back());
+    }
+    auto *nextBlock = createBlock();
+    for (auto *block : exitBlocks) {
+        builder.SetInsertPoint(block);
+        builder.CreateBr(nextBlock);
+    }
+    builder.SetInsertPoint(prevBlock);
+    auto *value = findValue(op.value());
+    auto *defaultBlock = op.defaultOp() ? entryBlocks.back() : nextBlock;
+    auto *switchInst = builder.CreateSwitch(value, defaultBlock, static_cast<unsigned>(op.numCases()));
+    auto *valueType = llvm::cast<llvm::IntegerType>(value->getType());
+    for (size_t i = 0; i < op.numCases(); i++)
+        switchInst->addCase(llvm::ConstantInt::getSigned(valueType, op.caseOp(i).value()), entryBlocks[i]);
+    builder.SetInsertPoint(nextBlock);
+    for (size_t i = 0; i < op->numResults(); i++) {
+        auto *phi = builder.CreatePHI(convertType(op->result(i)->type), static_cast<unsigned>(exitBlocks.size()));
+        for (size_t j = 0; j < exitBlocks.size(); j++)
+            phi->addIncoming(findValue(terminators[j]->operand(i)), exitBlocks[j]);
+        saveValue(op->result(i), phi);
+    }
+}
+
+void LLVMIRGenerator::visit(const CaseOp &op) {
+    visitBody(op);
+}
+
+void LLVMIRGenerator::visit(const DefaultOp &op) {
+    visitBody(op);
+}
+
 void LLVMIRGenerator::visit(const WhileOp &op) {
+    incrementProfileCounter(op, 0U);
+    auto *prevBlock = builder.GetInsertBlock();
     auto *condBlock = createBlock();
     builder.CreateBr(condBlock);
     builder.SetInsertPoint(condBlock);
+    auto phis = createCarriedPhis(op->operands, op->inwards, op->results, prevBlock);
     auto condOp = op.conditionOp();
     visit(condOp);
     auto *thenBlock = createBlock();
     auto *nextBlock = createBlock();
-    builder.CreateCondBr(normalizePredicate(condOp.terminator()), thenBlock, nextBlock);
+    builder.CreateCondBr(normalizePredicate(condOp.terminator()), thenBlock, nextBlock, createBranchWeights(op));
     builder.SetInsertPoint(thenBlock);
     for (auto it = std::next(op->body.begin()); it != op->body.end(); ++it)
         visit(*it);
+    if (!phis.empty())
+        addCarriedIncomings(phis, op.yieldOp(), builder.GetInsertBlock());
+    incrementProfileCounter(op, 1U);
     builder.CreateBr(condBlock);
     builder.SetInsertPoint(nextBlock);
 }
@@ -447,41 +918,48 @@ void LLVMIRGenerator::visit(const ConditionOp &op) {
 
 void LLVMIRGenerator::visit(const ForOp &op) {
     auto *llvmType = convertType(op.start()->type);
-    auto *allocaI = builder.CreateAlloca(llvmType);
+    auto *allocaI = createEntryAlloca(llvmType);
     builder.CreateStore(findValue(op.start()), allocaI);
+    incrementProfileCounter(op, 0U);
+    auto *prevBlock = builder.GetInsertBlock();
     auto *condBlock = createBlock();
     builder.CreateBr(condBlock);
     builder.SetInsertPoint(condBlock);
+    auto phis = createCarriedPhis(std::vector(std::next(op->operands.begin(), ForOp::numControlOperands),
+                                              op->operands.end()),
+                                  std::vector(std::next(op->inwards.begin()), op->inwards.end()), op->results,
+                                  prevBlock);
     auto *loadedI = builder.CreateLoad(llvmType, allocaI);
     saveValue(op.iterator(), loadedI);
     auto *cond = builder.CreateICmpSLT(loadedI, findValue(op.stop()));
     auto *thenBlock = createBlock();
     auto *nextBlock = createBlock();
-    builder.CreateCondBr(cond, thenBlock, nextBlock);
+    builder.CreateCondBr(cond, thenBlock, nextBlock, createBranchWeights(op));
     builder.SetInsertPoint(thenBlock);
     visitBody(op);
     auto *nextI = builder.CreateAdd(loadedI, findValue(op.step()));
     builder.CreateStore(nextI, allocaI);
+    if (!phis.empty())
+        addCarriedIncomings(phis, op.yieldOp(), builder.GetInsertBlock());
+    incrementProfileCounter(op, 1U);
     builder.CreateBr(condBlock);
     builder.SetInsertPoint(nextBlock);
 }
 
+void LLVMIRGenerator::visit(const YieldOp &) {
+    // Yielded values are bound to the phi nodes by the parent operation
+}
+
 void LLVMIRGenerator::visit(const InputOp &op) {
-    std::string format(getFormatSpecifier(op.dst()->type->as<PointerType>().pointee));
-    builder.CreateCall(getExternalFunction(external::scanf), {getGlobalString(format), findValue(op.dst())});
+    builder.CreateCall(getExternalFunction(external::scanf), {getGlobalString(getFormat(op)), findValue(op.dst())});
 }
 
 void LLVMIRGenerator::visit(const PrintOp &op) {
     std::vector<llvm::Value *> arguments;
     arguments.reserve(op->numOperands() + 1U);
-    arguments.push_back(nullptr);
-    std::string format;
-    format.reserve(4U * op->numOperands());
-    for (const auto &operand : op->operands) {
+    arguments.push_back(getGlobalString(getFormat(op)));
+    for (const auto &operand : op->operands)
         arguments.push_back(findValue(operand));
-        format += getFormatSpecifier(operand->type);
-    }
-    arguments.front() = getGlobalString(format);
     builder.CreateCall(getExternalFunction(external::printf), arguments);
 }
 
@@ -490,6 +968,45 @@ void LLVMIRGenerator::process(const Program &program) {
     eraseDeadBlocks();
 }
 
+void LLVMIRGenerator::process(const Program &program, const std::vector<FunctionOp> &functions,
+                              const SharedStrings &strings) {
+    definedFunctions.clear();
+    for (const auto &funcOp : functions)
+        definedFunctions.insert(funcOp.op.get());
+    sharedStrings = &strings;
+    visit(program.root);
+    eraseDeadBlocks();
+    sharedStrings = nullptr;
+    for (auto &func : llvm::make_early_inc_range(mod.functions())) {
+        if (func.isDeclaration() && func.use_empty())
+            func.eraseFromParent();
+    }
+}
+
+std::vector<LLVMIRGenerator::Ptr> LLVMIRGenerator::processInParallel(const Program &program,
+                                                                     const std::string &moduleName, size_t numShards,
+                                                                     const std::string &profilePath) {
+    SharedStrings strings;
+    collectGlobalStrings(program.root, strings);
+    auto shards = partitionFunctions(program.root, numShards);
+
+    std::vector<Ptr> generators;
+    generators.reserve(shards.size());
+    for (size_t i = 0; i < shards.size(); i++) {
+        generators.emplace_back(std::make_unique<LLVMIRGenerator>(moduleName + "." + std::to_string(i)));
+        if (!profilePath.empty())
+            generators.back()->instrument(profilePath);
+    }
+    {
+        // Every generator owns its LLVM context, so shards do not share any mutable state
+        std::vector<std::jthread> workers;
+        workers.reserve(shards.size());
+        for (size_t i = 0; i < shards.size(); i++)
+            workers.emplace_back([&, i] { generators[i]->process(program, shards[i], strings); });
+    }
+    return generators;
+}
+
 std::string LLVMIRGenerator::dump() const {
     std::string str;
     llvm::raw_string_ostream os(str);
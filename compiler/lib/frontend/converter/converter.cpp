@@ -106,6 +106,23 @@ bool isAssignment(ast::BinaryOperation binOp) {
     return binOp == ast::BinaryOperation::Assign || binOp == ast::BinaryOperation::FAssign;
 }
 
+bool isLogicalOperation(ast::BinaryOperation binOp) {
+    return binOp == ast::BinaryOperation::And || binOp == ast::BinaryOperation::Or;
+}
+
+// Function calls and list accesses are worth a branch to be skipped, while the other operands are cheaper to
+// compute unconditionally. Integer division is never computed unconditionally, since it traps on a zero divisor
+bool hasCostlyOperations(const Node::Ptr &node) {
+    if (node->type == NodeType::FunctionCall || node->type == NodeType::ListAccessor)
+        return true;
+    if (node->type == NodeType::BinaryOperation && node->binOp() == ast::BinaryOperation::Div)
+        return true;
+    for (const auto &child : node->children)
+        if (hasCostlyOperations(child))
+            return true;
+    return false;
+}
+
 void createInputOp(const Node::Ptr &varNameNode, const utils::SourceRef &inputRef, ConverterContext &ctx) {
     const auto *var = ctx.findVariable(varNameNode->str());
     if (var == nullptr) {
@@ -160,6 +177,8 @@ void processFunctionDefinition(const Node::Ptr &node, ConverterContext &ctx) {
     ++it;
     auto funcType = Type::make<FunctionType>(arguments, convertType((*it)->typeId()));
     auto funcOp = ctx.insert<FunctionOp>(node->ref, name, funcType);
+    for (const auto &decorator : node->firstChild()->children)
+        funcOp.addDecorator(decorator->str());
     ctx.goInto(funcOp);
     ctx.enterScope();
     size_t i = 0;
@@ -480,6 +499,39 @@ Value::Ptr visitStringLiteralValue(const Node::Ptr &node, ConverterContext &ctx)
     return ctx.insert<ConstantOp>(node->ref, TypeStorage::strType(), value).result();
 }
 
+// The right operand of the logical operation is computed only if the left one does not decide the result, in which
+// case the result is the right operand converted to bool
+Value::Ptr visitShortCircuitOperation(const Node::Ptr &node, const Value::Ptr &lhs, ConverterContext &ctx) {
+    const auto &rhsNode = node->secondChild();
+    bool isAnd = node->binOp() == ast::BinaryOperation::And;
+    auto ifOp = ctx.insert<IfOp>(node->ref, lhs, true);
+    auto result = ifOp->addResult(TypeStorage::boolType());
+    ctx.goInto(isAnd ? ifOp.elseOp().op : ifOp.thenOp().op);
+    auto decided = ctx.insert<ConstantOp>(node->ref, TypeStorage::boolType(), NativeBool(!isAnd)).result();
+    ctx.insert<YieldOp>(node->ref, std::vector<Value::Ptr>{decided});
+    ctx.goParent();
+    ctx.goInto(isAnd ? ifOp.thenOp().op : ifOp.elseOp().op);
+    auto rhs = visitNode(rhsNode, ctx);
+    if (!rhs) {
+        ctx.pushError(rhsNode, "expression result cannot be used as an operand in this context");
+        throw ctx.errors;
+    }
+    if (!utils::isAny<IntegerType, FloatType>(rhs->type)) {
+        ctx.pushError(node, typeError(rhs->type, "int, bool, float"));
+        throw ctx.errors;
+    }
+    if (!rhs->type->is<BoolType>()) {
+        auto zero = rhs->type->is<FloatType>()
+                        ? ctx.insert<ConstantOp>(rhsNode->ref, rhs->type, NativeFloat(0.0)).result()
+                        : ctx.insert<ConstantOp>(rhsNode->ref, rhs->type, NativeInt(0)).result();
+        rhs = ctx.insert<LogicBinaryOp>(rhsNode->ref, LogicBinOpKind::NotEqual, rhs, zero).result();
+    }
+    ctx.insert<YieldOp>(node->ref, std::vector<Value::Ptr>{rhs});
+    ctx.goParent();
+    ctx.goParent();
+    return result;
+}
+
 Value::Ptr visitBinaryOperation(const Node::Ptr &node, ConverterContext &ctx) {
     auto &lhsNode = node->firstChild();
     auto &rhsNode = node->secondChild();
@@ -490,6 +542,8 @@ Value::Ptr visitBinaryOperation(const Node::Ptr &node, ConverterContext &ctx) {
         return {};
     }
     auto lhs = visitNode(lhsNode, ctx);
+    if (lhs && lhs->type->is<BoolType>() && isLogicalOperation(binOp) && hasCostlyOperations(rhsNode))
+        return visitShortCircuitOperation(node, lhs, ctx);
     auto rhs = visitNode(rhsNode, ctx);
     if (!lhs) {
         ctx.pushError(lhsNode, "expression result cannot be used as an operand in this context");
@@ -81,6 +81,14 @@ TokenList Lexer::processString(const SourceLine &source, ErrorBuffer &errors) {
     auto tokenEnd = tokenBegin;
 
     for (auto i = tokenBegin; i != source.text.end(); i++) {
+        // Decorator sign is only allowed at the beginning of line
+        if (*i == '@' && i == source.text.begin() + numSpaces) {
+            tokens.emplace_back(Special::At, source.makeRef(i));
+            tokenBegin = i + 1;
+            tokenEnd = i + 1;
+            continue;
+        }
+
         const char *j = allowedChars;
         for (; *j != '\0'; j++) {
             if (*i == *j)
@@ -108,6 +108,8 @@ const char *const specialToString(Special spec) {
         return "Arrow";
     case Special::Colon:
         return "Colon";
+    case Special::At:
+        return "At";
     case Special::EndOfExpression:
         return "EndOfExpression";
     case Special::Indentation:
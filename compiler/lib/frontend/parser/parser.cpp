@@ -9,6 +9,7 @@
 #include <string>
 #include <unordered_map>
 #include <variant>
+#include <vector>
 
 #include "compiler/ast/node.hpp"
 #include "compiler/ast/node_type.hpp"
@@ -687,15 +688,38 @@ void parseIfStatement(ParserContext &ctx) {
 }
 
 void parseProgramRoot(ParserContext &ctx) {
+    std::vector<const Token *> decorators;
     while (ctx.tokenIter != ctx.tokenEnd) {
-        if (ctx.token().is(Keyword::Definition)) {
-            ctx.node = ctx.pushChildNode(NodeType::FunctionDefinition);
+        if (ctx.token().is(Special::At)) {
+            ctx.goNextToken();
+            if (ctx.token().type != TokenType::Identifier) {
+                ctx.pushError("Decorator name was expected");
+                ctx.goNextExpression();
+                continue;
+            }
+            decorators.push_back(&ctx.token());
+            ctx.goNextToken();
+            if (!ctx.token().is(Special::EndOfExpression))
+                ctx.pushError("End of line was expected after decorator");
+            ctx.goNextExpression();
+        } else if (ctx.token().is(Keyword::Definition)) {
+            auto funcNode = ctx.pushChildNode(NodeType::FunctionDefinition);
+            ctx.node = funcNode;
             ctx.propagate();
+            // Decorators are attached to the function name to keep positions of the definition parts
+            for (const auto *decorator : decorators) {
+                auto decoratorNode =
+                    ParserContext::pushChildNode(funcNode->firstChild(), NodeType::FunctionDecorator, decorator->ref);
+                decoratorNode->value = decorator->id();
+            }
+            decorators.clear();
         } else {
             ctx.pushError("Function definition was expected");
             return;
         }
     }
+    if (!decorators.empty())
+        ctx.errors.push<ParserError>(*decorators.back(), "Function definition was expected after decorator");
 }
 
 void parseReturnStatement(ParserContext &ctx) {
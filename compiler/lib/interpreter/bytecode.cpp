@@ -0,0 +1,61 @@
+#include "bytecode.hpp"
+
+#include <cstddef>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+using namespace optree::interpreter;
+
+namespace {
+
+void dumpOperand(std::ostream &stream, uint32_t operand, bool &first) {
+    if (operand == Instruction::noRegister)
+        return;
+    stream << (first ? " " : ", ") << operand;
+    first = false;
+}
+
+} // namespace
+
+const char *optree::interpreter::opcodeName(Opcode opcode) {
+    switch (opcode) {
+#define INTERPRETER_OPCODE_NAME(NAME)                                                                                  \
+    case Opcode::NAME:                                                                                                 \
+        return #NAME;
+        INTERPRETER_OPCODES(INTERPRETER_OPCODE_NAME)
+#undef INTERPRETER_OPCODE_NAME
+    }
+    return "Unknown";
+}
+
+const Function *Bytecode::lookup(const std::string &name) const {
+    for (const auto &function : functions) {
+        if (function.name == name)
+            return &function;
+    }
+    return nullptr;
+}
+
+void Bytecode::dump(std::ostream &stream) const {
+    for (const auto &function : functions) {
+        stream << function.name << " (arguments: " << function.numArguments
+               << ", registers: " << function.numRegisters
+               << ", cells: " << function.frame.size() - function.numRegisters << ")\n";
+        for (size_t i = 0; i < function.code.size(); i++) {
+            const auto &inst = function.code[i];
+            stream << "  " << i << ": " << opcodeName(inst.opcode);
+            bool first = true;
+            dumpOperand(stream, inst.a, first);
+            dumpOperand(stream, inst.b, first);
+            dumpOperand(stream, inst.c, first);
+            stream << '\n';
+        }
+    }
+}
+
+std::string Bytecode::dump() const {
+    std::stringstream str;
+    dump(str);
+    return str.str();
+}
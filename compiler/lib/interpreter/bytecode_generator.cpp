@@ -0,0 +1,520 @@
+#include "bytecode_generator.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/definitions.hpp"
+#include "compiler/optree/operation.hpp"
+#include "compiler/optree/program.hpp"
+#include "compiler/optree/types.hpp"
+#include "compiler/optree/value.hpp"
+
+#include "bytecode.hpp"
+
+using namespace optree;
+using namespace optree::interpreter;
+
+namespace {
+
+using FunctionIndices = std::unordered_map<std::string, uint32_t>;
+
+class FunctionGenerator {
+    const FunctionIndices &functionIndices;
+    Bytecode &bytecode;
+    Function &function;
+    std::unordered_map<const Value *, uint32_t> registers;
+    std::vector<std::pair<uint32_t, Register>> constants;
+    uint32_t numCells = 0;
+    // Registers receiving the operands of YieldOp terminating the innermost region
+    std::vector<std::vector<uint32_t>> yieldTargets;
+
+    uint32_t newRegister() {
+        return function.numRegisters++;
+    }
+
+    uint32_t define(const Value::Ptr &value) {
+        auto reg = newRegister();
+        registers[value.get()] = reg;
+        return reg;
+    }
+
+    uint32_t find(const Value::Ptr &value) const {
+        auto it = registers.find(value.get());
+        if (it == registers.end())
+            throw InterpreterError("value is used before its definition in function " + function.name);
+        return it->second;
+    }
+
+    uint32_t constant(Register value) {
+        auto reg = newRegister();
+        constants.emplace_back(reg, value);
+        return reg;
+    }
+
+    uint32_t here() const {
+        return static_cast<uint32_t>(function.code.size());
+    }
+
+    size_t emit(Opcode opcode, uint32_t a = Instruction::noRegister, uint32_t b = Instruction::noRegister,
+                uint32_t c = Instruction::noRegister) {
+        function.code.push_back({opcode, a, b, c});
+        return function.code.size() - 1U;
+    }
+
+    // Copies values to the registers as a parallel assignment, so the values swapped between loop iterations
+    // are not clobbered
+    void emitMoves(const std::vector<uint32_t> &targets, const std::vector<Value::Ptr> &values) {
+        if (values.size() < targets.size())
+            throw InterpreterError("not enough values are yielded in function " + function.name);
+        std::vector<uint32_t> sources;
+        for (size_t i = 0; i < targets.size(); i++)
+            sources.push_back(find(values[i]));
+        std::unordered_set<uint32_t> targetSet(targets.begin(), targets.end());
+        bool overlaps = false;
+        for (size_t i = 0; i < targets.size(); i++)
+            overlaps |= sources[i] != targets[i] && targetSet.contains(sources[i]);
+        if (overlaps) {
+            for (auto &source : sources) {
+                auto temp = newRegister();
+                emit(Opcode::Move, temp, source);
+                source = temp;
+            }
+        }
+        for (size_t i = 0; i < targets.size(); i++) {
+            if (sources[i] != targets[i])
+                emit(Opcode::Move, targets[i], sources[i]);
+        }
+    }
+
+    void generateRegion(const Operation::Ptr &region, const std::vector<uint32_t> &targets, size_t skip = 0U) {
+        yieldTargets.push_back(targets);
+        for (auto it = std::next(region->body.begin(), static_cast<ptrdiff_t>(skip)); it != region->body.end(); ++it)
+            generate(*it);
+        yieldTargets.pop_back();
+    }
+
+    void generate(const ConstantOp &op) {
+        const auto &type = op.result()->type;
+        Register value{};
+        if (type->is<BoolType>())
+            value.i = op.value().as<NativeBool>() ? 1 : 0;
+        else if (type->is<IntegerType>())
+            value.i = op.value().as<NativeInt>();
+        else if (type->is<FloatType>())
+            value.f = op.value().as<NativeFloat>();
+        else if (type->is<StrType>())
+            value.s = bytecode.strings.emplace_back(op.value().as<NativeStr>()).c_str();
+        else
+            throw InterpreterError("unsupported constant type: " + type->dump());
+        constants.emplace_back(define(op.result()), value);
+    }
+
+    void generate(const ArithBinaryOp &op) {
+        Opcode opcode;
+        switch (op.kind()) {
+        case ArithBinOpKind::AddI:
+            opcode = Opcode::AddI;
+            break;
+        case ArithBinOpKind::SubI:
+            opcode = Opcode::SubI;
+            break;
+        case ArithBinOpKind::MulI:
+            opcode = Opcode::MulI;
+            break;
+        case ArithBinOpKind::DivI:
+            opcode = Opcode::DivI;
+            break;
+        case ArithBinOpKind::ShlI:
+            opcode = Opcode::ShlI;
+            break;
+        case ArithBinOpKind::ShrI:
+            opcode = Opcode::ShrI;
+            break;
+        case ArithBinOpKind::AddF:
+            opcode = Opcode::AddF;
+            break;
+        case ArithBinOpKind::SubF:
+            opcode = Opcode::SubF;
+            break;
+        case ArithBinOpKind::MulF:
+            opcode = Opcode::MulF;
+            break;
+        case ArithBinOpKind::DivF:
+            opcode = Opcode::DivF;
+            break;
+        default:
+            throw InterpreterError("unexpected kind in ArithBinaryOp");
+        }
+        auto lhs = find(op.lhs());
+        auto rhs = find(op.rhs());
+        emit(opcode, define(op.result()), lhs, rhs);
+    }
+
+    void generate(const LogicBinaryOp &op) {
+        bool isInteger = op.lhs()->type->is<IntegerType>();
+        Opcode opcode;
+        switch (op.kind()) {
+        case LogicBinOpKind::Equal:
+            opcode = isInteger ? Opcode::EqualI : Opcode::EqualF;
+            break;
+        case LogicBinOpKind::NotEqual:
+            opcode = isInteger ? Opcode::NotEqualI : Opcode::NotEqualF;
+            break;
+        case LogicBinOpKind::AndI:
+            opcode = Opcode::AndI;
+            break;
+        case LogicBinOpKind::OrI:
+            opcode = Opcode::OrI;
+            break;
+        case LogicBinOpKind::LessI:
+            opcode = Opcode::LessI;
+            break;
+        case LogicBinOpKind::GreaterI:
+            opcode = Opcode::GreaterI;
+            break;
+        case LogicBinOpKind::LessEqualI:
+            opcode = Opcode::LessEqualI;
+            break;
+        case LogicBinOpKind::GreaterEqualI:
+            opcode = Opcode::GreaterEqualI;
+            break;
+        case LogicBinOpKind::LessF:
+            opcode = Opcode::LessF;
+            break;
+        case LogicBinOpKind::GreaterF:
+            opcode = Opcode::GreaterF;
+            break;
+        case LogicBinOpKind::LessEqualF:
+            opcode = Opcode::LessEqualF;
+            break;
+        case LogicBinOpKind::GreaterEqualF:
+            opcode = Opcode::GreaterEqualF;
+            break;
+        default:
+            throw InterpreterError("unexpected kind in LogicBinaryOp");
+        }
+        auto lhs = find(op.lhs());
+        auto rhs = find(op.rhs());
+        emit(opcode, define(op.result()), lhs, rhs);
+    }
+
+    void generate(const ArithCastOp &op) {
+        auto value = find(op.value());
+        auto result = define(op.result());
+        const auto &type = op.result()->type;
+        switch (op.kind()) {
+        case ArithCastOpKind::IntToFloat:
+            emit(Opcode::IntToFloat, result, value);
+            return;
+        case ArithCastOpKind::FloatToInt:
+            emit(Opcode::FloatToInt, result, value);
+            return;
+        case ArithCastOpKind::TruncI:
+            if (type->bitWidth() < 64U) {
+                emit(Opcode::TruncI, result, value, type->bitWidth());
+                return;
+            }
+            break;
+        case ArithCastOpKind::TruncF:
+            if (type->bitWidth() <= 32U) {
+                emit(Opcode::TruncF, result, value);
+                return;
+            }
+            break;
+        case ArithCastOpKind::ExtI:
+        case ArithCastOpKind::ExtF:
+            // Registers always hold the extended values
+            break;
+        default:
+            throw InterpreterError("unexpected kind in ArithCastOp");
+        }
+        emit(Opcode::Move, result, value);
+    }
+
+    void generate(const ArithUnaryOp &op) {
+        Opcode opcode;
+        switch (op.kind()) {
+        case ArithUnaryOpKind::NegI:
+            opcode = Opcode::NegI;
+            break;
+        case ArithUnaryOpKind::NegF:
+            opcode = Opcode::NegF;
+            break;
+        default:
+            throw InterpreterError("unexpected kind in ArithUnaryOp");
+        }
+        auto value = find(op.value());
+        emit(opcode, define(op.result()), value);
+    }
+
+    void generate(const LogicUnaryOp &op) {
+        if (op.kind() != LogicUnaryOpKind::Not)
+            throw InterpreterError("unexpected kind in LogicUnaryOp");
+        auto value = find(op.value());
+        emit(Opcode::NotI, define(op.result()), value);
+    }
+
+    // Fixed-size allocations are placed in the frame once per call, as the entry allocas of the LLVM IR codegen
+    void generate(const AllocateOp &op) {
+        const auto &type = op.result()->type->as<PointerType>();
+        if (type.numElements == PointerType::dynamic) {
+            auto size = find(op.dynamicSize());
+            emit(Opcode::Allocate, define(op.result()), size);
+            return;
+        }
+        emit(Opcode::FrameAddress, define(op.result()), numCells);
+        numCells += static_cast<uint32_t>(type.numElements);
+    }
+
+    void generate(const HeapAllocateOp &op) {
+        const auto &type = op.result()->type->as<PointerType>();
+        uint32_t size = 0;
+        if (type.numElements == PointerType::dynamic)
+            size = find(op.dynamicSize());
+        else
+            size = constant({.i = static_cast<int64_t>(type.numElements)});
+        emit(Opcode::HeapAllocate, define(op.result()), size);
+    }
+
+    void generate(const LoadOp &op) {
+        auto src = find(op.src());
+        if (auto offset = op.offset()) {
+            auto index = find(offset);
+            emit(Opcode::LoadAt, define(op.result()), src, index);
+        } else {
+            emit(Opcode::Load, define(op.result()), src);
+        }
+    }
+
+    void generate(const StoreOp &op) {
+        auto dst = find(op.dst());
+        auto value = find(op.valueToStore());
+        if (auto offset = op.offset())
+            emit(Opcode::StoreAt, dst, value, find(offset));
+        else
+            emit(Opcode::Store, dst, value);
+    }
+
+    void generate(const FunctionCallOp &op) {
+        auto it = functionIndices.find(op.name());
+        if (it == functionIndices.end())
+            throw InterpreterError("call to undefined function: " + op.name());
+        auto offset = static_cast<uint32_t>(function.arguments.size());
+        for (const auto &operand : op->operands)
+            function.arguments.push_back(find(operand));
+        auto result = op->numResults() != 0U ? define(op.result()) : Instruction::noRegister;
+        emit(Opcode::Call, result, it->second, offset);
+    }
+
+    void generate(const ReturnOp &op) {
+        if (op->numOperands() == 0U)
+            emit(Opcode::ReturnVoid);
+        else
+            emit(Opcode::Return, find(op.value()));
+    }
+
+    void generate(const IfOp &op) {
+        auto jumpToElse = emit(Opcode::JumpIfNot, find(op.cond()));
+        std::vector<uint32_t> results;
+        for (const auto &result : op->results)
+            results.push_back(define(result));
+        generateRegion(op.thenOp().op, results);
+        if (auto elseOp = op.elseOp()) {
+            auto jumpToEnd = emit(Opcode::Jump);
+            function.code[jumpToElse].b = here();
+            generateRegion(elseOp.op, results);
+            function.code[jumpToEnd].a = here();
+        } else {
+            function.code[jumpToElse].b = here();
+        }
+    }
+
+    // Cases are compared one by one, as the bytecode has no indirect jumps
+    void generate(const SwitchOp &op) {
+        auto value = find(op.value());
+        std::vector<uint32_t> results;
+        for (const auto &result : op->results)
+            results.push_back(define(result));
+        std::vector<size_t> jumpsToEnd;
+        for (size_t i = 0; i < op.numCases(); i++) {
+            auto caseOp = op.caseOp(i);
+            auto matches = newRegister();
+            emit(Opcode::EqualI, matches, value, constant({.i = caseOp.value()}));
+            auto jumpToNext = emit(Opcode::JumpIfNot, matches);
+            generateRegion(caseOp.op, results);
+            jumpsToEnd.push_back(emit(Opcode::Jump));
+            function.code[jumpToNext].b = here();
+        }
+        if (auto defaultOp = op.defaultOp())
+            generateRegion(defaultOp.op, results);
+        for (auto jumpToEnd : jumpsToEnd)
+            function.code[jumpToEnd].a = here();
+    }
+
+    // Loop-carried values are kept in the registers of the inwards, which also serve as the loop results
+    std::vector<uint32_t> defineCarried(const Operation::Ptr &op, size_t firstInward, size_t firstOperand) {
+        std::vector<uint32_t> carried;
+        for (size_t i = firstInward; i < op->numInwards(); i++)
+            carried.push_back(define(op->inward(i)));
+        emitMoves(carried, std::vector(std::next(op->operands.begin(), static_cast<ptrdiff_t>(firstOperand)),
+                                       op->operands.end()));
+        for (size_t i = 0; i < op->numResults() && i < carried.size(); i++)
+            registers[op->result(i).get()] = carried[i];
+        return carried;
+    }
+
+    void generate(const WhileOp &op) {
+        auto carried = defineCarried(op.op, 0U, 0U);
+        auto condition = here();
+        auto conditionOp = op.conditionOp();
+        generateRegion(conditionOp.op, {});
+        auto jumpToEnd = emit(Opcode::JumpIfNot, find(conditionOp.terminator()));
+        generateRegion(op.op, carried, 1U);
+        emit(Opcode::Jump, condition);
+        function.code[jumpToEnd].b = here();
+    }
+
+    void generate(const ForOp &op) {
+        auto iterator = define(op.iterator());
+        auto stop = find(op.stop());
+        auto step = find(op.step());
+        emit(Opcode::Move, iterator, find(op.start()));
+        auto carried = defineCarried(op.op, 1U, ForOp::numControlOperands);
+        auto condition = here();
+        auto jumpToEnd = emit(Opcode::JumpIfGreaterEqualI, iterator, stop);
+        generateRegion(op.op, carried);
+        emit(Opcode::AddI, iterator, iterator, step);
+        emit(Opcode::Jump, condition);
+        function.code[jumpToEnd].c = here();
+    }
+
+    void generate(const YieldOp &op) {
+        if (yieldTargets.empty())
+            throw InterpreterError("unexpected YieldOp in function " + function.name);
+        emitMoves(yieldTargets.back(), op->operands);
+    }
+
+    void generate(const PrintOp &op) {
+        for (const auto &operand : op->operands) {
+            const auto &type = operand->type;
+            if (type->is<NoneType>())
+                emit(Opcode::PrintNone);
+            else if (type->is<IntegerType>())
+                emit(Opcode::PrintI, find(operand));
+            else if (type->is<FloatType>())
+                emit(Opcode::PrintF, find(operand));
+            else if (type->is<StrType>())
+                emit(Opcode::PrintS, find(operand));
+            else if (type->is<PointerType>())
+                emit(Opcode::PrintP, find(operand));
+            else
+                throw InterpreterError("unsupported type to print: " + type->dump());
+        }
+    }
+
+    void generate(const InputOp &op) {
+        const auto &type = op.dst()->type->as<PointerType>().pointee;
+        if (type->is<IntegerType>())
+            emit(Opcode::InputI, find(op.dst()));
+        else if (type->is<FloatType>())
+            emit(Opcode::InputF, find(op.dst()));
+        else if (type->is<StrType>())
+            emit(Opcode::InputS, find(op.dst()));
+        else
+            throw InterpreterError("unsupported type to input: " + type->dump());
+    }
+
+    void generate(const Operation::Ptr &op) {
+        // Registers hold scalars only, so the vectorized loops are not supported
+        auto isVector = [](const Value::Ptr &value) { return value->type->is<VectorType>(); };
+        if (std::ranges::any_of(op->operands, isVector) || std::ranges::any_of(op->results, isVector))
+            throw InterpreterError("unsupported vector operation in function " + function.name);
+        if (auto concreteOp = op->as<ConstantOp>())
+            return generate(concreteOp);
+        if (auto concreteOp = op->as<ArithBinaryOp>())
+            return generate(concreteOp);
+        if (auto concreteOp = op->as<LogicBinaryOp>())
+            return generate(concreteOp);
+        if (auto concreteOp = op->as<ArithCastOp>())
+            return generate(concreteOp);
+        if (auto concreteOp = op->as<ArithUnaryOp>())
+            return generate(concreteOp);
+        if (auto concreteOp = op->as<LogicUnaryOp>())
+            return generate(concreteOp);
+        if (auto concreteOp = op->as<AllocateOp>())
+            return generate(concreteOp);
+        if (auto concreteOp = op->as<HeapAllocateOp>())
+            return generate(concreteOp);
+        if (auto concreteOp = op->as<DeallocateOp>()) {
+            emit(Opcode::Deallocate, find(concreteOp.ptr()));
+            return;
+        }
+        if (auto concreteOp = op->as<LoadOp>())
+            return generate(concreteOp);
+        if (auto concreteOp = op->as<StoreOp>())
+            return generate(concreteOp);
+        if (auto concreteOp = op->as<FunctionCallOp>())
+            return generate(concreteOp);
+        if (auto concreteOp = op->as<ReturnOp>())
+            return generate(concreteOp);
+        if (auto concreteOp = op->as<IfOp>())
+            return generate(concreteOp);
+        if (auto concreteOp = op->as<SwitchOp>())
+            return generate(concreteOp);
+        if (auto concreteOp = op->as<WhileOp>())
+            return generate(concreteOp);
+        if (auto concreteOp = op->as<ForOp>())
+            return generate(concreteOp);
+        if (auto concreteOp = op->as<YieldOp>())
+            return generate(concreteOp);
+        if (auto concreteOp = op->as<PrintOp>())
+            return generate(concreteOp);
+        if (auto concreteOp = op->as<InputOp>())
+            return generate(concreteOp);
+        throw InterpreterError("unsupported operation in bytecode: " + std::string(op->name));
+    }
+
+  public:
+    FunctionGenerator(const FunctionIndices &functionIndices, Bytecode &bytecode, Function &function)
+        : functionIndices(functionIndices), bytecode(bytecode), function(function){};
+
+    void process(const FunctionOp &op) {
+        for (const auto &inward : op->inwards)
+            define(inward);
+        function.numArguments = function.numRegisters;
+        generateRegion(op.op, {});
+        // Functions returning nothing may omit the terminating ReturnOp
+        emit(Opcode::ReturnVoid);
+        function.frame.resize(function.numRegisters + numCells, Register{});
+        for (const auto &[reg, value] : constants)
+            function.frame[reg] = value;
+    }
+};
+
+} // namespace
+
+Bytecode optree::interpreter::generateBytecode(const Program &program) {
+    Bytecode bytecode;
+    FunctionIndices functionIndices;
+    std::vector<FunctionOp> functionOps;
+    for (const auto &op : program.root->body) {
+        if (auto funcOp = op->as<FunctionOp>()) {
+            functionIndices.emplace(funcOp.name(), static_cast<uint32_t>(functionOps.size()));
+            functionOps.push_back(funcOp);
+        }
+    }
+    bytecode.functions.resize(functionOps.size());
+    for (size_t i = 0; i < functionOps.size(); i++) {
+        auto &function = bytecode.functions[i];
+        function.name = functionOps[i].name();
+        FunctionGenerator(functionIndices, bytecode, function).process(functionOps[i]);
+    }
+    return bytecode;
+}
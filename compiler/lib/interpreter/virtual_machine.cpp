@@ -0,0 +1,342 @@
+#include "virtual_machine.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "compiler/utils/platform.hpp"
+
+#include "bytecode.hpp"
+
+// Threaded dispatch jumps from each handler directly to the next one, which is notably faster than the switch
+#ifdef COMPILER_TOOLCHAIN_GCC_COMPATIBLE
+#define INTERPRETER_COMPUTED_GOTO
+#endif
+
+using namespace optree::interpreter;
+
+namespace {
+
+constexpr size_t stackChunkSize = 1U << 16;
+
+int64_t wrap(uint64_t value) {
+    return static_cast<int64_t>(value);
+}
+
+// Conversion of the out-of-range values gives the same result as cvttsd2si instruction
+int64_t floatToInt(double value) {
+    constexpr double limit = 9223372036854775808.0;
+    if (!(value >= -limit && value < limit))
+        return INT64_MIN;
+    return static_cast<int64_t>(value);
+}
+
+template <typename T>
+void printFormatted(std::ostream &output, const char *format, T value) {
+    char buffer[64];
+    int size = std::snprintf(buffer, sizeof(buffer), format, value);
+    if (size < 0)
+        return;
+    if (static_cast<size_t>(size) < sizeof(buffer)) {
+        output.write(buffer, size);
+        return;
+    }
+    // Large floats take up to hundreds of digits in the fixed notation
+    std::string text(static_cast<size_t>(size), '\0');
+    std::snprintf(text.data(), text.size() + 1U, format, value);
+    output << text;
+}
+
+} // namespace
+
+VirtualMachine::Stack::Stack() : chunks(), chunk(0), top(0) {
+    chunks.emplace_back(stackChunkSize);
+}
+
+Register *VirtualMachine::Stack::allocate(size_t size) {
+    if (top + size > chunks[chunk].size()) {
+        chunk++;
+        top = 0;
+        if (chunk == chunks.size())
+            chunks.emplace_back(std::max(stackChunkSize, size));
+        else if (chunks[chunk].size() < size)
+            chunks[chunk] = std::vector<Register>(size);
+    }
+    auto *cells = chunks[chunk].data() + top;
+    top += size;
+    return cells;
+}
+
+VirtualMachine::VirtualMachine(const Bytecode &bytecode, std::istream &input, std::ostream &output, size_t maxDepth)
+    : bytecode(bytecode), input(input), output(output), maxDepth(maxDepth) {
+}
+
+Register *VirtualMachine::enter(const Function &function) {
+    auto *frame = stack.allocate(function.frame.size());
+    std::copy(function.frame.begin(), function.frame.end(), frame);
+    return frame;
+}
+
+Register VirtualMachine::call(const std::string &name, const std::vector<Register> &arguments) {
+    const auto *function = bytecode.lookup(name);
+    if (function == nullptr)
+        throw InterpreterError("call to undefined function: " + name);
+    if (arguments.size() != function->numArguments)
+        throw InterpreterError("wrong number of arguments in the call to function: " + name);
+
+    std::vector<CallRecord> calls;
+    auto entryMark = stack.mark();
+    Register *r = enter(*function);
+    std::copy(arguments.begin(), arguments.end(), r);
+    const Instruction *code = function->code.data();
+    const Instruction *pc = code;
+    Register result{};
+
+#ifdef INTERPRETER_COMPUTED_GOTO
+#define INTERPRETER_LABEL_ADDRESS(NAME) &&label##NAME,
+    static const void *const dispatchTable[] = {INTERPRETER_OPCODES(INTERPRETER_LABEL_ADDRESS)};
+#undef INTERPRETER_LABEL_ADDRESS
+#define DISPATCH() goto *dispatchTable[static_cast<size_t>(pc->opcode)]
+#define CASE(NAME) label##NAME
+#else
+#define DISPATCH() goto dispatch
+#define CASE(NAME) case Opcode::NAME
+#endif
+#define NEXT()                                                                                                         \
+    do {                                                                                                               \
+        ++pc;                                                                                                          \
+        DISPATCH();                                                                                                    \
+    } while (0)
+#define BINARY(NAME, FIELD, EXPR)                                                                                      \
+    CASE(NAME) : {                                                                                                     \
+        auto lhs = r[pc->b].FIELD;                                                                                     \
+        auto rhs = r[pc->c].FIELD;                                                                                     \
+        EXPR;                                                                                                          \
+        NEXT();                                                                                                        \
+    }
+
+#ifdef INTERPRETER_COMPUTED_GOTO
+    DISPATCH();
+#else
+dispatch:
+    switch (pc->opcode) {
+#endif
+    CASE(Move) : {
+        r[pc->a] = r[pc->b];
+        NEXT();
+    }
+    BINARY(AddI, i, r[pc->a].i = wrap(static_cast<uint64_t>(lhs) + static_cast<uint64_t>(rhs)))
+    BINARY(SubI, i, r[pc->a].i = wrap(static_cast<uint64_t>(lhs) - static_cast<uint64_t>(rhs)))
+    BINARY(MulI, i, r[pc->a].i = wrap(static_cast<uint64_t>(lhs) * static_cast<uint64_t>(rhs)))
+    BINARY(DivI, i, {
+        if (rhs == 0)
+            throw InterpreterError("division by zero in function " + function->name);
+        r[pc->a].i = rhs == -1 ? wrap(0U - static_cast<uint64_t>(lhs)) : lhs / rhs;
+    })
+    BINARY(ShlI, i, r[pc->a].i = wrap(static_cast<uint64_t>(lhs) << (rhs & 63)))
+    BINARY(ShrI, i, r[pc->a].i = lhs >> (rhs & 63))
+    BINARY(AddF, f, r[pc->a].f = lhs + rhs)
+    BINARY(SubF, f, r[pc->a].f = lhs - rhs)
+    BINARY(MulF, f, r[pc->a].f = lhs * rhs)
+    BINARY(DivF, f, r[pc->a].f = lhs / rhs)
+    BINARY(EqualI, i, r[pc->a].i = lhs == rhs)
+    BINARY(NotEqualI, i, r[pc->a].i = lhs != rhs)
+    BINARY(LessI, i, r[pc->a].i = lhs < rhs)
+    BINARY(GreaterI, i, r[pc->a].i = lhs > rhs)
+    BINARY(LessEqualI, i, r[pc->a].i = lhs <= rhs)
+    BINARY(GreaterEqualI, i, r[pc->a].i = lhs >= rhs)
+    BINARY(EqualF, f, r[pc->a].i = lhs == rhs)
+    // Ordered comparison as in the LLVM IR codegen, which is false if any of the operands is NaN
+    BINARY(NotEqualF, f, r[pc->a].i = lhs < rhs || lhs > rhs)
+    BINARY(LessF, f, r[pc->a].i = lhs < rhs)
+    BINARY(GreaterF, f, r[pc->a].i = lhs > rhs)
+    BINARY(LessEqualF, f, r[pc->a].i = lhs <= rhs)
+    BINARY(GreaterEqualF, f, r[pc->a].i = lhs >= rhs)
+    BINARY(AndI, i, r[pc->a].i = lhs != 0 && rhs != 0)
+    BINARY(OrI, i, r[pc->a].i = lhs != 0 || rhs != 0)
+    CASE(NotI) : {
+        r[pc->a].i = r[pc->b].i == 0;
+        NEXT();
+    }
+    CASE(NegI) : {
+        r[pc->a].i = wrap(0U - static_cast<uint64_t>(r[pc->b].i));
+        NEXT();
+    }
+    CASE(NegF) : {
+        r[pc->a].f = -r[pc->b].f;
+        NEXT();
+    }
+    CASE(IntToFloat) : {
+        r[pc->a].f = static_cast<double>(r[pc->b].i);
+        NEXT();
+    }
+    CASE(FloatToInt) : {
+        r[pc->a].i = floatToInt(r[pc->b].f);
+        NEXT();
+    }
+    CASE(TruncI) : {
+        auto shift = 64U - pc->c;
+        r[pc->a].i = wrap(static_cast<uint64_t>(r[pc->b].i) << shift) >> shift;
+        NEXT();
+    }
+    CASE(TruncF) : {
+        r[pc->a].f = static_cast<double>(static_cast<float>(r[pc->b].f));
+        NEXT();
+    }
+    CASE(Jump) : {
+        pc = code + pc->a;
+        DISPATCH();
+    }
+    CASE(JumpIfNot) : {
+        if (r[pc->a].i == 0) {
+            pc = code + pc->b;
+            DISPATCH();
+        }
+        NEXT();
+    }
+    CASE(JumpIfGreaterEqualI) : {
+        if (r[pc->a].i >= r[pc->b].i) {
+            pc = code + pc->c;
+            DISPATCH();
+        }
+        NEXT();
+    }
+    CASE(Call) : {
+        if (calls.size() >= maxDepth)
+            throw InterpreterError("maximum recursion depth exceeded in function " + function->name);
+        const auto &callee = bytecode.functions[pc->b];
+        auto mark = stack.mark();
+        Register *frame = enter(callee);
+        const auto *args = function->arguments.data() + pc->c;
+        for (uint32_t i = 0; i < callee.numArguments; i++)
+            frame[i] = r[args[i]];
+        calls.push_back({function, pc, r, mark});
+        function = &callee;
+        code = callee.code.data();
+        pc = code;
+        r = frame;
+        DISPATCH();
+    }
+    CASE(Return) : {
+        result = r[pc->a];
+        goto ret;
+    }
+    CASE(ReturnVoid) : {
+        result = Register{};
+        goto ret;
+    }
+    CASE(FrameAddress) : {
+        r[pc->a].p = r + function->numRegisters + pc->b;
+        NEXT();
+    }
+    CASE(Allocate) : {
+        auto size = r[pc->b].i;
+        if (size < 0)
+            throw InterpreterError("negative allocation size in function " + function->name);
+        auto *cells = stack.allocate(static_cast<size_t>(size));
+        std::fill_n(cells, size, Register{});
+        r[pc->a].p = cells;
+        NEXT();
+    }
+    CASE(HeapAllocate) : {
+        auto size = r[pc->b].i;
+        if (size < 0)
+            throw InterpreterError("negative allocation size in function " + function->name);
+        auto cells = std::make_unique<Register[]>(static_cast<size_t>(size));
+        r[pc->a].p = cells.get();
+        heap.emplace(cells.get(), std::move(cells));
+        NEXT();
+    }
+    CASE(Deallocate) : {
+        if (r[pc->a].p != nullptr && heap.erase(r[pc->a].p) == 0U)
+            throw InterpreterError("deallocation of memory not allocated on the heap in function " + function->name);
+        NEXT();
+    }
+    CASE(Load) : {
+        r[pc->a] = *r[pc->b].p;
+        NEXT();
+    }
+    CASE(LoadAt) : {
+        r[pc->a] = r[pc->b].p[r[pc->c].i];
+        NEXT();
+    }
+    CASE(Store) : {
+        *r[pc->a].p = r[pc->b];
+        NEXT();
+    }
+    CASE(StoreAt) : {
+        r[pc->a].p[r[pc->c].i] = r[pc->b];
+        NEXT();
+    }
+    CASE(PrintI) : {
+        printFormatted(output, "%lld", static_cast<long long>(r[pc->a].i));
+        NEXT();
+    }
+    CASE(PrintF) : {
+        printFormatted(output, "%lf", r[pc->a].f);
+        NEXT();
+    }
+    CASE(PrintS) : {
+        output << r[pc->a].s;
+        NEXT();
+    }
+    CASE(PrintP) : {
+        printFormatted(output, "%p", static_cast<const void *>(r[pc->a].p));
+        NEXT();
+    }
+    CASE(PrintNone) : {
+        output << "None";
+        NEXT();
+    }
+    CASE(InputI) : {
+        long long value = 0;
+        if (input >> value)
+            r[pc->a].p->i = value;
+        NEXT();
+    }
+    CASE(InputF) : {
+        double value = 0.0;
+        if (input >> value)
+            r[pc->a].p->f = value;
+        NEXT();
+    }
+    CASE(InputS) : {
+        std::string value;
+        if (input >> value)
+            r[pc->a].p->s = inputStrings.emplace_back(std::move(value)).c_str();
+        NEXT();
+    }
+#ifndef INTERPRETER_COMPUTED_GOTO
+    }
+#endif
+
+ret:
+    if (calls.empty()) {
+        stack.release(entryMark);
+        output.flush();
+        return result;
+    }
+    {
+        const auto &caller = calls.back();
+        stack.release(caller.mark);
+        function = caller.function;
+        code = function->code.data();
+        pc = caller.pc;
+        r = caller.frame;
+        calls.pop_back();
+        if (pc->a != Instruction::noRegister)
+            r[pc->a] = result;
+    }
+    NEXT();
+
+#undef BINARY
+#undef NEXT
+#undef CASE
+#undef DISPATCH
+}
@@ -1,5 +1,7 @@
 #include "adaptors.hpp"
 
+#include <cstddef>
+#include <iterator>
 #include <string>
 #include <vector>
 
@@ -61,6 +63,16 @@ void BinaryOp::init(const Type::Ptr &resultType, const Value::Ptr &lhs, const Va
     op->addOperand(rhs);
 }
 
+void CaseOp::init(NativeInt value) {
+    op->addAttr(value);
+}
+
+YieldOp CaseOp::yieldOp() const {
+    if (op->body.empty())
+        return {};
+    return op->body.back()->as<YieldOp>();
+}
+
 void ConditionOp::init() {
 }
 
@@ -70,9 +82,28 @@ Value::Ptr ConditionOp::terminator() const {
     return op->body.back()->result(0);
 }
 
+void DeallocateOp::init(const Value::Ptr &ptr) {
+    op->addOperand(ptr);
+}
+
+void DefaultOp::init() {
+}
+
+YieldOp DefaultOp::yieldOp() const {
+    if (op->body.empty())
+        return {};
+    return op->body.back()->as<YieldOp>();
+}
+
 void ElseOp::init() {
 }
 
+YieldOp ElseOp::yieldOp() const {
+    if (op->body.empty())
+        return {};
+    return op->body.back()->as<YieldOp>();
+}
+
 void ForOp::init(const Type::Ptr &iteratorType, const Value::Ptr &start, const Value::Ptr &stop,
                  const Value::Ptr &step) {
     op->addOperand(start);
@@ -81,6 +112,12 @@ void ForOp::init(const Type::Ptr &iteratorType, const Value::Ptr &start, const V
     op->addInward(iteratorType);
 }
 
+YieldOp ForOp::yieldOp() const {
+    if (op->body.empty())
+        return {};
+    return op->body.back()->as<YieldOp>();
+}
+
 void FunctionOp::init(const std::string &name, const Type::Ptr &funcType) {
     op->addAttr(name);
     op->addAttr(funcType);
@@ -88,9 +125,21 @@ void FunctionOp::init(const std::string &name, const Type::Ptr &funcType) {
         op->addInward(argType);
 }
 
+bool FunctionOp::hasDecorator(const std::string &decorator) const {
+    for (size_t i = numRequiredAttrs; i < op->numAttrs(); i++)
+        if (op->attr(i).is<std::string>() && op->attr(i).as<std::string>() == decorator)
+            return true;
+    return false;
+}
+
+void FunctionOp::addDecorator(const std::string &decorator) {
+    op->addAttr(decorator);
+}
+
 void FunctionCallOp::init(const std::string &name, const Type::Ptr &resultType,
                           const std::vector<Value::Ptr> &arguments) {
-    op->operands = arguments;
+    for (const auto &arg : arguments)
+        op->addOperand(arg);
     op->results.emplace_back(Value::make(resultType, op));
     op->addAttr(name);
 }
@@ -99,6 +148,18 @@ void FunctionCallOp::init(const FunctionOp &callee, const std::vector<Value::Ptr
     init(callee.name(), callee.type().result, arguments);
 }
 
+void HeapAllocateOp::init(const Type::Ptr &type, const Value::Ptr &dynamicSize) {
+    AllocateOp(op).init(type, dynamicSize);
+}
+
+Value::Ptr HeapAllocateOp::dynamicSize() const {
+    return AllocateOp(op).dynamicSize();
+}
+
+void HeapAllocateOp::setDynamicSize(const Value::Ptr &value) {
+    AllocateOp(op).setDynamicSize(value);
+}
+
 void IfOp::init(const Value::Ptr &cond, bool withElse) {
     op->addOperand(cond);
     op->addToBody(Operation::make<ThenOp>(op).op);
@@ -192,9 +253,40 @@ void StoreOp::setOffset(const Value::Ptr &value) {
         op->addOperand(value);
 }
 
+void SwitchOp::init(const Value::Ptr &value, const std::vector<NativeInt> &caseValues, bool withDefault) {
+    op->addOperand(value);
+    for (auto caseValue : caseValues) {
+        auto caseOp = Operation::make<CaseOp>(op);
+        caseOp.init(caseValue);
+        op->addToBody(caseOp.op);
+    }
+    if (withDefault)
+        op->addToBody(Operation::make<DefaultOp>(op).op);
+}
+
+size_t SwitchOp::numCases() const {
+    return op->body.size() - (defaultOp() ? 1U : 0U);
+}
+
+CaseOp SwitchOp::caseOp(size_t index) const {
+    return {*std::next(op->body.begin(), static_cast<ptrdiff_t>(index))};
+}
+
+DefaultOp SwitchOp::defaultOp() const {
+    if (op->body.empty())
+        return {};
+    return op->body.back()->as<DefaultOp>();
+}
+
 void ThenOp::init() {
 }
 
+YieldOp ThenOp::yieldOp() const {
+    if (op->body.empty())
+        return {};
+    return op->body.back()->as<YieldOp>();
+}
+
 void UnaryOp::init(const Type::Ptr &resultType, const Value::Ptr &value) {
     op->addResult(resultType);
     op->addOperand(value);
@@ -207,3 +299,12 @@ void WhileOp::init() {
 ConditionOp WhileOp::conditionOp() const {
     return {op->body.front()};
 }
+
+YieldOp WhileOp::yieldOp() const {
+    return op->body.back()->as<YieldOp>();
+}
+
+void YieldOp::init(const std::vector<Value::Ptr> &values) {
+    for (const auto &value : values)
+        op->addOperand(value);
+}
@@ -23,8 +23,8 @@ DeclarativeModule::DeclarativeModule()
       tF64(TypeStorage::floatType(64U)), tStr(TypeStorage::strType(8U)) {
 }
 
-Type::Ptr DeclarativeModule::tPtr(const Type::Ptr &pointee) const {
-    return Type::make<PointerType>(pointee);
+Type::Ptr DeclarativeModule::tPtr(const Type::Ptr &pointee, size_t numElements) const {
+    return Type::make<PointerType>(pointee, numElements);
 }
 
 Type::Ptr DeclarativeModule::tFunc(const Type::Ptr &result) const {
@@ -54,6 +54,11 @@ DeclarativeModule &DeclarativeModule::result(const Type::Ptr &type) {
     return *this;
 }
 
+DeclarativeModule &DeclarativeModule::result(DeclarativeValue &result, const Type::Ptr &type) {
+    result.value = current->addResult(type);
+    return *this;
+}
+
 DeclarativeModule &DeclarativeModule::inward(DeclarativeValue &inward, const Type::Ptr &type) {
     inward.value = current->addInward(type);
     return *this;
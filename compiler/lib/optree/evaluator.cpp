@@ -0,0 +1,412 @@
+#include "evaluator.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "adaptors.hpp"
+#include "attribute.hpp"
+#include "definitions.hpp"
+#include "operation.hpp"
+#include "types.hpp"
+#include "value.hpp"
+
+using namespace optree;
+
+namespace {
+
+// Integers wrap around on overflow in the same way as in the generated code
+NativeInt wrap(uint64_t value) {
+    return static_cast<NativeInt>(value);
+}
+
+bool isShiftInRange(NativeInt amount) {
+    return amount >= 0 && amount < std::numeric_limits<uint64_t>::digits;
+}
+
+template <typename T>
+std::optional<Attribute> compare(LogicBinOpKind kind, const T &lhs, const T &rhs) {
+    switch (kind) {
+    case LogicBinOpKind::Equal:
+        return Attribute(NativeBool(lhs == rhs));
+    case LogicBinOpKind::NotEqual:
+        return Attribute(NativeBool(lhs != rhs));
+    case LogicBinOpKind::LessI:
+    case LogicBinOpKind::LessF:
+        return Attribute(NativeBool(lhs < rhs));
+    case LogicBinOpKind::GreaterI:
+    case LogicBinOpKind::GreaterF:
+        return Attribute(NativeBool(lhs > rhs));
+    case LogicBinOpKind::LessEqualI:
+    case LogicBinOpKind::LessEqualF:
+        return Attribute(NativeBool(lhs <= rhs));
+    case LogicBinOpKind::GreaterEqualI:
+    case LogicBinOpKind::GreaterEqualF:
+        return Attribute(NativeBool(lhs >= rhs));
+    default:
+        return std::nullopt;
+    }
+}
+
+// Arguments are encoded bitwise, so zeros of different signs get different entries
+std::string memoKey(const std::string &name, const std::vector<Attribute> &arguments) {
+    std::string key = name;
+    for (const auto &argument : arguments) {
+        key += '\0';
+        if (argument.is<NativeInt>())
+            key += "i" + std::to_string(argument.as<NativeInt>());
+        else if (argument.is<NativeFloat>())
+            key += "f" + std::to_string(std::bit_cast<uint64_t>(argument.as<NativeFloat>()));
+        else if (argument.is<NativeBool>())
+            key += argument.as<NativeBool>() ? "b1" : "b0";
+        else
+            key += "s" + argument.as<NativeStr>();
+    }
+    return key;
+}
+
+} // namespace
+
+namespace optree {
+
+std::optional<Attribute> foldArithBinary(ArithBinOpKind kind, const Attribute &lhs, const Attribute &rhs) {
+    switch (kind) {
+    case ArithBinOpKind::AddI:
+        return Attribute(wrap(static_cast<uint64_t>(lhs.as<NativeInt>()) + static_cast<uint64_t>(rhs.as<NativeInt>())));
+    case ArithBinOpKind::SubI:
+        return Attribute(wrap(static_cast<uint64_t>(lhs.as<NativeInt>()) - static_cast<uint64_t>(rhs.as<NativeInt>())));
+    case ArithBinOpKind::MulI:
+        return Attribute(wrap(static_cast<uint64_t>(lhs.as<NativeInt>()) * static_cast<uint64_t>(rhs.as<NativeInt>())));
+    case ArithBinOpKind::DivI:
+        // Division by zero and the overflowing division are left to trap at runtime
+        if (rhs.as<NativeInt>() == 0 ||
+            (lhs.as<NativeInt>() == std::numeric_limits<NativeInt>::min() && rhs.as<NativeInt>() == -1))
+            return std::nullopt;
+        return Attribute(lhs.as<NativeInt>() / rhs.as<NativeInt>());
+    case ArithBinOpKind::ShlI:
+        if (!isShiftInRange(rhs.as<NativeInt>()))
+            return std::nullopt;
+        return Attribute(wrap(static_cast<uint64_t>(lhs.as<NativeInt>()) << rhs.as<NativeInt>()));
+    case ArithBinOpKind::ShrI:
+        if (!isShiftInRange(rhs.as<NativeInt>()))
+            return std::nullopt;
+        return Attribute(lhs.as<NativeInt>() >> rhs.as<NativeInt>());
+    case ArithBinOpKind::AddF:
+        return Attribute(lhs.as<NativeFloat>() + rhs.as<NativeFloat>());
+    case ArithBinOpKind::SubF:
+        return Attribute(lhs.as<NativeFloat>() - rhs.as<NativeFloat>());
+    case ArithBinOpKind::MulF:
+        return Attribute(lhs.as<NativeFloat>() * rhs.as<NativeFloat>());
+    case ArithBinOpKind::DivF:
+        return Attribute(lhs.as<NativeFloat>() / rhs.as<NativeFloat>());
+    default:
+        return std::nullopt;
+    }
+}
+
+std::optional<Attribute> foldArithCast(ArithCastOpKind kind, const Attribute &value) {
+    switch (kind) {
+    case ArithCastOpKind::IntToFloat:
+        return Attribute(static_cast<NativeFloat>(value.as<NativeInt>()));
+    case ArithCastOpKind::FloatToInt:
+        return Attribute(static_cast<NativeInt>(value.as<NativeFloat>()));
+    case ArithCastOpKind::ExtI:
+    case ArithCastOpKind::TruncI:
+    case ArithCastOpKind::ExtF:
+    case ArithCastOpKind::TruncF:
+        return value;
+    default:
+        return std::nullopt;
+    }
+}
+
+std::optional<Attribute> foldArithUnary(ArithUnaryOpKind kind, const Attribute &value) {
+    switch (kind) {
+    case ArithUnaryOpKind::NegI:
+        return Attribute(wrap(-static_cast<uint64_t>(value.as<NativeInt>())));
+    case ArithUnaryOpKind::NegF:
+        return Attribute(-value.as<NativeFloat>());
+    default:
+        return std::nullopt;
+    }
+}
+
+std::optional<Attribute> foldLogicBinary(LogicBinOpKind kind, const Attribute &lhs, const Attribute &rhs) {
+    if (lhs.is<NativeBool>()) {
+        if (kind == LogicBinOpKind::AndI)
+            return Attribute(NativeBool(lhs.as<NativeBool>() && rhs.as<NativeBool>()));
+        if (kind == LogicBinOpKind::OrI)
+            return Attribute(NativeBool(lhs.as<NativeBool>() || rhs.as<NativeBool>()));
+        return compare(kind, lhs.as<NativeBool>(), rhs.as<NativeBool>());
+    }
+    if (lhs.is<NativeInt>())
+        return compare(kind, lhs.as<NativeInt>(), rhs.as<NativeInt>());
+    if (lhs.is<NativeFloat>())
+        return compare(kind, lhs.as<NativeFloat>(), rhs.as<NativeFloat>());
+    return std::nullopt;
+}
+
+std::optional<Attribute> fold(const Operation::Ptr &op, const std::vector<Attribute> &operands) {
+    if (auto binaryOp = op->as<ArithBinaryOp>())
+        return foldArithBinary(binaryOp.kind(), operands[0], operands[1]);
+    if (auto castOp = op->as<ArithCastOp>())
+        return foldArithCast(castOp.kind(), operands[0]);
+    if (auto unaryOp = op->as<ArithUnaryOp>())
+        return foldArithUnary(unaryOp.kind(), operands[0]);
+    if (auto logicOp = op->as<LogicBinaryOp>())
+        return foldLogicBinary(logicOp.kind(), operands[0], operands[1]);
+    if (auto notOp = op->as<LogicUnaryOp>(); notOp && notOp.kind() == LogicUnaryOpKind::Not)
+        return Attribute(NativeBool(!operands[0].as<NativeBool>()));
+    return std::nullopt;
+}
+
+Evaluator::Evaluator(const Operation::Ptr &moduleOp, size_t maxSteps, size_t maxDepth)
+    : moduleOp(moduleOp), maxSteps(maxSteps), maxDepth(maxDepth) {
+}
+
+Evaluator::Exit Evaluator::runBody(const Operation::Ptr &region, Context &context, size_t skip) {
+    for (const auto &op : region->body) {
+        if (skip != 0U) {
+            skip--;
+            continue;
+        }
+        if (auto exit = run(op, context); exit != Exit::Next)
+            return exit;
+    }
+    return Exit::Next;
+}
+
+Evaluator::Exit Evaluator::runLoop(const Operation::Ptr &op, Context &context) {
+    auto &values = context.values;
+    bool isFor = op->is<ForOp>();
+    size_t firstCarried = isFor ? 1U : 0U;
+    std::vector<Slot> carried;
+    for (const auto &operand : op->operands) {
+        auto it = values.find(operand.get());
+        if (it == values.end())
+            return Exit::Fail;
+        carried.push_back(it->second);
+    }
+    NativeInt iterator = 0;
+    NativeInt stop = 0;
+    NativeInt step = 0;
+    if (isFor) {
+        iterator = std::get<Attribute>(carried[0]).as<NativeInt>();
+        stop = std::get<Attribute>(carried[1]).as<NativeInt>();
+        step = std::get<Attribute>(carried[2]).as<NativeInt>();
+        carried.erase(carried.begin(), carried.begin() + ForOp::numControlOperands);
+    }
+    while (true) {
+        for (size_t i = 0; i < carried.size(); i++)
+            values[op->inward(firstCarried + i).get()] = carried[i];
+        if (isFor) {
+            if (iterator >= stop)
+                break;
+            values[op->inward(0).get()] = Attribute(iterator);
+        } else {
+            auto conditionOp = op->body.front();
+            if (auto exit = runBody(conditionOp, context); exit != Exit::Next)
+                return exit;
+            auto cond = values.find(ConditionOp(conditionOp).terminator().get());
+            if (cond == values.end())
+                return Exit::Fail;
+            if (!std::get<Attribute>(cond->second).as<NativeBool>())
+                break;
+        }
+        // Iteration is counted as a step itself, so the loops with empty bodies are bounded as well
+        if (++steps > maxSteps) {
+            exhausted = true;
+            return Exit::Fail;
+        }
+        context.yielded.clear();
+        if (auto exit = runBody(op, context, isFor ? 0U : 1U); exit != Exit::Next)
+            return exit;
+        if (context.yielded.size() != carried.size())
+            return Exit::Fail;
+        carried = context.yielded;
+        if (isFor)
+            iterator = wrap(static_cast<uint64_t>(iterator) + static_cast<uint64_t>(step));
+    }
+    for (size_t i = 0; i < carried.size(); i++)
+        values[op->result(i).get()] = carried[i];
+    context.yielded.clear();
+    return Exit::Next;
+}
+
+Evaluator::Exit Evaluator::run(const Operation::Ptr &op, Context &context) {
+    if (++steps > maxSteps) {
+        exhausted = true;
+        return Exit::Fail;
+    }
+    auto &values = context.values;
+    auto scalar = [&values](const Value::Ptr &value) -> const Attribute * {
+        auto it = values.find(value.get());
+        if (it == values.end())
+            return nullptr;
+        return std::get_if<Attribute>(&it->second);
+    };
+
+    if (auto constOp = op->as<ConstantOp>()) {
+        values[constOp.result().get()] = constOp.value();
+        return Exit::Next;
+    }
+    if (op->is<ArithBinaryOp>() || op->is<ArithCastOp>() || op->is<ArithUnaryOp>() || op->is<LogicBinaryOp>() ||
+        op->is<LogicUnaryOp>()) {
+        std::vector<Attribute> operands;
+        for (const auto &operand : op->operands) {
+            const auto *attr = scalar(operand);
+            if (!attr)
+                return Exit::Fail;
+            operands.push_back(*attr);
+        }
+        auto folded = fold(op, operands);
+        if (!folded)
+            return Exit::Fail;
+        values[op->result(0).get()] = *folded;
+        return Exit::Next;
+    }
+    if (op->is<AllocateOp>() || op->is<HeapAllocateOp>()) {
+        size_t size = op->result(0)->type->as<PointerType>().numElements;
+        if (op->numOperands() != 0U) {
+            // Memory larger than the steps limit could not be filled anyway
+            const auto *dynamicSize = scalar(op->operand(0));
+            if (!dynamicSize || dynamicSize->as<NativeInt>() < 0 ||
+                static_cast<size_t>(dynamicSize->as<NativeInt>()) > maxSteps)
+                return Exit::Fail;
+            size = static_cast<size_t>(dynamicSize->as<NativeInt>());
+        }
+        values[op->result(0).get()] = std::make_shared<std::vector<Attribute>>(size);
+        return Exit::Next;
+    }
+    if (op->is<DeallocateOp>())
+        return Exit::Next;
+    if (op->is<LoadOp>() || op->is<StoreOp>()) {
+        bool isLoad = op->is<LoadOp>();
+        auto it = values.find(op->operand(0).get());
+        if (it == values.end() || !std::holds_alternative<Memory>(it->second))
+            return Exit::Fail;
+        const auto &memory = std::get<Memory>(it->second);
+        auto offsetValue = isLoad ? LoadOp(op).offset() : StoreOp(op).offset();
+        NativeInt offset = 0;
+        if (offsetValue) {
+            const auto *attr = scalar(offsetValue);
+            if (!attr)
+                return Exit::Fail;
+            offset = attr->as<NativeInt>();
+        }
+        if (offset < 0 || static_cast<size_t>(offset) >= memory->size())
+            return Exit::Fail;
+        auto &cell = (*memory)[static_cast<size_t>(offset)];
+        if (isLoad) {
+            if (cell.is<std::monostate>())
+                return Exit::Fail;
+            values[op->result(0).get()] = cell;
+        } else {
+            const auto *attr = scalar(op->operand(1));
+            if (!attr)
+                return Exit::Fail;
+            cell = *attr;
+        }
+        return Exit::Next;
+    }
+    if (auto callOp = op->as<FunctionCallOp>()) {
+        std::vector<Attribute> arguments;
+        for (const auto &operand : op->operands) {
+            const auto *attr = scalar(operand);
+            if (!attr)
+                return Exit::Fail;
+            arguments.push_back(*attr);
+        }
+        auto result = evaluate(callOp.name(), arguments);
+        if (!result)
+            return Exit::Fail;
+        if (!result->is<std::monostate>())
+            values[callOp.result().get()] = *result;
+        return Exit::Next;
+    }
+    if (auto returnOp = op->as<ReturnOp>()) {
+        if (op->numOperands() == 0U) {
+            context.returned = Attribute();
+            return Exit::Return;
+        }
+        const auto *attr = scalar(returnOp.value());
+        if (!attr)
+            return Exit::Fail;
+        context.returned = *attr;
+        return Exit::Return;
+    }
+    if (op->is<YieldOp>()) {
+        context.yielded.clear();
+        for (const auto &operand : op->operands) {
+            auto it = values.find(operand.get());
+            if (it == values.end())
+                return Exit::Fail;
+            context.yielded.push_back(it->second);
+        }
+        return Exit::Next;
+    }
+    if (auto ifOp = op->as<IfOp>()) {
+        const auto *cond = scalar(ifOp.cond());
+        if (!cond)
+            return Exit::Fail;
+        Operation::Ptr branch = cond->as<NativeBool>() ? Operation::Ptr(ifOp.thenOp()) : Operation::Ptr(ifOp.elseOp());
+        if (!branch)
+            return Exit::Next;
+        context.yielded.clear();
+        if (auto exit = runBody(branch, context); exit != Exit::Next)
+            return exit;
+        if (context.yielded.size() < op->numResults())
+            return Exit::Fail;
+        for (size_t i = 0; i < op->numResults(); i++)
+            values[op->result(i).get()] = context.yielded[i];
+        context.yielded.clear();
+        return Exit::Next;
+    }
+    if (op->is<WhileOp>() || op->is<ForOp>())
+        return runLoop(op, context);
+    // Print, input and the unknown operations can not be evaluated at compile time
+    return Exit::Fail;
+}
+
+std::optional<Attribute> Evaluator::evaluate(const std::string &name, const std::vector<Attribute> &arguments) {
+    auto key = memoKey(name, arguments);
+    if (auto it = memo.find(key); it != memo.end())
+        return it->second;
+    auto funcOp = ModuleOp(moduleOp).lookup<FunctionOp>(name);
+    if (!funcOp || funcOp->numInwards() != arguments.size())
+        return std::nullopt;
+    if (depth >= maxDepth) {
+        exhausted = true;
+        return std::nullopt;
+    }
+
+    Context context;
+    for (size_t i = 0; i < arguments.size(); i++)
+        context.values[funcOp->inward(i).get()] = arguments[i];
+    depth++;
+    auto exit = runBody(funcOp, context);
+    depth--;
+    std::optional<Attribute> result;
+    if (exit == Exit::Return)
+        result = context.returned;
+    // Failures caused by the exhausted limits depend on the enclosing evaluation, so they are not memoized
+    if (result || !exhausted)
+        memo[key] = result;
+    return result;
+}
+
+std::optional<Attribute> Evaluator::call(const std::string &name, const std::vector<Attribute> &arguments) {
+    steps = 0;
+    exhausted = false;
+    auto result = evaluate(name, arguments);
+    if (!result || result->is<std::monostate>())
+        return std::nullopt;
+    return result;
+}
+
+} // namespace optree
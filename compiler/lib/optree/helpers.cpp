@@ -1,6 +1,13 @@
 #include "helpers.hpp"
 
 #include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <variant>
 
 #include "compiler/utils/source_ref.hpp"
 
@@ -94,4 +101,32 @@ bool similar(const Operation::Ptr &lhs, const Operation::Ptr &rhs, bool checkBod
     return body;
 }
 
+bool isConditionPredicate(const Operation::Ptr &op) {
+    auto condOp = op->parent ? op->parent->as<ConditionOp>() : ConditionOp();
+    return condOp && op->numResults() != 0 && condOp.terminator() == op->result(0);
+}
+
+bool sameAttribute(const Attribute &lhs, const Attribute &rhs) {
+    if (lhs.is<NativeFloat>() && rhs.is<NativeFloat>())
+        return std::bit_cast<uint64_t>(lhs.as<NativeFloat>()) == std::bit_cast<uint64_t>(rhs.as<NativeFloat>());
+    return lhs == rhs;
+}
+
+size_t hashAttribute(const Attribute &attr) {
+    return std::visit(
+        [](const auto &value) -> size_t {
+            using T = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same_v<T, std::monostate>)
+                return 0U;
+            // Equal types may be represented by different objects
+            else if constexpr (std::is_same_v<T, Type::Ptr>)
+                return std::hash<std::string>{}(value->dump());
+            else if constexpr (std::is_same_v<T, NativeFloat>)
+                return std::hash<uint64_t>{}(std::bit_cast<uint64_t>(value));
+            else
+                return std::hash<T>{}(value);
+        },
+        attr.storage);
+}
+
 } // namespace optree
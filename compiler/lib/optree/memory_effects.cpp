@@ -0,0 +1,203 @@
+#include "memory_effects.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "adaptors.hpp"
+#include "definitions.hpp"
+#include "helpers.hpp"
+#include "operation.hpp"
+#include "types.hpp"
+#include "value.hpp"
+
+using namespace optree;
+
+namespace {
+
+std::optional<NativeInt> constantOffset(const MemoryEffect &effect) {
+    if (!effect.offset)
+        return NativeInt(0);
+    auto constOp = getValueOwnerAs<ConstantOp>(effect.offset);
+    if (!constOp || !constOp.value().is<NativeInt>())
+        return std::nullopt;
+    return constOp.value().as<NativeInt>();
+}
+
+bool isArgument(const Value::Ptr &ptr) {
+    auto owner = ptr->owner.lock();
+    return owner && owner->is<FunctionOp>();
+}
+
+std::optional<size_t> argumentIndex(const Value::Ptr &ptr, const Operation::Ptr &funcOp) {
+    auto it = std::ranges::find(funcOp->inwards, ptr);
+    if (it == funcOp->inwards.end())
+        return std::nullopt;
+    return static_cast<size_t>(std::distance(funcOp->inwards.begin(), it));
+}
+
+} // namespace
+
+Operation::Ptr optree::getPointerRoot(const Value::Ptr &ptr) {
+    auto owner = ptr->owner.lock();
+    if (owner && utils::isAny<AllocateOp, HeapAllocateOp>(owner))
+        return owner;
+    return {};
+}
+
+MemoryEffect optree::readEffect(const LoadOp &op) {
+    if (op.result()->type->is<VectorType>())
+        return {MemoryEffectKind::Read, op.src(), {}, true};
+    return {MemoryEffectKind::Read, op.src(), op.offset()};
+}
+
+MemoryEffect optree::writeEffect(const StoreOp &op) {
+    if (op.valueToStore()->type->is<VectorType>())
+        return {MemoryEffectKind::Write, op.dst(), {}, true};
+    return {MemoryEffectKind::Write, op.dst(), op.offset()};
+}
+
+AliasResult optree::alias(const MemoryEffect &lhs, const MemoryEffect &rhs) {
+    if (!lhs.isMemoryAccess() || !rhs.isMemoryAccess())
+        return AliasResult::NoAlias;
+    if (!lhs.ptr || !rhs.ptr)
+        return AliasResult::MayAlias;
+    if (lhs.ptr != rhs.ptr) {
+        auto lhsRoot = getPointerRoot(lhs.ptr);
+        auto rhsRoot = getPointerRoot(rhs.ptr);
+        // Memory allocated by the function is not reachable from its arguments
+        if ((lhsRoot && (rhsRoot || isArgument(rhs.ptr))) || (rhsRoot && isArgument(lhs.ptr)))
+            return AliasResult::NoAlias;
+        return AliasResult::MayAlias;
+    }
+    if (lhs.wholeObject || rhs.wholeObject || lhs.kind == MemoryEffectKind::Free ||
+        rhs.kind == MemoryEffectKind::Free)
+        return AliasResult::MayAlias;
+    if (lhs.offset == rhs.offset)
+        return AliasResult::MustAlias;
+    auto lhsOffset = constantOffset(lhs);
+    auto rhsOffset = constantOffset(rhs);
+    if (!lhsOffset || !rhsOffset)
+        return AliasResult::MayAlias;
+    return *lhsOffset == *rhsOffset ? AliasResult::MustAlias : AliasResult::NoAlias;
+}
+
+MemoryEffectsAnalysis::MemoryEffectsAnalysis(const Operation::Ptr &op) {
+    auto moduleOp = op;
+    while (moduleOp->parent)
+        moduleOp = moduleOp->parent;
+    std::vector<FunctionOp> functions;
+    for (const auto &childOp : moduleOp->body)
+        if (auto funcOp = childOp->as<FunctionOp>())
+            functions.push_back(funcOp);
+    for (const auto &funcOp : functions) {
+        auto &summary = summaries[funcOp.name()];
+        summary.readArguments.assign(funcOp->numInwards(), false);
+        summary.writtenArguments.assign(funcOp->numInwards(), false);
+    }
+    // Summaries only grow, so the iteration reaches a fixed point even for recursive functions
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const auto &funcOp : functions) {
+            auto summary = summarize(funcOp);
+            auto &current = summaries[funcOp.name()];
+            if (summary != current) {
+                current = summary;
+                changed = true;
+            }
+        }
+    }
+}
+
+MemoryEffectsAnalysis::FunctionSummary MemoryEffectsAnalysis::summarize(const Operation::Ptr &funcOp) const {
+    FunctionSummary summary;
+    summary.readArguments.assign(funcOp->numInwards(), false);
+    summary.writtenArguments.assign(funcOp->numInwards(), false);
+    for (const auto &effect : getEffects(funcOp)) {
+        if (effect.kind == MemoryEffectKind::IO) {
+            summary.performsIO = true;
+            continue;
+        }
+        if (!effect.isMemoryAccess())
+            continue;
+        bool isWrite = effect.modifiesMemory();
+        // Memory allocated by the function is not visible to the caller before the call
+        if (effect.ptr && getPointerRoot(effect.ptr))
+            continue;
+        auto index = effect.ptr ? argumentIndex(effect.ptr, funcOp) : std::nullopt;
+        if (!index) {
+            (isWrite ? summary.writesUnknown : summary.readsUnknown) = true;
+            continue;
+        }
+        (isWrite ? summary.writtenArguments : summary.readArguments)[*index] = true;
+    }
+    return summary;
+}
+
+void MemoryEffectsAnalysis::collectCallEffects(const Operation::Ptr &op, MemoryEffects &effects) const {
+    auto callOp = op->as<FunctionCallOp>();
+    auto it = summaries.find(callOp.name());
+    if (it == summaries.end()) {
+        effects.push_back({MemoryEffectKind::Read, {}, {}, true});
+        effects.push_back({MemoryEffectKind::Write, {}, {}, true});
+        effects.push_back({MemoryEffectKind::IO, {}, {}});
+        return;
+    }
+    const auto &summary = it->second;
+    for (size_t i = 0; i < op->numOperands() && i < summary.readArguments.size(); i++) {
+        if (summary.readArguments[i])
+            effects.push_back({MemoryEffectKind::Read, op->operand(i), {}, true});
+        if (summary.writtenArguments[i])
+            effects.push_back({MemoryEffectKind::Write, op->operand(i), {}, true});
+    }
+    if (summary.readsUnknown)
+        effects.push_back({MemoryEffectKind::Read, {}, {}, true});
+    if (summary.writesUnknown)
+        effects.push_back({MemoryEffectKind::Write, {}, {}, true});
+    if (summary.performsIO)
+        effects.push_back({MemoryEffectKind::IO, {}, {}});
+}
+
+void MemoryEffectsAnalysis::collectEffects(const Operation::Ptr &op, MemoryEffects &effects) const {
+    if (auto loadOp = op->as<LoadOp>()) {
+        effects.push_back(readEffect(loadOp));
+    } else if (auto storeOp = op->as<StoreOp>()) {
+        effects.push_back(writeEffect(storeOp));
+    } else if (utils::isAny<AllocateOp, HeapAllocateOp>(op)) {
+        effects.push_back({MemoryEffectKind::Allocate, op->result(0), {}, true});
+    } else if (auto deallocOp = op->as<DeallocateOp>()) {
+        effects.push_back({MemoryEffectKind::Free, deallocOp.ptr(), {}, true});
+    } else if (auto inputOp = op->as<InputOp>()) {
+        effects.push_back({MemoryEffectKind::Write, inputOp.dst(), {}});
+        effects.push_back({MemoryEffectKind::IO, {}, {}});
+    } else if (op->is<PrintOp>()) {
+        for (const auto &operand : op->operands)
+            if (operand->type->is<PointerType>())
+                effects.push_back({MemoryEffectKind::Read, operand, {}, true});
+        effects.push_back({MemoryEffectKind::IO, {}, {}});
+    } else if (op->is<FunctionCallOp>()) {
+        collectCallEffects(op, effects);
+    }
+    for (const auto &childOp : op->body)
+        collectEffects(childOp, effects);
+}
+
+MemoryEffects MemoryEffectsAnalysis::getEffects(const Operation::Ptr &op) const {
+    MemoryEffects effects;
+    collectEffects(op, effects);
+    return effects;
+}
+
+bool MemoryEffectsAnalysis::hasEffects(const Operation::Ptr &op) const {
+    return !getEffects(op).empty();
+}
+
+bool MemoryEffectsAnalysis::mayModify(const Operation::Ptr &op, const MemoryEffect &access) const {
+    return std::ranges::any_of(getEffects(op), [&access](const MemoryEffect &effect) {
+        return effect.modifiesMemory() && alias(effect, access) != AliasResult::NoAlias;
+    });
+}
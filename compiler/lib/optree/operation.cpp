@@ -36,14 +36,12 @@ void Operation::updateUse(const Value::Ptr &value, size_t operandNumber,
             actor(use);
 }
 
-Operation::Ptr Operation::cloneImpl(const ValueMapping &operandsMap) {
-    ValueMapping outputsMap;
-    auto newOp = cloneWithoutBodyImpl(operandsMap, outputsMap);
+Operation::Ptr Operation::cloneImpl(ValueMapping &valuesMap) {
+    // Values defined by the nested operations are visible to their following siblings and the nested regions
+    auto newOp = cloneWithoutBodyImpl(valuesMap, valuesMap);
     for (const auto &nestedOp : body) {
-        newOp->addToBody(nestedOp->cloneImpl(outputsMap));
+        newOp->addToBody(nestedOp->cloneImpl(valuesMap));
     }
-    for (const auto &inward : inwards)
-        outputsMap.erase(inward);
     return newOp;
 }
 
@@ -117,6 +115,10 @@ Operation::operator bool() const {
     return specId;
 }
 
+Operation::SpecId Operation::getSpecId() const {
+    return specId;
+}
+
 size_t Operation::numOperands() const {
     return operands.size();
 }
@@ -219,7 +221,8 @@ void Operation::erase() {
 }
 
 Operation::Ptr Operation::clone() {
-    return cloneImpl();
+    ValueMapping valuesMap;
+    return cloneImpl(valuesMap);
 }
 
 Operation::Ptr Operation::cloneWithoutBody() {
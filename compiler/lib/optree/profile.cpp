@@ -0,0 +1,95 @@
+#include "profile.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "compiler/utils/source_ref.hpp"
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/definitions.hpp"
+#include "compiler/optree/operation.hpp"
+
+namespace optree {
+
+namespace {
+
+// Directories are omitted, so the profile does not depend on the location of the sources
+std::string getPosition(const utils::SourceRef &ref) {
+    auto filename = ref.filename.lock();
+    auto position = filename ? std::filesystem::path(*filename).filename().string() : std::string();
+    return position + ":" + std::to_string(ref.line) + ":" + std::to_string(ref.column);
+}
+
+} // namespace
+
+std::vector<std::string> getProfileKeys(const Operation::Ptr &op) {
+    auto position = getPosition(op->ref);
+    if (op->is<FunctionOp>())
+        return {"call " + position};
+    if (op->is<IfOp>())
+        return {"then " + position, "else " + position};
+    if (op->is<WhileOp>() || op->is<ForOp>())
+        return {"enter " + position, "iterate " + position};
+    return {};
+}
+
+std::vector<NativeInt> getProfileCounts(const Operation::Ptr &op) {
+    if (getProfileKeys(op).empty())
+        return {};
+    std::vector<NativeInt> counts;
+    for (const auto &attr : op->attributes)
+        if (attr.is<NativeInt>())
+            counts.push_back(attr.as<NativeInt>());
+    return counts;
+}
+
+void setProfileCounts(const Operation::Ptr &op, const std::vector<NativeInt> &counts) {
+    std::erase_if(op->attributes, [](const Attribute &attr) { return attr.is<NativeInt>(); });
+    for (auto count : counts)
+        op->addAttr(count);
+}
+
+Profile readProfile(std::istream &stream) {
+    Profile profile;
+    std::string line;
+    for (size_t number = 1U; std::getline(stream, line); number++) {
+        if (line.empty())
+            continue;
+        auto separator = line.rfind(' ');
+        NativeInt count = -1;
+        if (separator != std::string::npos) {
+            const char *end = line.data() + line.size();
+            auto [last, error] = std::from_chars(line.data() + separator + 1U, end, count);
+            if (error != std::errc() || last != end)
+                count = -1;
+        }
+        if (count < 0)
+            throw std::runtime_error("Invalid profile line " + std::to_string(number) + ": " + line);
+        profile[line.substr(0, separator)] += count;
+    }
+    return profile;
+}
+
+void attachProfile(const Operation::Ptr &op, const Profile &profile) {
+    auto keys = getProfileKeys(op);
+    if (!keys.empty()) {
+        std::vector<NativeInt> counts;
+        for (const auto &key : keys) {
+            auto it = profile.find(key);
+            if (it == profile.end())
+                break;
+            counts.push_back(it->second);
+        }
+        if (counts.size() == keys.size())
+            setProfileCounts(op, counts);
+    }
+    for (const auto &childOp : op->body)
+        attachProfile(childOp, profile);
+}
+
+} // namespace optree
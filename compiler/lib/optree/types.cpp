@@ -111,6 +111,22 @@ void PointerType::dump(std::ostream &stream) const {
     stream << ')';
 }
 
+bool VectorType::operator==(const Type &other) const {
+    TYPE_COMPARE_EARLY_RETURN(VectorType, other)
+    const auto &otherVector = other.as<VectorType>();
+    return numLanes == otherVector.numLanes && *element == *otherVector.element;
+}
+
+unsigned VectorType::bitWidth() const {
+    return element->bitWidth() * static_cast<unsigned>(numLanes);
+}
+
+void VectorType::dump(std::ostream &stream) const {
+    stream << "vec(";
+    element->dump(stream);
+    stream << ", " << numLanes << ')';
+}
+
 bool TupleType::operator==(const Type &other) const {
     TYPE_COMPARE_EARLY_RETURN(TupleType, other)
     const auto &otherTuple = other.as<TupleType>();
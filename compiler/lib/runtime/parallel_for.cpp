@@ -0,0 +1,198 @@
+#ifdef _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include "parallel_for.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Chunks are small enough to balance the load, but still amortize the cost of taking them
+constexpr int64_t chunksPerThread = 16;
+
+// Iterations not processed yet by one of the threads, the owner takes chunks from the beginning of the range,
+// while the thieves split off the second half of it
+struct alignas(64) WorkRange {
+    std::mutex mutex;
+    int64_t begin = 0;
+    int64_t end = 0;
+};
+
+struct Job {
+    ParallelLoopBody body;
+    void *context;
+    int64_t start;
+    int64_t stop;
+    int64_t step;
+    int64_t numIterations;
+    int64_t grain;
+    std::unique_ptr<WorkRange[]> ranges;
+    size_t numRanges;
+
+    void runIterations(int64_t first, int64_t last) const {
+        int64_t begin = start + first * step;
+        int64_t end = last == numIterations ? stop : start + last * step;
+        body(begin, end, step, context);
+    }
+
+    bool takeChunk(size_t index, int64_t &first, int64_t &last) {
+        auto &range = ranges[index];
+        std::lock_guard guard(range.mutex);
+        if (range.begin == range.end)
+            return false;
+        first = range.begin;
+        last = std::min(range.end, range.begin + grain);
+        range.begin = last;
+        return true;
+    }
+
+    bool steal(size_t thief) {
+        for (size_t i = 1; i < numRanges; i++) {
+            auto &victim = ranges[(thief + i) % numRanges];
+            int64_t first = 0;
+            int64_t last = 0;
+            {
+                std::lock_guard guard(victim.mutex);
+                int64_t remaining = victim.end - victim.begin;
+                if (remaining == 0)
+                    continue;
+                first = remaining <= grain ? victim.begin : victim.end - remaining / 2;
+                last = victim.end;
+                victim.end = first;
+            }
+            // The range of the thief is empty, so nobody else accesses it until the stolen iterations are put there
+            auto &range = ranges[thief];
+            std::lock_guard guard(range.mutex);
+            range.begin = first;
+            range.end = last;
+            return true;
+        }
+        return false;
+    }
+
+    void execute(size_t index) {
+        int64_t first = 0;
+        int64_t last = 0;
+        while (takeChunk(index, first, last) || (steal(index) && takeChunk(index, first, last)))
+            runIterations(first, last);
+    }
+};
+
+// Workers are created once and sleep between the jobs, the calling thread takes part in every job as well
+class ThreadPool {
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::condition_variable finished;
+    std::mutex submission;
+    Job *job = nullptr;
+    uint64_t generation = 0;
+    size_t numBusy = 0;
+
+    void work(size_t index) {
+        uint64_t seen = 0;
+        std::unique_lock lock(mutex);
+        while (true) {
+            wakeup.wait(lock, [&] { return generation != seen; });
+            seen = generation;
+            auto *current = job;
+            lock.unlock();
+            current->execute(index);
+            lock.lock();
+            if (--numBusy == 0)
+                finished.notify_one();
+        }
+    }
+
+  public:
+    explicit ThreadPool(size_t numWorkers) {
+        for (size_t i = 0; i < numWorkers; i++)
+            workers.emplace_back([this, i] { work(i + 1U); });
+        // Workers never finish, so they are not joined at the exit of the program
+        for (auto &worker : workers)
+            worker.detach();
+    }
+
+    size_t numThreads() const {
+        return workers.size() + 1U;
+    }
+
+    // Fails if the pool is running another job at the moment
+    std::unique_lock<std::mutex> tryAcquire() {
+        return std::unique_lock(submission, std::try_to_lock);
+    }
+
+    void run(Job &newJob) {
+        {
+            std::lock_guard guard(mutex);
+            job = &newJob;
+            numBusy = workers.size();
+            generation++;
+        }
+        wakeup.notify_all();
+        newJob.execute(0);
+        std::unique_lock lock(mutex);
+        finished.wait(lock, [this] { return numBusy == 0; });
+        job = nullptr;
+    }
+};
+
+// Number of threads is taken from COMPILER_NUM_THREADS environment variable if it is set
+size_t getNumThreads() {
+    if (const char *value = std::getenv("COMPILER_NUM_THREADS")) {
+        auto numThreads = std::strtoull(value, nullptr, 10);
+        if (numThreads > 0U)
+            return static_cast<size_t>(numThreads);
+    }
+    return std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+ThreadPool &getThreadPool() {
+    // The pool is never destroyed, as its detached workers may still wait for jobs at the exit of the program
+    static auto *pool = new ThreadPool(getNumThreads() - 1U);
+    return *pool;
+}
+
+} // namespace
+
+extern "C" void __compiler_parallel_for(int64_t start, int64_t stop, int64_t step, ParallelLoopBody body,
+                                        void *context) {
+    if (stop <= start)
+        return;
+    auto distance = static_cast<uint64_t>(stop) - static_cast<uint64_t>(start);
+    auto numIterations = static_cast<int64_t>((distance - 1U) / static_cast<uint64_t>(step) + 1U);
+    auto &pool = getThreadPool();
+    auto lock = pool.tryAcquire();
+    if (numIterations < 2 || pool.numThreads() == 1U || !lock.owns_lock()) {
+        body(start, stop, step, context);
+        return;
+    }
+
+    auto numThreads = static_cast<int64_t>(pool.numThreads());
+    Job job;
+    job.body = body;
+    job.context = context;
+    job.start = start;
+    job.stop = stop;
+    job.step = step;
+    job.numIterations = numIterations;
+    job.grain = std::max(numIterations / (numThreads * chunksPerThread), int64_t(1));
+    job.numRanges = pool.numThreads();
+    job.ranges = std::make_unique<WorkRange[]>(job.numRanges);
+    auto share = numIterations / numThreads;
+    auto extra = numIterations % numThreads;
+    for (int64_t i = 0; i < numThreads; i++) {
+        job.ranges[i].begin = i * share + std::min(i, extra);
+        job.ranges[i].end = job.ranges[i].begin + share + (i < extra ? 1 : 0);
+    }
+    pool.run(job);
+}
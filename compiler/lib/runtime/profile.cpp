@@ -0,0 +1,54 @@
+#include "profile.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct ModuleCounters {
+    const char *const *keys;
+    const int64_t *counters;
+    int64_t numCounters;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::string path;
+    std::vector<ModuleCounters> modules;
+};
+
+Registry &getRegistry() {
+    // The registry is never destroyed, as it is used by the handler run at the exit of the program
+    static auto *registry = new Registry();
+    return *registry;
+}
+
+} // namespace
+
+extern "C" void __compiler_profile_register(const char *path, const char *const *keys, const int64_t *counters,
+                                            int64_t numCounters) {
+    auto &registry = getRegistry();
+    std::lock_guard guard(registry.mutex);
+    if (registry.modules.empty()) {
+        registry.path = path;
+        std::atexit(__compiler_profile_write);
+    }
+    registry.modules.push_back({keys, counters, numCounters});
+}
+
+extern "C" void __compiler_profile_write() {
+    auto &registry = getRegistry();
+    std::lock_guard guard(registry.mutex);
+    std::map<std::string, int64_t> counts;
+    for (const auto &module : registry.modules)
+        for (int64_t i = 0; i < module.numCounters; i++)
+            counts[module.keys[i]] += module.counters[i];
+    std::ofstream stream(registry.path);
+    for (const auto &[key, count] : counts)
+        stream << key << ' ' << count << '\n';
+}
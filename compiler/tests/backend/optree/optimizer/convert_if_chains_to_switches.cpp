@@ -0,0 +1,243 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/transform_factories.hpp"
+#include "compiler/optree/adaptors.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+class ConvertIfChainsToSwitchesTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(createConvertIfChainsToSwitches());
+    }
+
+  public:
+    ConvertIfChainsToSwitchesTest() = default;
+    ~ConvertIfChainsToSwitchesTest() = default;
+};
+
+TEST_F(ConvertIfChainsToSwitchesTest, can_run_on_empty_optree) {
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(ConvertIfChainsToSwitchesTest, can_convert_if_elif_chain) {
+    // if x == 0: print(x) elif x == 1: print(1) elif 4 == x: print(4)
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["x"], v[0]);
+        m.op<IfOp>(v[1]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<PrintOp>(v["x"]);
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[3] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["x"], v[2]);
+        m.op<IfOp>(v[3]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<PrintOp>(v[2]);
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[4] = m.opInit<ConstantOp>(m.tI64, int64_t(4));
+        v[5] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v[4], v["x"]);
+        m.op<IfOp>(v[5]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<PrintOp>(v[4]);
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["x"], v[0]);
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[3] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["x"], v[2]);
+        v[4] = m.opInit<ConstantOp>(m.tI64, int64_t(4));
+        v[5] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v[4], v["x"]);
+        m.op<SwitchOp>(v["x"]).withBody();
+        m.opInit<CaseOp>(int64_t(0)).withBody();
+        m.opInit<PrintOp>(v["x"]);
+        m.endBody();
+        m.opInit<CaseOp>(int64_t(1)).withBody();
+        m.opInit<PrintOp>(v[2]);
+        m.endBody();
+        m.opInit<CaseOp>(int64_t(4)).withBody();
+        m.opInit<PrintOp>(v[4]);
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(ConvertIfChainsToSwitchesTest, can_convert_if_elif_else_chain_with_results) {
+    // r = 10 if x == 0 else 20 if x == 1 else 30 if x == 2 else x
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tI64)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[3] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["x"], v[0]);
+        v[4] = m.op<IfOp>(v[3]).result(m.tI64);
+        m.withBody();
+        m.op<ThenOp>().withBody();
+        v[5] = m.opInit<ConstantOp>(m.tI64, int64_t(10));
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[5]});
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[6] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["x"], v[1]);
+        v[7] = m.op<IfOp>(v[6]).result(m.tI64);
+        m.withBody();
+        m.op<ThenOp>().withBody();
+        v[8] = m.opInit<ConstantOp>(m.tI64, int64_t(20));
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[8]});
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[9] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["x"], v[2]);
+        v[10] = m.op<IfOp>(v[9]).result(m.tI64);
+        m.withBody();
+        m.op<ThenOp>().withBody();
+        v[11] = m.opInit<ConstantOp>(m.tI64, int64_t(30));
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[11]});
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v["x"]});
+        m.endBody();
+        m.endBody();
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[10]});
+        m.endBody();
+        m.endBody();
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[7]});
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>(v[4]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tI64)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[3] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["x"], v[0]);
+        v[6] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["x"], v[1]);
+        v[9] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["x"], v[2]);
+        v[4] = m.op<SwitchOp>(v["x"]).result(m.tI64);
+        m.withBody();
+        m.opInit<CaseOp>(int64_t(0)).withBody();
+        v[5] = m.opInit<ConstantOp>(m.tI64, int64_t(10));
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[5]});
+        m.endBody();
+        m.opInit<CaseOp>(int64_t(1)).withBody();
+        v[8] = m.opInit<ConstantOp>(m.tI64, int64_t(20));
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[8]});
+        m.endBody();
+        m.opInit<CaseOp>(int64_t(2)).withBody();
+        v[11] = m.opInit<ConstantOp>(m.tI64, int64_t(30));
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[11]});
+        m.endBody();
+        m.op<DefaultOp>().withBody();
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v["x"]});
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>(v[4]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(ConvertIfChainsToSwitchesTest, can_not_convert_chain_comparing_different_values) {
+    // if x == 0: print(x) elif y == 1: print(y) elif x == 2: print(x)
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tI64}, m.tNone)).inward(v["x"], 0).inward(v["y"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[3] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["x"], v[0]);
+        m.op<IfOp>(v[3]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<PrintOp>(v["x"]);
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[4] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["y"], v[1]);
+        m.op<IfOp>(v[4]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<PrintOp>(v["y"]);
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[5] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["x"], v[2]);
+        m.op<IfOp>(v[5]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<PrintOp>(v["x"]);
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(ConvertIfChainsToSwitchesTest, can_not_convert_chain_with_side_effects_between_comparisons) {
+    // if x == 0: print(x) else: print(y); if x == 1: print(y) elif x == 2: print(x)
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tI64}, m.tNone)).inward(v["x"], 0).inward(v["y"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[3] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["x"], v[0]);
+        m.op<IfOp>(v[3]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<PrintOp>(v["x"]);
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        m.opInit<PrintOp>(v["y"]);
+        v[4] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["x"], v[1]);
+        m.op<IfOp>(v[4]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<PrintOp>(v["y"]);
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[5] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["x"], v[2]);
+        m.op<IfOp>(v[5]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<PrintOp>(v["x"]);
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/transform_factories.hpp"
+#include "compiler/optree/adaptors.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+class EliminateCommonSubexpressionsTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(createEliminateCommonSubexpressions());
+    }
+
+  public:
+    EliminateCommonSubexpressionsTest() = default;
+    ~EliminateCommonSubexpressionsTest() = default;
+};
+
+TEST_F(EliminateCommonSubexpressionsTest, can_run_on_empty_optree) {
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(EliminateCommonSubexpressionsTest, can_replace_repeated_computations) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tI64}, m.tNone)).inward(v["a"], 0).inward(v["b"], 1).withBody();
+        v[0] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["a"], v["b"]);
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["a"], v["b"]);
+        v[3] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v[2], v[3]);
+        v[5] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v[0], v[1]);
+        v[6] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["a"], v["b"]);
+        m.opInit<PrintOp>(v[4]);
+        m.opInit<PrintOp>(v[5]);
+        m.opInit<PrintOp>(v[6]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tI64}, m.tNone)).inward(v["a"], 0).inward(v["b"], 1).withBody();
+        v[0] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["a"], v["b"]);
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v[0], v[1]);
+        v[6] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["a"], v["b"]);
+        m.opInit<PrintOp>(v[4]);
+        m.opInit<PrintOp>(v[4]);
+        m.opInit<PrintOp>(v[6]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(EliminateCommonSubexpressionsTest, can_reuse_values_in_nested_regions_only) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tBool, m.tI64}, m.tNone))
+            .inward(v["c"], 0)
+            .inward(v["a"], 1)
+            .withBody();
+        v[0] = m.opInit<ArithCastOp>(ArithCastOpKind::IntToFloat, m.tF64, v["a"]);
+        m.op<IfOp>(v["c"]).withBody();
+        m.op<ThenOp>().withBody();
+        v[1] = m.opInit<ArithCastOp>(ArithCastOpKind::IntToFloat, m.tF64, v["a"]);
+        v[2] = m.opInit<ArithUnaryOp>(ArithUnaryOpKind::NegI, v["a"]);
+        m.opInit<PrintOp>(v[1]);
+        m.opInit<PrintOp>(v[2]);
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[3] = m.opInit<ArithUnaryOp>(ArithUnaryOpKind::NegI, v["a"]);
+        m.opInit<PrintOp>(v[3]);
+        m.endBody();
+        m.endBody();
+        m.opInit<PrintOp>(v[0]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tBool, m.tI64}, m.tNone))
+            .inward(v["c"], 0)
+            .inward(v["a"], 1)
+            .withBody();
+        v[0] = m.opInit<ArithCastOp>(ArithCastOpKind::IntToFloat, m.tF64, v["a"]);
+        m.op<IfOp>(v["c"]).withBody();
+        m.op<ThenOp>().withBody();
+        v[2] = m.opInit<ArithUnaryOp>(ArithUnaryOpKind::NegI, v["a"]);
+        m.opInit<PrintOp>(v[0]);
+        m.opInit<PrintOp>(v[2]);
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[3] = m.opInit<ArithUnaryOp>(ArithUnaryOpKind::NegI, v["a"]);
+        m.opInit<PrintOp>(v[3]);
+        m.endBody();
+        m.endBody();
+        m.opInit<PrintOp>(v[0]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(EliminateCommonSubexpressionsTest, can_replace_loads_not_separated_by_store) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        m.opInit<StoreOp>(v[0], v["x"]);
+        v[1] = m.opInit<LoadOp>(v[0]);
+        v[2] = m.opInit<LoadOp>(v[0]);
+        m.opInit<PrintOp>(v[1]);
+        m.opInit<PrintOp>(v[2]);
+        m.opInit<StoreOp>(v[0], v[1]);
+        v[3] = m.opInit<LoadOp>(v[0]);
+        m.opInit<PrintOp>(v[3]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        m.opInit<StoreOp>(v[0], v["x"]);
+        v[1] = m.opInit<LoadOp>(v[0]);
+        m.opInit<PrintOp>(v[1]);
+        m.opInit<PrintOp>(v[1]);
+        m.opInit<StoreOp>(v[0], v[1]);
+        v[3] = m.opInit<LoadOp>(v[0]);
+        m.opInit<PrintOp>(v[3]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(EliminateCommonSubexpressionsTest, does_not_replace_loads_in_loop_with_store) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<StoreOp>(v[0], v[1]);
+        v[3] = m.opInit<LoadOp>(v[0]);
+        m.opInit<ForOp>(m.tI64, v[1], v["n"], v[2]).inward(v["i"], 0).withBody();
+        v[4] = m.opInit<LoadOp>(v[0]);
+        m.opInit<PrintOp>(v[4]);
+        m.opInit<StoreOp>(v[0], v["i"]);
+        m.endBody();
+        m.opInit<PrintOp>(v[3]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(EliminateCommonSubexpressionsTest, can_replace_loads_across_store_to_other_memory) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64, 2U));
+        v[1] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[3] = m.opInit<LoadOp>(v[0]);
+        m.opInit<StoreOp>(v[1], v["x"]);
+        m.opInit<StoreOp>(v[0], v["x"], v[2]);
+        v[4] = m.opInit<LoadOp>(v[0]);
+        m.opInit<PrintOp>(v[3]);
+        m.opInit<PrintOp>(v[4]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64, 2U));
+        v[1] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[3] = m.opInit<LoadOp>(v[0]);
+        m.opInit<StoreOp>(v[1], v["x"]);
+        m.opInit<StoreOp>(v[0], v["x"], v[2]);
+        m.opInit<PrintOp>(v[3]);
+        m.opInit<PrintOp>(v[3]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(EliminateCommonSubexpressionsTest, does_not_replace_zeros_of_different_signs) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tF64}, m.tNone)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tF64, 0.0);
+        v[1] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulF, v["x"], v[0]);
+        v[2] = m.opInit<ConstantOp>(m.tF64, -0.0);
+        v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulF, v["x"], v[2]);
+        v[4] = m.opInit<ConstantOp>(m.tF64, 0.0);
+        m.opInit<PrintOp>(v[1]);
+        m.opInit<PrintOp>(v[3]);
+        m.opInit<PrintOp>(v[4]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tF64}, m.tNone)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tF64, 0.0);
+        v[1] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulF, v["x"], v[0]);
+        v[2] = m.opInit<ConstantOp>(m.tF64, -0.0);
+        v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulF, v["x"], v[2]);
+        m.opInit<PrintOp>(v[1]);
+        m.opInit<PrintOp>(v[3]);
+        m.opInit<PrintOp>(v[0]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
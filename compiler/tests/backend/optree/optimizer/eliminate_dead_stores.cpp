@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/transform_factories.hpp"
+#include "compiler/optree/adaptors.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+class EliminateDeadStoresTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(createEliminateDeadStores());
+    }
+
+  public:
+    EliminateDeadStoresTest() = default;
+    ~EliminateDeadStoresTest() = default;
+};
+
+TEST_F(EliminateDeadStoresTest, can_run_on_empty_optree) {
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(EliminateDeadStoresTest, can_forward_stored_values_and_erase_unread_allocations) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("touch", m.tFunc({m.tPtr(m.tI64)}, m.tNone)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        m.opInit<StoreOp>(v["x"], v[0]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tI64)).inward(v["n"], 0).withBody();
+        v[1] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        v[2] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        m.opInit<StoreOp>(v[1], v["n"]);
+        m.opInit<StoreOp>(v[2], v["n"]);
+        m.opInit<FunctionCallOp>("touch", m.tNone, std::vector<Value::Ptr>{v[2]});
+        v[3] = m.opInit<LoadOp>(v[1]);
+        v[4] = m.opInit<LoadOp>(v[2]);
+        v[5] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v[3], v[4]);
+        m.opInit<ReturnOp>(v[5]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("touch", m.tFunc({m.tPtr(m.tI64)}, m.tNone)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        m.opInit<StoreOp>(v["x"], v[0]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tI64)).inward(v["n"], 0).withBody();
+        v[2] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        m.opInit<StoreOp>(v[2], v["n"]);
+        m.opInit<FunctionCallOp>("touch", m.tNone, std::vector<Value::Ptr>{v[2]});
+        v[4] = m.opInit<LoadOp>(v[2]);
+        v[5] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["n"], v[4]);
+        m.opInit<ReturnOp>(v[5]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(EliminateDeadStoresTest, can_erase_overwritten_stores) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tPtr(m.tI64, 2U)}, m.tNone)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<StoreOp>(v["x"], v[0]);
+        m.opInit<StoreOp>(v["x"], v[0], v[0]);
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        m.opInit<StoreOp>(v["x"], v[1]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tPtr(m.tI64, 2U)}, m.tNone)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<StoreOp>(v["x"], v[0], v[0]);
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        m.opInit<StoreOp>(v["x"], v[1]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(EliminateDeadStoresTest, does_not_erase_stores_which_may_be_read) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tPtr(m.tI64)}, m.tNone)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<StoreOp>(v["x"], v[0]);
+        m.opInit<FunctionCallOp>("unknown", m.tNone, std::vector<Value::Ptr>{v["x"]});
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        m.opInit<StoreOp>(v["x"], v[1]);
+        v[2] = m.opInit<LoadOp>(m.tI64, v["x"]);
+        m.opInit<PrintOp>(v[2]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tPtr(m.tI64)}, m.tNone)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<StoreOp>(v["x"], v[0]);
+        m.opInit<FunctionCallOp>("unknown", m.tNone, std::vector<Value::Ptr>{v["x"]});
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        m.opInit<StoreOp>(v["x"], v[1]);
+        m.opInit<PrintOp>(v[1]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(EliminateDeadStoresTest, does_not_forward_values_written_in_loop) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        m.opInit<StoreOp>(v[0], v[1]);
+        m.op<WhileOp>().withBody();
+        m.op<ConditionOp>().withBody();
+        v[2] = m.opInit<LoadOp>(v[0]);
+        v[3] = m.opInit<ConstantOp>(m.tI64, int64_t(10));
+        v[4] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessI, v[2], v[3]);
+        m.endBody();
+        v[5] = m.opInit<LoadOp>(v[0]);
+        m.opInit<PrintOp>(v[5]);
+        m.opInit<InputOp>(v[0]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
@@ -0,0 +1,320 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/transform_factories.hpp"
+#include "compiler/optree/adaptors.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+class EliminateTailRecursionTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(createEliminateTailRecursion());
+    }
+
+  public:
+    EliminateTailRecursionTest() = default;
+    ~EliminateTailRecursionTest() = default;
+};
+
+TEST_F(EliminateTailRecursionTest, can_run_on_empty_optree) {
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(EliminateTailRecursionTest, can_turn_tail_call_into_loop) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("fact", m.tFunc({m.tI64, m.tI64}, m.tI64))
+            .inward(v["n"], 0)
+            .inward(v["acc"], 1)
+            .withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[1] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessEqualI, v["n"], v[0]);
+        m.op<IfOp>(v[1]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<ReturnOp>(v["acc"]);
+        m.endBody();
+        m.endBody();
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["n"], v[0]);
+        v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["acc"], v["n"]);
+        v[4] = m.opInit<FunctionCallOp>("fact", m.tI64, std::vector<Value::Ptr>{v[2], v[3]});
+        m.opInit<ReturnOp>(v[4]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("fact", m.tFunc({m.tI64, m.tI64}, m.tI64))
+            .inward(v["n"], 0)
+            .inward(v["acc"], 1)
+            .withBody();
+        v[5] = m.opInit<ConstantOp>(m.tBool, false);
+        v[6] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        m.op<WhileOp>(v["n"], v["acc"], v[5], v[6])
+            .inward(v["n'"], m.tI64)
+            .inward(v["acc'"], m.tI64)
+            .inward(v["done"], m.tBool)
+            .inward(v["res"], m.tI64)
+            .result(m.tI64)
+            .result(m.tI64)
+            .result(m.tBool)
+            .result(v[7], m.tI64);
+        m.withBody();
+        m.op<ConditionOp>().withBody();
+        m.opInit<LogicUnaryOp>(LogicUnaryOpKind::Not, v["done"]);
+        m.endBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[1] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessEqualI, v["n'"], v[0]);
+        m.op<IfOp>(v[1])
+            .result(v[8], m.tI64)
+            .result(v[9], m.tI64)
+            .result(v[10], m.tBool)
+            .result(v[11], m.tI64);
+        m.withBody();
+        m.op<ThenOp>().withBody();
+        v[12] = m.opInit<ConstantOp>(m.tBool, true);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v["n'"], v["acc'"], v[12], v["acc'"]});
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["n'"], v[0]);
+        v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["acc'"], v["n'"]);
+        v[13] = m.opInit<ConstantOp>(m.tBool, false);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[2], v[3], v[13], v["res"]});
+        m.endBody();
+        m.endBody();
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[8], v[9], v[10], v[11]});
+        m.endBody();
+        m.opInit<ReturnOp>(v[7]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(EliminateTailRecursionTest, can_turn_accumulating_tail_call_into_loop) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("fact", m.tFunc({m.tI64}, m.tI64)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[1] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessEqualI, v["n"], v[0]);
+        m.op<IfOp>(v[1]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<ReturnOp>(v[0]);
+        m.endBody();
+        m.endBody();
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["n"], v[0]);
+        v[3] = m.opInit<FunctionCallOp>("fact", m.tI64, std::vector<Value::Ptr>{v[2]});
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["n"], v[3]);
+        m.opInit<ReturnOp>(v[4]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("fact", m.tFunc({m.tI64}, m.tI64)).inward(v["n"], 0).withBody();
+        v[5] = m.opInit<ConstantOp>(m.tBool, false);
+        v[6] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[7] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.op<WhileOp>(v["n"], v[5], v[6], v[7])
+            .inward(v["n'"], m.tI64)
+            .inward(v["done"], m.tBool)
+            .inward(v["res"], m.tI64)
+            .inward(v["acc"], m.tI64)
+            .result(m.tI64)
+            .result(m.tBool)
+            .result(v[8], m.tI64)
+            .result(m.tI64);
+        m.withBody();
+        m.op<ConditionOp>().withBody();
+        m.opInit<LogicUnaryOp>(LogicUnaryOpKind::Not, v["done"]);
+        m.endBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[1] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessEqualI, v["n'"], v[0]);
+        m.op<IfOp>(v[1])
+            .result(v[9], m.tI64)
+            .result(v[10], m.tBool)
+            .result(v[11], m.tI64)
+            .result(v[12], m.tI64);
+        m.withBody();
+        m.op<ThenOp>().withBody();
+        v[13] = m.opInit<ConstantOp>(m.tBool, true);
+        v[14] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["acc"], v[0]);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v["n'"], v[13], v[14], v["acc"]});
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["n'"], v[0]);
+        v[15] = m.opInit<ConstantOp>(m.tBool, false);
+        v[16] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["acc"], v["n'"]);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[2], v[15], v["res"], v[16]});
+        m.endBody();
+        m.endBody();
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[9], v[10], v[11], v[12]});
+        m.endBody();
+        m.opInit<ReturnOp>(v[8]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(EliminateTailRecursionTest, can_turn_void_tail_call_into_loop) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("countdown", m.tFunc({m.tI64}, m.tNone)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[1] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessI, v["n"], v[0]);
+        m.op<IfOp>(v[1]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+        m.endBody();
+        m.opInit<PrintOp>(v["n"]);
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["n"], v[0]);
+        m.opInit<FunctionCallOp>("countdown", m.tNone, std::vector<Value::Ptr>{v[2]});
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("countdown", m.tFunc({m.tI64}, m.tNone)).inward(v["n"], 0).withBody();
+        v[3] = m.opInit<ConstantOp>(m.tBool, false);
+        m.op<WhileOp>(v["n"], v[3])
+            .inward(v["n'"], m.tI64)
+            .inward(v["done"], m.tBool)
+            .result(m.tI64)
+            .result(m.tBool);
+        m.withBody();
+        m.op<ConditionOp>().withBody();
+        m.opInit<LogicUnaryOp>(LogicUnaryOpKind::Not, v["done"]);
+        m.endBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[1] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessI, v["n'"], v[0]);
+        m.op<IfOp>(v[1]).result(v[4], m.tI64).result(v[5], m.tBool);
+        m.withBody();
+        m.op<ThenOp>().withBody();
+        v[6] = m.opInit<ConstantOp>(m.tBool, true);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v["n'"], v[6]});
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        m.opInit<PrintOp>(v["n'"]);
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["n'"], v[0]);
+        v[7] = m.opInit<ConstantOp>(m.tBool, false);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[2], v[7]});
+        m.endBody();
+        m.endBody();
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[4], v[5]});
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(EliminateTailRecursionTest, can_move_operations_following_branching_into_fallthrough_branch) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("sum", m.tFunc({m.tI64, m.tI64}, m.tI64))
+            .inward(v["n"], 0)
+            .inward(v["acc"], 1)
+            .withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[1] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessI, v["n"], v[0]);
+        m.op<IfOp>(v[1]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<ReturnOp>(v["acc"]);
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        m.opInit<PrintOp>(v["n"]);
+        m.endBody();
+        m.endBody();
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["n"], v[0]);
+        v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["acc"], v["n"]);
+        v[4] = m.opInit<FunctionCallOp>("sum", m.tI64, std::vector<Value::Ptr>{v[2], v[3]});
+        m.opInit<ReturnOp>(v[4]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("sum", m.tFunc({m.tI64, m.tI64}, m.tI64))
+            .inward(v["n"], 0)
+            .inward(v["acc"], 1)
+            .withBody();
+        v[5] = m.opInit<ConstantOp>(m.tBool, false);
+        v[6] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        m.op<WhileOp>(v["n"], v["acc"], v[5], v[6])
+            .inward(v["n'"], m.tI64)
+            .inward(v["acc'"], m.tI64)
+            .inward(v["done"], m.tBool)
+            .inward(v["res"], m.tI64)
+            .result(m.tI64)
+            .result(m.tI64)
+            .result(m.tBool)
+            .result(v[7], m.tI64);
+        m.withBody();
+        m.op<ConditionOp>().withBody();
+        m.opInit<LogicUnaryOp>(LogicUnaryOpKind::Not, v["done"]);
+        m.endBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[1] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessI, v["n'"], v[0]);
+        m.op<IfOp>(v[1])
+            .result(v[8], m.tI64)
+            .result(v[9], m.tI64)
+            .result(v[10], m.tBool)
+            .result(v[11], m.tI64);
+        m.withBody();
+        m.op<ThenOp>().withBody();
+        v[12] = m.opInit<ConstantOp>(m.tBool, true);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v["n'"], v["acc'"], v[12], v["acc'"]});
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        m.opInit<PrintOp>(v["n'"]);
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["n'"], v[0]);
+        v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["acc'"], v["n'"]);
+        v[13] = m.opInit<ConstantOp>(m.tBool, false);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[2], v[3], v[13], v["res"]});
+        m.endBody();
+        m.endBody();
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[8], v[9], v[10], v[11]});
+        m.endBody();
+        m.opInit<ReturnOp>(v[7]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(EliminateTailRecursionTest, can_not_turn_tail_calls_with_different_accumulations_into_loop) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("f", m.tFunc({m.tI64}, m.tI64)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[1] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessEqualI, v["n"], v[0]);
+        m.op<IfOp>(v[1]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<ReturnOp>(v[0]);
+        m.endBody();
+        m.endBody();
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["n"], v[0]);
+        v[3] = m.opInit<ConstantOp>(m.tI64, int64_t(10));
+        v[4] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessI, v["n"], v[3]);
+        m.op<IfOp>(v[4]).withBody();
+        m.op<ThenOp>().withBody();
+        v[5] = m.opInit<FunctionCallOp>("f", m.tI64, std::vector<Value::Ptr>{v[2]});
+        v[6] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["n"], v[5]);
+        m.opInit<ReturnOp>(v[6]);
+        m.endBody();
+        m.endBody();
+        v[7] = m.opInit<FunctionCallOp>("f", m.tI64, std::vector<Value::Ptr>{v[2]});
+        v[8] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["n"], v[7]);
+        m.opInit<ReturnOp>(v[8]);
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
@@ -104,3 +104,21 @@ TEST_F(EraseUnusedOpsTest, can_keep_irrelevant_ops) {
     runOptimizer();
     assertSameOpTree();
 }
+
+TEST_F(EraseUnusedOpsTest, can_keep_loop_condition_predicate) {
+    auto &&[m, v] = getActual();
+
+    m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["x"], 0).withBody();
+    m.op<WhileOp>().withBody();
+    m.op<ConditionOp>().withBody();
+    v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+    v[1] = m.opInit<LogicBinaryOp>(LogicBinOpKind::GreaterI, v["x"], v[0]);
+    m.endBody();
+    m.endBody();
+    m.opInit<ReturnOp>();
+    m.endBody();
+
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
@@ -0,0 +1,82 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/transform_factories.hpp"
+#include "compiler/optree/adaptors.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+class EvaluatePureCallsTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(createEvaluatePureCalls());
+    }
+
+  public:
+    EvaluatePureCallsTest() = default;
+    ~EvaluatePureCallsTest() = default;
+};
+
+TEST_F(EvaluatePureCallsTest, can_run_on_empty_optree) {
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(EvaluatePureCallsTest, can_replace_calls_with_constant_arguments) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("square", m.tFunc({m.tF64}, m.tF64)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulF, v["x"], v["x"]);
+        m.opInit<ReturnOp>(v[0]);
+        m.endBody();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tF64}, m.tNone)).inward(v["y"], 0).withBody();
+        v[1] = m.opInit<ConstantOp>(m.tF64, 1.5);
+        v[2] = m.opInit<FunctionCallOp>("square", m.tF64, std::vector<Value::Ptr>{v[1]});
+        m.opInit<PrintOp>(v[2]);
+        v[3] = m.opInit<FunctionCallOp>("square", m.tF64, std::vector<Value::Ptr>{v["y"]});
+        m.opInit<PrintOp>(v[3]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("square", m.tFunc({m.tF64}, m.tF64)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulF, v["x"], v["x"]);
+        m.opInit<ReturnOp>(v[0]);
+        m.endBody();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tF64}, m.tNone)).inward(v["y"], 0).withBody();
+        v[1] = m.opInit<ConstantOp>(m.tF64, 1.5);
+        v[4] = m.opInit<ConstantOp>(m.tF64, 2.25);
+        m.opInit<PrintOp>(v[4]);
+        v[3] = m.opInit<FunctionCallOp>("square", m.tF64, std::vector<Value::Ptr>{v["y"]});
+        m.opInit<PrintOp>(v[3]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(EvaluatePureCallsTest, keeps_calls_performing_io) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("log", m.tFunc({m.tI64}, m.tI64)).inward(v["x"], 0).withBody();
+        m.opInit<PrintOp>(v["x"]);
+        m.opInit<ReturnOp>(v["x"]);
+        m.endBody();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[1] = m.opInit<FunctionCallOp>("log", m.tI64, std::vector<Value::Ptr>{v[0]});
+        m.opInit<PrintOp>(v[1]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
@@ -1,3 +1,6 @@
+#include <cstdint>
+#include <limits>
+
 #include <gtest/gtest.h>
 
 #include "compiler/backend/optree/optimizer/optimizer.hpp"
@@ -275,3 +278,49 @@ TEST_F(FoldConstantsTest, can_fold_constants_in_multiple_ops) {
     runOptimizer();
     assertSameOpTree();
 }
+
+TEST_F(FoldConstantsTest, can_fold_constants_arith_unary_op) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, std::numeric_limits<int64_t>::min());
+        v[1] = m.opInit<ConstantOp>(m.tF64, 1.5);
+        m.opInit<ArithUnaryOp>(ArithUnaryOpKind::NegI, v[0]);
+        m.opInit<ArithUnaryOp>(ArithUnaryOpKind::NegF, v[1]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, std::numeric_limits<int64_t>::min());
+        v[1] = m.opInit<ConstantOp>(m.tF64, 1.5);
+        m.opInit<ConstantOp>(m.tI64, std::numeric_limits<int64_t>::min());
+        m.opInit<ConstantOp>(m.tF64, -1.5);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(FoldConstantsTest, can_not_fold_undefined_arith_binary_integer_op) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(10));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[2] = m.opInit<ConstantOp>(m.tI64, std::numeric_limits<int64_t>::min());
+        v[3] = m.opInit<ConstantOp>(m.tI64, int64_t(-1));
+        v[4] = m.opInit<ConstantOp>(m.tI64, int64_t(64));
+        m.opInit<ArithBinaryOp>(ArithBinOpKind::DivI, v[0], v[1]);
+        m.opInit<ArithBinaryOp>(ArithBinOpKind::DivI, v[2], v[3]);
+        m.opInit<ArithBinaryOp>(ArithBinOpKind::ShlI, v[0], v[4]);
+        m.opInit<ArithBinaryOp>(ArithBinOpKind::ShrI, v[0], v[3]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
@@ -0,0 +1,182 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/transform_factories.hpp"
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/types.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+class FuseLoopsTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(createFuseLoops());
+    }
+
+  public:
+    FuseLoopsTest() = default;
+    ~FuseLoopsTest() = default;
+};
+
+TEST_F(FuseLoopsTest, can_run_on_empty_optree) {
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(FuseLoopsTest, can_fuse_loops_accessing_same_elements) {
+    // for i in range(n): a[i] = i
+    // for i in range(n): b[i] = a[i] * 2
+    {
+        auto &&[m, v] = getActual();
+        auto tList = m.tPtr(m.tI64, PointerType::dynamic);
+        m.opInit<FunctionOp>("test", m.tFunc({tList, tList, m.tI64}, m.tNone))
+            .inward(v["a"], 0)
+            .inward(v["b"], 1)
+            .inward(v["n"], 2)
+            .withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        m.opInit<StoreOp>(v["a"], v["i"], v["i"]);
+        m.endBody();
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[3] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        m.opInit<ForOp>(m.tI64, v[2], v["n"], v[1]).inward(v["j"], 0).withBody();
+        v[4] = m.opInit<LoadOp>(v["a"], v["j"]);
+        v[5] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v[4], v[3]);
+        m.opInit<StoreOp>(v["b"], v[5], v["j"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        auto tList = m.tPtr(m.tI64, PointerType::dynamic);
+        m.opInit<FunctionOp>("test", m.tFunc({tList, tList, m.tI64}, m.tNone))
+            .inward(v["a"], 0)
+            .inward(v["b"], 1)
+            .inward(v["n"], 2)
+            .withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[3] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        m.opInit<StoreOp>(v["a"], v["i"], v["i"]);
+        v[4] = m.opInit<LoadOp>(v["a"], v["i"]);
+        v[5] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v[4], v[3]);
+        m.opInit<StoreOp>(v["b"], v[5], v["i"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(FuseLoopsTest, can_fuse_loops_with_carried_values) {
+    // for i in range(n): a[i] = i
+    // s = 0; for i in range(n): s += a[i]
+    {
+        auto &&[m, v] = getActual();
+        auto tList = m.tPtr(m.tI64, PointerType::dynamic);
+        m.opInit<FunctionOp>("test", m.tFunc({tList, m.tI64}, m.tI64)).inward(v["a"], 0).inward(v["n"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        m.opInit<StoreOp>(v["a"], v["i"], v["i"]);
+        m.endBody();
+        v[2] = m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1])
+                   .operand(v[0])
+                   .inward(v["j"], 0)
+                   .inward(v["s"], m.tI64)
+                   .result(m.tI64);
+        m.withBody();
+        v[3] = m.opInit<LoadOp>(v["a"], v["j"]);
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["s"], v[3]);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[4]});
+        m.endBody();
+        m.opInit<ReturnOp>(v[2]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        auto tList = m.tPtr(m.tI64, PointerType::dynamic);
+        m.opInit<FunctionOp>("test", m.tFunc({tList, m.tI64}, m.tI64)).inward(v["a"], 0).inward(v["n"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1])
+                   .operand(v[0])
+                   .inward(v["i"], 0)
+                   .inward(v["s"], m.tI64)
+                   .result(m.tI64);
+        m.withBody();
+        m.opInit<StoreOp>(v["a"], v["i"], v["i"]);
+        v[3] = m.opInit<LoadOp>(v["a"], v["i"]);
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["s"], v[3]);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[4]});
+        m.endBody();
+        m.opInit<ReturnOp>(v[2]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(FuseLoopsTest, can_not_fuse_loops_reading_other_elements) {
+    // for i in range(n): a[i] = i
+    // for i in range(n): b[i] = a[n - 1 - i]
+    {
+        auto &&[m, v] = getActual();
+        auto tList = m.tPtr(m.tI64, PointerType::dynamic);
+        m.opInit<FunctionOp>("test", m.tFunc({tList, tList, m.tI64}, m.tNone))
+            .inward(v["a"], 0)
+            .inward(v["b"], 1)
+            .inward(v["n"], 2)
+            .withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["n"], v[1]);
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        m.opInit<StoreOp>(v["a"], v["i"], v["i"]);
+        m.endBody();
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["j"], 0).withBody();
+        v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v[2], v["j"]);
+        v[4] = m.opInit<LoadOp>(v["a"], v[3]);
+        m.opInit<StoreOp>(v["b"], v[4], v["j"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(FuseLoopsTest, can_not_fuse_loops_with_different_iterations) {
+    // for i in range(n): print(i)
+    // for i in range(1, n): a[i] = i
+    {
+        auto &&[m, v] = getActual();
+        auto tList = m.tPtr(m.tI64, PointerType::dynamic);
+        m.opInit<FunctionOp>("test", m.tFunc({tList, m.tI64}, m.tNone)).inward(v["a"], 0).inward(v["n"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        m.opInit<PrintOp>(v["i"]);
+        m.endBody();
+        m.opInit<ForOp>(m.tI64, v[1], v["n"], v[1]).inward(v["j"], 0).withBody();
+        m.opInit<StoreOp>(v["a"], v["j"], v["j"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
@@ -47,11 +47,11 @@ TEST_F(HoistLoopInvariantsTest, can_hoist_loop_invariants) {
         m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tF64}, m.tNone)).inward(v["x"], 0).inward(v["y"], 1).withBody();
         v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
         v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["x"], v[2]);
         m.op<WhileOp>().withBody();
         m.op<ConditionOp>().withBody();
         v[1] = m.opInit<LogicBinaryOp>(LogicBinOpKind::NotEqual, v["x"], v[0]);
         m.endBody();
-        v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["x"], v[2]);
         m.opInit<StoreOp>(v["x"], v[3]);
         m.endBody();
         m.opInit<ReturnOp>();
@@ -60,3 +60,132 @@ TEST_F(HoistLoopInvariantsTest, can_hoist_loop_invariants) {
     runOptimizer();
     assertSameOpTree();
 }
+
+TEST_F(HoistLoopInvariantsTest, does_not_hoist_iterator_users) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["i"], v[1]);
+        m.opInit<PrintOp>(v[2]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(HoistLoopInvariantsTest, can_hoist_from_nested_regions) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tBool}, m.tNone))
+            .inward(v["n"], 0)
+            .inward(v["c"], 1)
+            .withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64, 4U));
+        v[1] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[3] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<ForOp>(m.tI64, v[2], v["n"], v[3]).inward(v["i"], 0).withBody();
+        m.op<IfOp>(v["c"]).withBody();
+        m.op<ThenOp>().withBody();
+        v[4] = m.opInit<LoadOp>(v[0], v[3]);
+        v[5] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v[4], v[4]);
+        m.opInit<StoreOp>(v[1], v[5]);
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tBool}, m.tNone))
+            .inward(v["n"], 0)
+            .inward(v["c"], 1)
+            .withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64, 4U));
+        v[1] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[3] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[4] = m.opInit<LoadOp>(v[0], v[3]);
+        v[5] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v[4], v[4]);
+        m.opInit<ForOp>(m.tI64, v[2], v["n"], v[3]).inward(v["i"], 0).withBody();
+        m.op<IfOp>(v["c"]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<StoreOp>(v[1], v[5]);
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(HoistLoopInvariantsTest, does_not_hoist_loads_of_written_memory) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<ForOp>(m.tI64, v[1], v["n"], v[2]).inward(v["i"], 0).withBody();
+        v[3] = m.opInit<LoadOp>(v[0]);
+        m.opInit<PrintOp>(v[3]);
+        m.op<WhileOp>().withBody();
+        m.op<ConditionOp>().withBody();
+        v[4] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessI, v[1], v["n"]);
+        m.endBody();
+        m.opInit<InputOp>(v[0]);
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(HoistLoopInvariantsTest, does_not_hoist_division_by_unknown_value) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tI64}, m.tNone)).inward(v["n"], 0).inward(v["d"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::DivI, v["n"], v["d"]);
+        m.opInit<PrintOp>(v[2]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(HoistLoopInvariantsTest, does_not_hoist_division_by_minus_one) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tI64}, m.tNone)).inward(v["n"], 0).inward(v["x"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(-1));
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::DivI, v["x"], v[2]);
+        m.opInit<PrintOp>(v[3]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/transform_factories.hpp"
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/utils/language.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+class InlineFunctionsTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(createInlineFunctions(16U));
+    }
+
+  public:
+    InlineFunctionsTest() = default;
+    ~InlineFunctionsTest() = default;
+};
+
+TEST_F(InlineFunctionsTest, can_run_on_empty_optree) {
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(InlineFunctionsTest, can_inline_small_function) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("inc", m.tFunc({m.tI64}, m.tI64)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[1] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["x"], v[0]);
+        m.opInit<ReturnOp>(v[1]);
+        m.endBody();
+        m.opInit<FunctionOp>("main", m.tFunc(m.tNone)).withBody();
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[3] = m.opInit<FunctionCallOp>("inc", m.tI64, std::vector<Value::Ptr>{v[2]});
+        m.opInit<PrintOp>(v[3]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("inc", m.tFunc({m.tI64}, m.tI64)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[1] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["x"], v[0]);
+        m.opInit<ReturnOp>(v[1]);
+        m.endBody();
+        m.opInit<FunctionOp>("main", m.tFunc(m.tNone)).withBody();
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[4] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[5] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v[2], v[4]);
+        m.opInit<PrintOp>(v[5]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(InlineFunctionsTest, can_force_inlining_with_decorator) {
+    auto makeModule = [](DeclarativeModule &m, ValueStorage &v, bool inlined) {
+        m.opInit<FunctionOp>("big", m.tFunc({m.tI64}, m.tNone)).inward(v["x"], 0);
+        m.attr(utils::language::atInline).withBody();
+        for (int i = 0; i < 10; i++)
+            m.opInit<PrintOp>(v["x"]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+        m.opInit<FunctionOp>("main", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        for (int i = 0; i < 2; i++) {
+            if (inlined) {
+                for (int j = 0; j < 10; j++)
+                    m.opInit<PrintOp>(v[0]);
+            } else {
+                m.opInit<FunctionCallOp>("big", m.tNone, std::vector<Value::Ptr>{v[0]});
+            }
+        }
+        m.opInit<ReturnOp>();
+        m.endBody();
+    };
+    {
+        auto &&[m, v] = getActual();
+        makeModule(m, v, false);
+    }
+    {
+        auto &&[m, v] = getExpected();
+        makeModule(m, v, true);
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(InlineFunctionsTest, does_not_inline_large_function_with_many_calls) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("big", m.tFunc({m.tI64}, m.tNone)).inward(v["x"], 0).withBody();
+        for (int i = 0; i < 10; i++)
+            m.opInit<PrintOp>(v["x"]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+        m.opInit<FunctionOp>("main", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        m.opInit<FunctionCallOp>("big", m.tNone, std::vector<Value::Ptr>{v[0]});
+        m.opInit<FunctionCallOp>("big", m.tNone, std::vector<Value::Ptr>{v[0]});
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(InlineFunctionsTest, does_not_inline_recursive_functions) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("rec", m.tFunc({m.tI64}, m.tI64)).inward(v["x"], 0);
+        m.attr(utils::language::atInline).withBody();
+        v[0] = m.opInit<FunctionCallOp>("rec", m.tI64, std::vector<Value::Ptr>{v["x"]});
+        m.opInit<ReturnOp>(v[0]);
+        m.endBody();
+        m.opInit<FunctionOp>("main", m.tFunc(m.tNone)).withBody();
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[2] = m.opInit<FunctionCallOp>("rec", m.tI64, std::vector<Value::Ptr>{v[1]});
+        m.opInit<PrintOp>(v[2]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(InlineFunctionsTest, can_inline_hot_function_with_many_calls) {
+    auto makeCallee = [](DeclarativeModule &m, ValueStorage &v) {
+        m.opInit<FunctionOp>("big", m.tFunc({m.tI64}, m.tNone)).inward(v["x"], 0);
+        m.attr(int64_t(1000)).withBody();
+        for (int i = 0; i < 10; i++)
+            m.opInit<PrintOp>(v["x"]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    };
+    {
+        auto &&[m, v] = getActual();
+        makeCallee(m, v);
+        m.opInit<FunctionOp>("main", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        m.opInit<FunctionCallOp>("big", m.tNone, std::vector<Value::Ptr>{v[0]});
+        m.opInit<FunctionCallOp>("big", m.tNone, std::vector<Value::Ptr>{v[0]});
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        makeCallee(m, v);
+        m.opInit<FunctionOp>("main", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        for (int i = 0; i < 20; i++)
+            m.opInit<PrintOp>(v[0]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(InlineFunctionsTest, does_not_inline_cold_function) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("cold", m.tFunc({m.tI64}, m.tNone)).inward(v["x"], 0);
+        m.attr(int64_t(0)).withBody();
+        for (int i = 0; i < 10; i++)
+            m.opInit<PrintOp>(v["x"]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+        m.opInit<FunctionOp>("main", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        m.opInit<FunctionCallOp>("cold", m.tNone, std::vector<Value::Ptr>{v[0]});
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
@@ -0,0 +1,149 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/transform_factories.hpp"
+#include "compiler/optree/adaptors.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+class MergeIdenticalFunctionsTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(createMergeIdenticalFunctions());
+    }
+
+  public:
+    MergeIdenticalFunctionsTest() = default;
+    ~MergeIdenticalFunctionsTest() = default;
+};
+
+TEST_F(MergeIdenticalFunctionsTest, can_run_on_empty_optree) {
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(MergeIdenticalFunctionsTest, can_merge_identical_functions) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("main", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, 1);
+        v[1] = m.opInit<FunctionCallOp>("first", m.tI64, std::vector<Value::Ptr>{v[0], v[0]});
+        v[2] = m.opInit<FunctionCallOp>("second", m.tI64, std::vector<Value::Ptr>{v[1], v[0]});
+        m.opInit<PrintOp>(v[2]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+        m.opInit<FunctionOp>("first", m.tFunc({m.tI64, m.tI64}, m.tI64)).inward(v[3], 0).inward(v[4], 1).withBody();
+        v[5] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v[3], v[4]);
+        m.opInit<ReturnOp>(v[5]);
+        m.endBody();
+        m.opInit<FunctionOp>("second", m.tFunc({m.tI64, m.tI64}, m.tI64)).inward(v[6], 0).inward(v[7], 1).withBody();
+        v[8] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v[6], v[7]);
+        m.opInit<ReturnOp>(v[8]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("main", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, 1);
+        v[1] = m.opInit<FunctionCallOp>("first", m.tI64, std::vector<Value::Ptr>{v[0], v[0]});
+        v[2] = m.opInit<FunctionCallOp>("first", m.tI64, std::vector<Value::Ptr>{v[1], v[0]});
+        m.opInit<PrintOp>(v[2]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+        m.opInit<FunctionOp>("first", m.tFunc({m.tI64, m.tI64}, m.tI64)).inward(v[3], 0).inward(v[4], 1).withBody();
+        v[5] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v[3], v[4]);
+        m.opInit<ReturnOp>(v[5]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(MergeIdenticalFunctionsTest, can_merge_functions_identical_after_redirecting_calls) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("first", m.tFunc(m.tI64)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, 2);
+        m.opInit<ReturnOp>(v[0]);
+        m.endBody();
+        m.opInit<FunctionOp>("second", m.tFunc(m.tI64)).withBody();
+        v[1] = m.opInit<ConstantOp>(m.tI64, 2);
+        m.opInit<ReturnOp>(v[1]);
+        m.endBody();
+        m.opInit<FunctionOp>("callFirst", m.tFunc(m.tNone)).withBody();
+        v[2] = m.opInit<FunctionCallOp>("first", m.tI64, std::vector<Value::Ptr>{});
+        m.opInit<PrintOp>(v[2]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+        m.opInit<FunctionOp>("callSecond", m.tFunc(m.tNone)).withBody();
+        v[3] = m.opInit<FunctionCallOp>("second", m.tI64, std::vector<Value::Ptr>{});
+        m.opInit<PrintOp>(v[3]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("first", m.tFunc(m.tI64)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, 2);
+        m.opInit<ReturnOp>(v[0]);
+        m.endBody();
+        m.opInit<FunctionOp>("callFirst", m.tFunc(m.tNone)).withBody();
+        v[2] = m.opInit<FunctionCallOp>("first", m.tI64, std::vector<Value::Ptr>{});
+        m.opInit<PrintOp>(v[2]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(MergeIdenticalFunctionsTest, can_not_merge_functions_with_different_operands_order_or_types) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("first", m.tFunc({m.tI64, m.tI64}, m.tI64)).inward(v[0], 0).inward(v[1], 1).withBody();
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v[0], v[1]);
+        m.opInit<ReturnOp>(v[2]);
+        m.endBody();
+        m.opInit<FunctionOp>("second", m.tFunc({m.tI64, m.tI64}, m.tI64)).inward(v[3], 0).inward(v[4], 1).withBody();
+        v[5] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v[4], v[3]);
+        m.opInit<ReturnOp>(v[5]);
+        m.endBody();
+        m.opInit<FunctionOp>("third", m.tFunc({m.tF64, m.tF64}, m.tF64)).inward(v[6], 0).inward(v[7], 1).withBody();
+        v[8] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubF, v[6], v[7]);
+        m.opInit<ReturnOp>(v[8]);
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(MergeIdenticalFunctionsTest, can_not_merge_functions_with_zeros_of_different_signs) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("main", m.tFunc({m.tF64}, m.tNone)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<FunctionCallOp>("first", m.tF64, std::vector<Value::Ptr>{v["x"]});
+        v[1] = m.opInit<FunctionCallOp>("second", m.tF64, std::vector<Value::Ptr>{v["x"]});
+        m.opInit<PrintOp>(v[0]);
+        m.opInit<PrintOp>(v[1]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+        m.opInit<FunctionOp>("first", m.tFunc({m.tF64}, m.tF64)).inward(v[2], 0).withBody();
+        v[3] = m.opInit<ConstantOp>(m.tF64, 0.0);
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulF, v[2], v[3]);
+        m.opInit<ReturnOp>(v[4]);
+        m.endBody();
+        m.opInit<FunctionOp>("second", m.tFunc({m.tF64}, m.tF64)).inward(v[5], 0).withBody();
+        v[6] = m.opInit<ConstantOp>(m.tF64, -0.0);
+        v[7] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulF, v[5], v[6]);
+        m.opInit<ReturnOp>(v[7]);
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
@@ -0,0 +1,157 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/transform_factories.hpp"
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/types.hpp"
+#include "compiler/utils/language.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+class ParallelizeLoopsTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(createParallelizeLoops(1000U));
+    }
+
+  public:
+    ParallelizeLoopsTest() = default;
+    ~ParallelizeLoopsTest() = default;
+};
+
+TEST_F(ParallelizeLoopsTest, can_run_on_empty_optree) {
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(ParallelizeLoopsTest, can_outline_loop_with_independent_iterations) {
+    // for i in range(2000): a[i] = i * 2
+    {
+        auto &&[m, v] = getActual();
+        auto tList = m.tPtr(m.tI64, PointerType::dynamic);
+        m.opInit<FunctionOp>("test", m.tFunc({tList}, m.tNone)).inward(v["a"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2000));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[3] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        m.opInit<ForOp>(m.tI64, v[0], v[1], v[2]).inward(v["i"], 0).withBody();
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["i"], v[3]);
+        m.opInit<StoreOp>(v["a"], v[4], v["i"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        auto tList = m.tPtr(m.tI64, PointerType::dynamic);
+        m.opInit<FunctionOp>("test", m.tFunc({tList}, m.tNone)).inward(v["a"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2000));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[3] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        m.opInit<FunctionCallOp>("test.parallel.1", m.tNone, std::vector<Value::Ptr>{v[0], v[1], v[2], v["a"]});
+        m.opInit<ReturnOp>();
+        m.endBody();
+        m.opInit<FunctionOp>("test.parallel.1", m.tFunc({m.tI64, m.tI64, m.tI64, tList}, m.tNone))
+            .inward(v["begin"], 0)
+            .inward(v["end"], 1)
+            .inward(v["step"], 2)
+            .inward(v["b"], 3);
+        m.attr(utils::language::atParallel).withBody();
+        v[5] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[6] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<ForOp>(m.tI64, v["begin"], v["end"], v[6]).inward(v["j"], 0).withBody();
+        v[7] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["j"], v[5]);
+        m.opInit<StoreOp>(v["b"], v[7], v["j"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(ParallelizeLoopsTest, can_keep_sequential_loop_for_dynamic_trip_count) {
+    // for i in range(n): a[i] = i
+    auto makeFunction = [](DeclarativeModule &m, ValueStorage &v) {
+        auto tList = m.tPtr(m.tI64, PointerType::dynamic);
+        m.opInit<FunctionOp>("test", m.tFunc({tList, m.tI64}, m.tNone)).inward(v["a"], 0).inward(v["n"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+    };
+    {
+        auto &&[m, v] = getActual();
+        makeFunction(m, v);
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        m.opInit<StoreOp>(v["a"], v["i"], v["i"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        auto tList = m.tPtr(m.tI64, PointerType::dynamic);
+        makeFunction(m, v);
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(999));
+        v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["n"], v[0]);
+        v[4] = m.opInit<LogicBinaryOp>(LogicBinOpKind::GreaterI, v[3], v[2]);
+        m.op<IfOp>(v[4]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<FunctionCallOp>("test.parallel.1", m.tNone, std::vector<Value::Ptr>{v[0], v["n"], v[1], v["a"]});
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        m.opInit<StoreOp>(v["a"], v["i"], v["i"]);
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+        m.opInit<FunctionOp>("test.parallel.1", m.tFunc({m.tI64, m.tI64, m.tI64, tList}, m.tNone))
+            .inward(v["begin"], 0)
+            .inward(v["end"], 1)
+            .inward(v["step"], 2)
+            .inward(v["b"], 3);
+        m.attr(utils::language::atParallel).withBody();
+        v[5] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<ForOp>(m.tI64, v["begin"], v["end"], v[5]).inward(v["j"], 0).withBody();
+        m.opInit<StoreOp>(v["b"], v["j"], v["j"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(ParallelizeLoopsTest, can_not_outline_loop_with_cross_iteration_dependence) {
+    // for i in range(1, 2000): a[i] = a[i - 1]
+    auto makeModule = [](DeclarativeModule &m, ValueStorage &v) {
+        auto tList = m.tPtr(m.tI64, PointerType::dynamic);
+        m.opInit<FunctionOp>("test", m.tFunc({tList}, m.tNone)).inward(v["a"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2000));
+        m.opInit<ForOp>(m.tI64, v[0], v[1], v[0]).inward(v["i"], 0).withBody();
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["i"], v[0]);
+        v[3] = m.opInit<LoadOp>(v["a"], v[2]);
+        m.opInit<StoreOp>(v["a"], v[3], v["i"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    };
+    {
+        auto &&[m, v] = getActual();
+        makeModule(m, v);
+    }
+    {
+        auto &&[m, v] = getExpected();
+        makeModule(m, v);
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
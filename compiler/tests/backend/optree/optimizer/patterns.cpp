@@ -0,0 +1,122 @@
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/patterns.hpp"
+#include "compiler/backend/optree/optimizer/transform.hpp"
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/declarative.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+using namespace optree::optimizer::patterns;
+
+namespace {
+
+constexpr Placeholder<0> x;
+constexpr Placeholder<1> y;
+
+struct ApplyRules : public Transform<> {
+    std::string_view name() const override {
+        return "ApplyRules";
+    }
+
+    void run(const Operation::Ptr &op, OptBuilder &builder) const override {
+        static const RuleSet ruleSet(
+            m_Commuted(m_ArithBinary(ArithBinOpKind::AddI, m_Any(x), m_Const(0))) >> x,
+            m_ArithBinary(ArithBinOpKind::MulI, m_Any(x), m_Const(2)) >> r_ArithBinary(ArithBinOpKind::AddI, x, x),
+            m_LogicBinary(LogicBinOpKind::Equal, m_Any(x), m_Any(x)) >> r_Const(true),
+            m_ArithBinary(ArithBinOpKind::SubI, m_Any(x), m_Any(y)) >>
+                [](const Operation::Ptr &, const Bindings &, OptBuilder &) { return Value::Ptr(); });
+        ruleSet.apply(op, builder);
+    }
+};
+
+} // namespace
+
+class PatternsTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(std::make_shared<ApplyRules>());
+    }
+
+  public:
+    PatternsTest() = default;
+    ~PatternsTest() = default;
+};
+
+TEST_F(PatternsTest, can_match_nested_patterns_and_bind_values) {
+    auto &&[m, v] = getActual();
+    m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tI64}, m.tNone)).inward(v["a"], 0).inward(v["b"], 1).withBody();
+    v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+    v[1] = m.opInit<ArithUnaryOp>(ArithUnaryOpKind::NegI, v["a"]);
+    v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v[1], v[0]);
+    v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["a"], v["b"]);
+    m.opInit<ReturnOp>();
+    m.endBody();
+
+    auto pattern = m_ArithBinary(ArithBinOpKind::AddI, m_ArithUnary(ArithUnaryOpKind::NegI, m_Any(x)), m_Const(y));
+    Bindings bindings;
+    ASSERT_TRUE(pattern.match(v[2], bindings));
+    EXPECT_EQ(bindings[0], Value::Ptr(v["a"]));
+    EXPECT_EQ(bindings[1], Value::Ptr(v[0]));
+    Bindings other;
+    EXPECT_FALSE(pattern.match(v[3], other));
+    EXPECT_TRUE(m_ArithBinary(ArithBinOpKind::AddI, m_Any(), m_Const(3)).match(v[2], other));
+    EXPECT_FALSE(m_ArithBinary(ArithBinOpKind::AddI, m_Any(), m_Const(3.0)).match(v[2], other));
+    EXPECT_FALSE(m_ArithBinary(ArithBinOpKind::AddI, m_Any(x), m_Any(x)).match(v[3], other));
+}
+
+TEST_F(PatternsTest, can_match_commuted_operands) {
+    auto &&[m, v] = getActual();
+    m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["a"], 0).withBody();
+    v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+    v[1] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v[0], v["a"]);
+    m.opInit<ReturnOp>();
+    m.endBody();
+
+    Bindings bindings;
+    EXPECT_FALSE(m_ArithBinary(ArithBinOpKind::AddI, m_Any(x), m_Const(0)).match(v[1], bindings));
+    bindings = {};
+    ASSERT_TRUE(m_Commuted(m_ArithBinary(ArithBinOpKind::AddI, m_Any(x), m_Const(0))).match(v[1], bindings));
+    EXPECT_EQ(bindings[0], Value::Ptr(v["a"]));
+}
+
+TEST_F(PatternsTest, can_apply_rules_of_root_operations) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tI64}, m.tNone)).inward(v["a"], 0).inward(v["b"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v[0], v["a"]);
+        v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v[2], v[1]);
+        m.opInit<PrintOp>(v[3]);
+        v[4] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["b"], v["b"]);
+        m.opInit<PrintOp>(v[4]);
+        v[5] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["a"], v["b"]);
+        m.opInit<PrintOp>(v[5]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tI64}, m.tNone)).inward(v["a"], 0).inward(v["b"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[6] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["a"], v["a"]);
+        m.opInit<PrintOp>(v[6]);
+        v[7] = m.opInit<ConstantOp>(m.tBool, true);
+        m.opInit<PrintOp>(v[7]);
+        v[5] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["a"], v["b"]);
+        m.opInit<PrintOp>(v[5]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/transform_factories.hpp"
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/types.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+class PlaceAllocationsTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(createPlaceAllocations(64U));
+    }
+
+  public:
+    PlaceAllocationsTest() = default;
+    ~PlaceAllocationsTest() = default;
+};
+
+TEST_F(PlaceAllocationsTest, can_run_on_empty_optree) {
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PlaceAllocationsTest, can_hoist_allocations_to_function_begin) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<ForOp>(m.tI64, v[1], v["n"], v[2]).inward(v["i"], 0).withBody();
+        v[3] = m.opInit<AllocateOp>(m.tPtr(m.tF64));
+        m.opInit<StoreOp>(v[0], v["i"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        v[3] = m.opInit<AllocateOp>(m.tPtr(m.tF64));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<ForOp>(m.tI64, v[1], v["n"], v[2]).inward(v["i"], 0).withBody();
+        m.opInit<StoreOp>(v[0], v["i"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PlaceAllocationsTest, can_move_large_allocation_to_heap) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tBool, true);
+        m.op<IfOp>(v[0]).withBody();
+        m.op<ThenOp>().withBody();
+        v[1] = m.opInit<AllocateOp>(Type::make<PointerType>(m.tI64, 16U));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        m.opInit<StoreOp>(v[1], v[2], v[2]);
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tBool, true);
+        m.op<IfOp>(v[0]).withBody();
+        m.op<ThenOp>().withBody();
+        v[1] = m.opInit<HeapAllocateOp>(Type::make<PointerType>(m.tI64, 16U));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        m.opInit<StoreOp>(v[1], v[2], v[2]);
+        m.opInit<DeallocateOp>(v[1]);
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PlaceAllocationsTest, can_deallocate_before_returns) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tBool}, m.tI64)).inward(v["n"], 0).inward(v["c"], 1).withBody();
+        v[0] = m.opInit<AllocateOp>(Type::make<PointerType>(m.tI64, PointerType::dynamic), v["n"]);
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        m.op<IfOp>(v["c"]).withBody();
+        m.op<ThenOp>().withBody();
+        v[2] = m.opInit<LoadOp>(v[0], v[1]);
+        m.opInit<ReturnOp>(v[2]);
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>(v[1]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tBool}, m.tI64)).inward(v["n"], 0).inward(v["c"], 1).withBody();
+        v[0] = m.opInit<HeapAllocateOp>(Type::make<PointerType>(m.tI64, PointerType::dynamic), v["n"]);
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        m.op<IfOp>(v["c"]).withBody();
+        m.op<ThenOp>().withBody();
+        v[2] = m.opInit<LoadOp>(v[0], v[1]);
+        m.opInit<DeallocateOp>(v[0]);
+        m.opInit<ReturnOp>(v[2]);
+        m.endBody();
+        m.endBody();
+        m.opInit<DeallocateOp>(v[0]);
+        m.opInit<ReturnOp>(v[1]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PlaceAllocationsTest, keeps_small_list_on_stack) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<AllocateOp>(Type::make<PointerType>(m.tI64, 8U));
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PlaceAllocationsTest, can_deallocate_before_yields) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tBool}, m.tI64)).inward(v["n"], 0).inward(v["c"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.op<IfOp>(v["c"]).result(m.tI64);
+        m.withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[0]});
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[2] = m.opInit<AllocateOp>(Type::make<PointerType>(m.tI64, PointerType::dynamic), v["n"]);
+        m.opInit<StoreOp>(v[2], v["n"], v[0]);
+        v[3] = m.opInit<LoadOp>(v[2], v[0]);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[3]});
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>(v[1]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tBool}, m.tI64)).inward(v["n"], 0).inward(v["c"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.op<IfOp>(v["c"]).result(m.tI64);
+        m.withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[0]});
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[2] = m.opInit<HeapAllocateOp>(Type::make<PointerType>(m.tI64, PointerType::dynamic), v["n"]);
+        m.opInit<StoreOp>(v[2], v["n"], v[0]);
+        v[3] = m.opInit<LoadOp>(v[2], v[0]);
+        m.opInit<DeallocateOp>(v[2]);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[3]});
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>(v[1]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PlaceAllocationsTest, places_list_of_constant_size_by_threshold) {
+    // for i in range(n): a = [0] * 4; b = [0] * 100
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(4));
+        v[3] = m.opInit<AllocateOp>(Type::make<PointerType>(m.tI64, PointerType::dynamic), v[2]);
+        v[4] = m.opInit<ConstantOp>(m.tI64, int64_t(100));
+        v[5] = m.opInit<AllocateOp>(Type::make<PointerType>(m.tI64, PointerType::dynamic), v[4]);
+        m.opInit<StoreOp>(v[3], v["i"], v[0]);
+        m.opInit<StoreOp>(v[5], v["i"], v[0]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["n"], 0).withBody();
+        v[6] = m.opInit<ConstantOp>(m.tI64, int64_t(4));
+        v[3] = m.opInit<AllocateOp>(Type::make<PointerType>(m.tI64, PointerType::dynamic), v[6]);
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(4));
+        v[4] = m.opInit<ConstantOp>(m.tI64, int64_t(100));
+        v[5] = m.opInit<HeapAllocateOp>(Type::make<PointerType>(m.tI64, PointerType::dynamic), v[4]);
+        m.opInit<StoreOp>(v[3], v["i"], v[0]);
+        m.opInit<StoreOp>(v[5], v["i"], v[0]);
+        m.opInit<DeallocateOp>(v[5]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/transform_factories.hpp"
+#include "compiler/optree/adaptors.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+class PromoteAllocationsTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(createPromoteAllocations());
+    }
+
+  public:
+    PromoteAllocationsTest() = default;
+    ~PromoteAllocationsTest() = default;
+};
+
+TEST_F(PromoteAllocationsTest, can_run_on_empty_optree) {
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PromoteAllocationsTest, can_promote_straight_line_variable) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tI64)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        m.opInit<StoreOp>(v[0], v["n"]);
+        v[1] = m.opInit<LoadOp>(v[0]);
+        m.opInit<ReturnOp>(v[1]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tI64)).inward(v["n"], 0).withBody();
+        m.opInit<ReturnOp>(v["n"]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PromoteAllocationsTest, can_merge_values_of_if_branches) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tBool}, m.tI64)).inward(v["c"], 0).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        m.opInit<StoreOp>(v[0], v[1]);
+        m.op<IfOp>(v["c"]).withBody();
+        m.op<ThenOp>().withBody();
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<StoreOp>(v[0], v[2]);
+        m.endBody();
+        m.endBody();
+        v[3] = m.opInit<LoadOp>(v[0]);
+        m.opInit<ReturnOp>(v[3]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tBool}, m.tI64)).inward(v["c"], 0).withBody();
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[3] = m.op<IfOp>(v["c"]).result(m.tI64);
+        m.withBody();
+        m.op<ThenOp>().withBody();
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[2]});
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[1]});
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>(v[3]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PromoteAllocationsTest, can_carry_value_through_for_loop) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tI64)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<StoreOp>(v[0], v[1]);
+        m.opInit<ForOp>(m.tI64, v[1], v["n"], v[2]).inward(v["i"], 0).withBody();
+        v[3] = m.opInit<LoadOp>(v[0]);
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v[3], v["i"]);
+        m.opInit<StoreOp>(v[0], v[4]);
+        m.endBody();
+        v[5] = m.opInit<LoadOp>(v[0]);
+        m.opInit<ReturnOp>(v[5]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tI64)).inward(v["n"], 0).withBody();
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[5] = m.opInit<ForOp>(m.tI64, v[1], v["n"], v[2])
+                   .operand(v[1])
+                   .inward(v["i"], 0)
+                   .inward(v["sum"], m.tI64)
+                   .result(m.tI64);
+        m.withBody();
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["sum"], v["i"]);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[4]});
+        m.endBody();
+        m.opInit<ReturnOp>(v[5]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PromoteAllocationsTest, can_carry_value_through_while_loop) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tI64)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        m.opInit<StoreOp>(v[0], v["n"]);
+        m.op<WhileOp>().withBody();
+        m.op<ConditionOp>().withBody();
+        v[1] = m.opInit<LoadOp>(v[0]);
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[3] = m.opInit<LogicBinaryOp>(LogicBinOpKind::GreaterI, v[1], v[2]);
+        m.endBody();
+        v[4] = m.opInit<LoadOp>(v[0]);
+        v[5] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[6] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v[4], v[5]);
+        m.opInit<StoreOp>(v[0], v[6]);
+        m.endBody();
+        v[7] = m.opInit<LoadOp>(v[0]);
+        m.opInit<ReturnOp>(v[7]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tI64)).inward(v["n"], 0).withBody();
+        v[7] = m.op<WhileOp>(v["n"]).inward(v["x"], m.tI64).result(m.tI64);
+        m.withBody();
+        m.op<ConditionOp>().withBody();
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[3] = m.opInit<LogicBinaryOp>(LogicBinOpKind::GreaterI, v["x"], v[2]);
+        m.endBody();
+        v[5] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[6] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["x"], v[5]);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[6]});
+        m.endBody();
+        m.opInit<ReturnOp>(v[7]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PromoteAllocationsTest, keeps_escaping_allocation) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tI64)).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        m.opInit<InputOp>(v[0]);
+        v[1] = m.opInit<LoadOp>(v[0]);
+        m.opInit<ReturnOp>(v[1]);
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/transform_factories.hpp"
+#include "compiler/optree/adaptors.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+class PropagateConditionalConstantsTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(createPropagateConditionalConstants());
+    }
+
+  public:
+    PropagateConditionalConstantsTest() = default;
+    ~PropagateConditionalConstantsTest() = default;
+};
+
+TEST_F(PropagateConditionalConstantsTest, can_run_on_empty_optree) {
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PropagateConditionalConstantsTest, can_propagate_through_memory_and_branches) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tI64)).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<StoreOp>(v[0], v[1]);
+        v[2] = m.opInit<LoadOp>(v[0]);
+        v[3] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v[2], v[1]);
+        m.op<IfOp>(v[3]).withBody();
+        m.op<ThenOp>().withBody();
+        v[4] = m.opInit<ConstantOp>(m.tI64, int64_t(5));
+        m.opInit<PrintOp>(v[4]);
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[5] = m.opInit<ConstantOp>(m.tI64, int64_t(7));
+        m.opInit<StoreOp>(v[0], v[5]);
+        m.endBody();
+        m.endBody();
+        v[6] = m.opInit<LoadOp>(v[0]);
+        m.opInit<ReturnOp>(v[6]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tI64)).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<StoreOp>(v[0], v[1]);
+        v[4] = m.opInit<ConstantOp>(m.tI64, int64_t(5));
+        m.opInit<PrintOp>(v[4]);
+        v[7] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<ReturnOp>(v[7]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PropagateConditionalConstantsTest, can_propagate_loop_carried_values) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tI64)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+        v[3] = m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1])
+                   .operand(v[2])
+                   .inward(v["i"], 0)
+                   .inward(v["x"], m.tI64)
+                   .result(m.tI64);
+        m.withBody();
+        v[4] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["x"], v[2]);
+        v[5] = m.op<IfOp>(v[4]).result(m.tI64);
+        m.withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v["x"]});
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[6] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["x"], v[1]);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[6]});
+        m.endBody();
+        m.endBody();
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[5]});
+        m.endBody();
+        m.opInit<ReturnOp>(v[3]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tI64)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+        v[7] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+        v[3] = m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1])
+                   .operand(v[2])
+                   .inward(v["i"], 0)
+                   .inward(v["x"], m.tI64)
+                   .result(m.tI64);
+        m.withBody();
+        v[8] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[8]});
+        m.endBody();
+        m.opInit<ReturnOp>(v[7]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PropagateConditionalConstantsTest, can_propagate_constant_arguments) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("twice", m.tFunc({m.tI64}, m.tI64)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[1] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["x"], v[0]);
+        m.opInit<ReturnOp>(v[1]);
+        m.endBody();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(5));
+        v[3] = m.opInit<FunctionCallOp>("twice", m.tI64, std::vector<Value::Ptr>{v[2]});
+        m.opInit<PrintOp>(v[3]);
+        v[4] = m.opInit<FunctionCallOp>("twice", m.tI64, std::vector<Value::Ptr>{v[2]});
+        m.opInit<PrintOp>(v[4]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("twice", m.tFunc({m.tI64}, m.tI64)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[5] = m.opInit<ConstantOp>(m.tI64, int64_t(10));
+        m.opInit<ReturnOp>(v[5]);
+        m.endBody();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(5));
+        v[3] = m.opInit<FunctionCallOp>("twice", m.tI64, std::vector<Value::Ptr>{v[2]});
+        m.opInit<PrintOp>(v[3]);
+        v[4] = m.opInit<FunctionCallOp>("twice", m.tI64, std::vector<Value::Ptr>{v[2]});
+        m.opInit<PrintOp>(v[4]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PropagateConditionalConstantsTest, can_erase_loop_with_false_condition) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tI64)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(5));
+        v[2] = m.op<WhileOp>(v[1]).inward(v["x"], m.tI64).result(m.tI64);
+        m.withBody();
+        m.op<ConditionOp>().withBody();
+        v[3] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessI, v["x"], v[0]);
+        m.endBody();
+        v[4] = m.opInit<FunctionCallOp>("next", m.tI64, std::vector<Value::Ptr>{v["x"]});
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[4]});
+        m.endBody();
+        m.opInit<ReturnOp>(v[2]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tI64)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(5));
+        v[5] = m.opInit<ConstantOp>(m.tI64, int64_t(5));
+        v[6] = m.opInit<ConstantOp>(m.tI64, int64_t(5));
+        v[3] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessI, v[5], v[0]);
+        m.opInit<ReturnOp>(v[6]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PropagateConditionalConstantsTest, does_not_propagate_values_merged_from_different_paths) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tBool}, m.tI64)).inward(v["cond"], 0).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        m.op<IfOp>(v["cond"]).withBody();
+        m.op<ThenOp>().withBody();
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<StoreOp>(v[0], v[1]);
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        m.opInit<StoreOp>(v[0], v[2]);
+        m.endBody();
+        m.endBody();
+        v[3] = m.opInit<LoadOp>(v[0]);
+        m.opInit<ReturnOp>(v[3]);
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
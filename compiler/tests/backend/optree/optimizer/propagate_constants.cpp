@@ -639,3 +639,26 @@ TEST_F(PropagateConstantsTest, propagate_into_while_if_store_in_else) {
     runOptimizer();
     assertSameOpTree();
 }
+
+TEST_F(PropagateConstantsTest, invalidate_variable_after_input_and_element_store) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+        v["x"] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        v["a"] = m.opInit<AllocateOp>(m.tPtr(m.tI64, 2U));
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<StoreOp>(v["x"], v[0]);
+        m.opInit<StoreOp>(v["a"], v[0]);
+        m.opInit<InputOp>(v["x"]);
+        m.opInit<StoreOp>(v["a"], v[1], v[0]);
+        v[2] = m.opInit<LoadOp>(v["x"]);
+        v[3] = m.opInit<LoadOp>(v["a"]);
+        m.opInit<PrintOp>(std::vector<Value::Ptr>{v[2], v[3]});
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
@@ -0,0 +1,146 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/transform_factories.hpp"
+#include "compiler/optree/adaptors.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+class PropagateInterproceduralConstantsTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(createPropagateInterproceduralConstants());
+    }
+
+  public:
+    PropagateInterproceduralConstantsTest() = default;
+    ~PropagateInterproceduralConstantsTest() = default;
+};
+
+TEST_F(PropagateInterproceduralConstantsTest, can_run_on_empty_optree) {
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PropagateInterproceduralConstantsTest, can_propagate_common_constant_arguments) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("scale", m.tFunc({m.tI64, m.tI64}, m.tI64)).inward(v["x"], 0).inward(v["k"], 1).withBody();
+        v[0] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["x"], v["k"]);
+        m.opInit<ReturnOp>(v[0]);
+        m.endBody();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v[3], 0).withBody();
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+        v[4] = m.opInit<FunctionCallOp>("scale", m.tI64, std::vector<Value::Ptr>{v[3], v[1]});
+        m.opInit<PrintOp>(v[4]);
+        v[5] = m.opInit<FunctionCallOp>("scale", m.tI64, std::vector<Value::Ptr>{v[1], v[2]});
+        m.opInit<PrintOp>(v[5]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("scale", m.tFunc({m.tI64}, m.tI64)).inward(v["x"], 0).withBody();
+        v[6] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+        v[0] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["x"], v[6]);
+        m.opInit<ReturnOp>(v[0]);
+        m.endBody();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v[3], 0).withBody();
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+        v[4] = m.opInit<FunctionCallOp>("scale", m.tI64, std::vector<Value::Ptr>{v[3]});
+        m.opInit<PrintOp>(v[4]);
+        v[5] = m.opInit<FunctionCallOp>("scale", m.tI64, std::vector<Value::Ptr>{v[1]});
+        m.opInit<PrintOp>(v[5]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PropagateInterproceduralConstantsTest, can_specialize_frequent_constant_arguments) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("power", m.tFunc({m.tI64, m.tI64}, m.tI64)).inward(v["b"], 0).inward(v["e"], 1).withBody();
+        v[0] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["b"], v["e"]);
+        m.opInit<ReturnOp>(v[0]);
+        m.endBody();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v[3], 0).withBody();
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(10));
+        v[4] = m.opInit<FunctionCallOp>("power", m.tI64, std::vector<Value::Ptr>{v[1], v[2]});
+        m.opInit<PrintOp>(v[4]);
+        v[5] = m.opInit<FunctionCallOp>("power", m.tI64, std::vector<Value::Ptr>{v[3], v[2]});
+        m.opInit<PrintOp>(v[5]);
+        v[6] = m.opInit<FunctionCallOp>("power", m.tI64, std::vector<Value::Ptr>{v[1], v[3]});
+        m.opInit<PrintOp>(v[6]);
+        v[7] = m.opInit<FunctionCallOp>("power", m.tI64, std::vector<Value::Ptr>{v[1], v[2]});
+        m.opInit<PrintOp>(v[7]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("power", m.tFunc({m.tI64, m.tI64}, m.tI64)).inward(v["b"], 0).inward(v["e"], 1).withBody();
+        v[0] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["b"], v["e"]);
+        m.opInit<ReturnOp>(v[0]);
+        m.endBody();
+        m.opInit<FunctionOp>("power.specialized.1", m.tFunc(m.tI64)).withBody();
+        v[8] = m.opInit<ConstantOp>(m.tI64, int64_t(10));
+        v[9] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[10] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v[9], v[8]);
+        m.opInit<ReturnOp>(v[10]);
+        m.endBody();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v[3], 0).withBody();
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(10));
+        v[4] = m.opInit<FunctionCallOp>("power.specialized.1", m.tI64, std::vector<Value::Ptr>{});
+        m.opInit<PrintOp>(v[4]);
+        v[5] = m.opInit<FunctionCallOp>("power", m.tI64, std::vector<Value::Ptr>{v[3], v[2]});
+        m.opInit<PrintOp>(v[5]);
+        v[6] = m.opInit<FunctionCallOp>("power", m.tI64, std::vector<Value::Ptr>{v[1], v[3]});
+        m.opInit<PrintOp>(v[6]);
+        v[7] = m.opInit<FunctionCallOp>("power.specialized.1", m.tI64, std::vector<Value::Ptr>{});
+        m.opInit<PrintOp>(v[7]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(PropagateInterproceduralConstantsTest, can_erase_unused_parameters_and_results) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("log", m.tFunc({m.tI64, m.tF64}, m.tI64)).inward(v["x"], 0).inward(v["f"], 1).withBody();
+        m.opInit<PrintOp>(v["x"]);
+        m.opInit<ReturnOp>(v["x"]);
+        m.endBody();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tF64}, m.tNone)).inward(v[0], 0).inward(v[1], 1).withBody();
+        v[2] = m.opInit<FunctionCallOp>("log", m.tI64, std::vector<Value::Ptr>{v[0], v[1]});
+        v[3] = m.opInit<FunctionCallOp>("log", m.tI64, std::vector<Value::Ptr>{v[0], v[1]});
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("log", m.tFunc({m.tI64}, m.tNone)).inward(v["x"], 0).withBody();
+        m.opInit<PrintOp>(v["x"]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tF64}, m.tNone)).inward(v[0], 0).inward(v[1], 1).withBody();
+        v[2] = m.opInit<FunctionCallOp>("log", m.tNone, std::vector<Value::Ptr>{v[0]});
+        v[3] = m.opInit<FunctionCallOp>("log", m.tNone, std::vector<Value::Ptr>{v[0]});
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
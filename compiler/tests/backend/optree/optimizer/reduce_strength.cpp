@@ -0,0 +1,222 @@
+#include <cstdint>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/transform_factories.hpp"
+#include "compiler/optree/adaptors.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+class ReduceStrengthTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(createReduceStrength());
+    }
+
+  public:
+    ReduceStrengthTest() = default;
+    ~ReduceStrengthTest() = default;
+};
+
+TEST_F(ReduceStrengthTest, can_run_on_empty_optree) {
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(ReduceStrengthTest, can_apply_algebraic_identities) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tF64}, m.tNone))
+            .inward(v["x"], 0)
+            .inward(v["f"], 1)
+            .withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["x"], v[0]);
+        v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v[1], v[2]);
+        v[4] = m.opInit<ArithUnaryOp>(ArithUnaryOpKind::NegI, v["x"]);
+        v[5] = m.opInit<ArithUnaryOp>(ArithUnaryOpKind::NegI, v[4]);
+        v[6] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v[3], v[5]);
+        m.opInit<PrintOp>(v[6]);
+        v[7] = m.opInit<ConstantOp>(m.tF64, 1.0);
+        v[8] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulF, v["f"], v[7]);
+        m.opInit<PrintOp>(v[8]);
+        v[9] = m.opInit<ConstantOp>(m.tF64, 4.0);
+        v[10] = m.opInit<ArithBinaryOp>(ArithBinOpKind::DivF, v["f"], v[9]);
+        m.opInit<PrintOp>(v[10]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tF64}, m.tNone))
+            .inward(v["x"], 0)
+            .inward(v["f"], 1)
+            .withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[4] = m.opInit<ArithUnaryOp>(ArithUnaryOpKind::NegI, v["x"]);
+        v[11] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        m.opInit<PrintOp>(v[11]);
+        v[7] = m.opInit<ConstantOp>(m.tF64, 1.0);
+        m.opInit<PrintOp>(v["f"]);
+        v[9] = m.opInit<ConstantOp>(m.tF64, 4.0);
+        v[12] = m.opInit<ConstantOp>(m.tF64, 0.25);
+        v[13] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulF, v["f"], v[12]);
+        m.opInit<PrintOp>(v[13]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(ReduceStrengthTest, can_reassociate_constants_and_replace_powers_of_two) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tI64)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["x"], v[0]);
+        v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v[1], v[2]);
+        v[4] = m.opInit<ConstantOp>(m.tI64, int64_t(8));
+        v[5] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v[3], v[4]);
+        m.opInit<ReturnOp>(v[5]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tI64)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["x"], v[0]);
+        v[6] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+        v[7] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["x"], v[6]);
+        v[4] = m.opInit<ConstantOp>(m.tI64, int64_t(8));
+        v[8] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+        v[9] = m.opInit<ArithBinaryOp>(ArithBinOpKind::ShlI, v[7], v[8]);
+        m.opInit<ReturnOp>(v[9]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(ReduceStrengthTest, can_reassociate_overflowing_constants) {
+    // (x * (3 * 2^61 + 1)) * 3, (y - INT_MIN) - 1
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tI64}, m.tNone)).inward(v["x"], 0).inward(v["y"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, (int64_t(3) << 61) + 1);
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["x"], v[0]);
+        v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v[2], v[1]);
+        m.opInit<PrintOp>(v[3]);
+        v[4] = m.opInit<ConstantOp>(m.tI64, std::numeric_limits<int64_t>::min());
+        v[5] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[6] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["y"], v[4]);
+        v[7] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v[6], v[5]);
+        m.opInit<PrintOp>(v[7]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tI64}, m.tNone)).inward(v["x"], 0).inward(v["y"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, (int64_t(3) << 61) + 1);
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["x"], v[0]);
+        v[8] = m.opInit<ConstantOp>(m.tI64, (int64_t(1) << 61) + 3);
+        v[11] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["x"], v[8]);
+        m.opInit<PrintOp>(v[11]);
+        v[4] = m.opInit<ConstantOp>(m.tI64, std::numeric_limits<int64_t>::min());
+        v[5] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[6] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["y"], v[4]);
+        v[9] = m.opInit<ConstantOp>(m.tI64, std::numeric_limits<int64_t>::max());
+        v[10] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["y"], v[9]);
+        m.opInit<PrintOp>(v[10]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(ReduceStrengthTest, can_replace_division_of_non_negative_values) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(4));
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::DivI, v["i"], v[2]);
+        m.opInit<PrintOp>(v[3]);
+        m.endBody();
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::DivI, v["n"], v[2]);
+        m.opInit<PrintOp>(v[4]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(4));
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        v[5] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[6] = m.opInit<ArithBinaryOp>(ArithBinOpKind::ShrI, v["i"], v[5]);
+        m.opInit<PrintOp>(v[6]);
+        m.endBody();
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::DivI, v["n"], v[2]);
+        m.opInit<PrintOp>(v[4]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(ReduceStrengthTest, can_reduce_induction_variable_multiplication) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["i"], v[2]);
+        m.opInit<PrintOp>(v[3]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+        v[4] = m.opInit<ConstantOp>(m.tI64, int64_t(6));
+        v[5] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1])
+            .operand(v[4])
+            .inward(v["i"], 0)
+            .inward(v["iv"], m.tI64)
+            .result(m.tI64);
+        m.withBody();
+        m.opInit<PrintOp>(v["iv"]);
+        v[6] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["iv"], v[5]);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[6]});
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
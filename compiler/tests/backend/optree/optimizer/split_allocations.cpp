@@ -0,0 +1,101 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/transform_factories.hpp"
+#include "compiler/optree/adaptors.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+class SplitAllocationsTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(createSplitAllocations(4U));
+    }
+
+  public:
+    SplitAllocationsTest() = default;
+    ~SplitAllocationsTest() = default;
+};
+
+TEST_F(SplitAllocationsTest, can_run_on_empty_optree) {
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(SplitAllocationsTest, can_split_list_accessed_at_constant_offsets) {
+    // a = [x, 0, 0]; print(a[0] + a[2])
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["x"], 0).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64, 3U));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        m.opInit<StoreOp>(v[0], v["x"]);
+        m.opInit<StoreOp>(v[0], v["x"], v[1]);
+        v[2] = m.opInit<LoadOp>(v[0]);
+        v[3] = m.opInit<LoadOp>(v[0], v[1]);
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v[2], v[3]);
+        m.opInit<PrintOp>(v[4]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["x"], 0).withBody();
+        v[5] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        v[6] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        m.opInit<StoreOp>(v[5], v["x"]);
+        m.opInit<StoreOp>(v[6], v["x"]);
+        v[2] = m.opInit<LoadOp>(v[5]);
+        v[3] = m.opInit<LoadOp>(v[6]);
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v[2], v[3]);
+        m.opInit<PrintOp>(v[4]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(SplitAllocationsTest, can_not_split_list_accessed_at_dynamic_offset) {
+    // a = [0, 0, 0]; print(a[i])
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["i"], 0).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64, 3U));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        m.opInit<StoreOp>(v[0], v[1], v[1]);
+        v[2] = m.opInit<LoadOp>(v[0], v["i"]);
+        m.opInit<PrintOp>(v[2]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(SplitAllocationsTest, can_not_split_escaping_or_large_list) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64, 3U));
+        v[1] = m.opInit<AllocateOp>(m.tPtr(m.tI64, 8U));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        m.opInit<StoreOp>(v[0], v[2], v[2]);
+        m.opInit<StoreOp>(v[1], v[2], v[2]);
+        m.opInit<FunctionCallOp>("touch", m.tNone, std::vector<Value::Ptr>{v[0]});
+        v[3] = m.opInit<LoadOp>(v[1], v[2]);
+        m.opInit<PrintOp>(v[3]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
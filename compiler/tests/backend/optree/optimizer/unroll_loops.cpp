@@ -0,0 +1,172 @@
+#include <cstdint>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/transform_factories.hpp"
+#include "compiler/optree/adaptors.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+class UnrollLoopsTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(createUnrollLoops(2U, 4U));
+    }
+
+  public:
+    UnrollLoopsTest() = default;
+    ~UnrollLoopsTest() = default;
+};
+
+TEST_F(UnrollLoopsTest, can_run_on_empty_optree) {
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(UnrollLoopsTest, can_unroll_loop_fully) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(5));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        m.opInit<ForOp>(m.tI64, v[0], v[1], v[2]).inward(v["i"], 0).withBody();
+        m.opInit<PrintOp>(v["i"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(5));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        for (int64_t i = 0; i < 5; i += 2) {
+            v[3] = m.opInit<ConstantOp>(m.tI64, i);
+            m.opInit<PrintOp>(v[3]);
+        }
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(UnrollLoopsTest, can_unroll_loop_partially_with_carried_values) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tI64)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(5));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[3] = m.opInit<ForOp>(m.tI64, v[0], v[1], v[2])
+                   .operand(v[0])
+                   .inward(v["i"], 0)
+                   .inward(v["sum"], m.tI64)
+                   .result(m.tI64);
+        m.withBody();
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["sum"], v["i"]);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[4]});
+        m.endBody();
+        m.opInit<ReturnOp>(v[3]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tI64)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(5));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[5] = m.opInit<ConstantOp>(m.tI64, int64_t(4));
+        v[6] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+        v[7] = m.opInit<ForOp>(m.tI64, v[0], v[5], v[6])
+                   .operand(v[0])
+                   .inward(v["i"], 0)
+                   .inward(v["sum"], m.tI64)
+                   .result(m.tI64);
+        m.withBody();
+        v[8] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["sum"], v["i"]);
+        v[9] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[10] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["i"], v[9]);
+        v[11] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v[8], v[10]);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[11]});
+        m.endBody();
+        v[12] = m.opInit<ConstantOp>(m.tI64, int64_t(4));
+        v[13] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v[7], v[12]);
+        m.opInit<ReturnOp>(v[13]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(UnrollLoopsTest, does_not_unroll_loop_with_unknown_trip_count) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        m.opInit<PrintOp>(v["i"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(UnrollLoopsTest, can_unroll_loop_fully_with_overflowing_distance) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(-9'000'000'000'000'000'000));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(9'000'000'000'000'000'000));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(5'000'000'000'000'000'000));
+        m.opInit<ForOp>(m.tI64, v[0], v[1], v[2]).inward(v["i"], 0).withBody();
+        m.opInit<PrintOp>(v["i"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(-9'000'000'000'000'000'000));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(9'000'000'000'000'000'000));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(5'000'000'000'000'000'000));
+        for (int64_t i : {-9'000'000'000'000'000'000, -4'000'000'000'000'000'000, 1'000'000'000'000'000'000,
+                          6'000'000'000'000'000'000}) {
+            v[3] = m.opInit<ConstantOp>(m.tI64, i);
+            m.opInit<PrintOp>(v[3]);
+        }
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(UnrollLoopsTest, does_not_unroll_loop_partially_with_overflowing_stop) {
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, std::numeric_limits<int64_t>::max());
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(2'000'000'000'000'000'000));
+        m.opInit<ForOp>(m.tI64, v[0], v[1], v[2]).inward(v["i"], 0).withBody();
+        m.opInit<PrintOp>(v["i"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
@@ -0,0 +1,192 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/transform_factories.hpp"
+#include "compiler/optree/adaptors.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+class UnswitchLoopsTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(createUnswitchLoops(16U));
+    }
+
+  public:
+    UnswitchLoopsTest() = default;
+    ~UnswitchLoopsTest() = default;
+};
+
+TEST_F(UnswitchLoopsTest, can_run_on_empty_optree) {
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(UnswitchLoopsTest, can_unswitch_loop_with_invariant_condition) {
+    // for i in range(n): if c: print(i) else: print(0)
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tBool}, m.tNone)).inward(v["n"], 0).inward(v["c"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        m.op<IfOp>(v["c"]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<PrintOp>(v["i"]);
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        m.opInit<PrintOp>(v[0]);
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tBool}, m.tNone)).inward(v["n"], 0).inward(v["c"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.op<IfOp>(v["c"]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        m.opInit<PrintOp>(v["i"]);
+        m.endBody();
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["j"], 0).withBody();
+        m.opInit<PrintOp>(v[0]);
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(UnswitchLoopsTest, can_unswitch_loop_with_carried_values) {
+    // s = 0; for i in range(n): if c: s += i else: s -= i
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tBool}, m.tI64)).inward(v["n"], 0).inward(v["c"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1])
+                   .operand(v[0])
+                   .inward(v["i"], 0)
+                   .inward(v["s"], m.tI64)
+                   .result(m.tI64);
+        m.withBody();
+        v[3] = m.op<IfOp>(v["c"]).result(m.tI64);
+        m.withBody();
+        m.op<ThenOp>().withBody();
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["s"], v["i"]);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[4]});
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[5] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["s"], v["i"]);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[5]});
+        m.endBody();
+        m.endBody();
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[3]});
+        m.endBody();
+        m.opInit<ReturnOp>(v[2]);
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tBool}, m.tI64)).inward(v["n"], 0).inward(v["c"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.op<IfOp>(v["c"]).result(m.tI64);
+        m.withBody();
+        m.op<ThenOp>().withBody();
+        v[3] = m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1])
+                   .operand(v[0])
+                   .inward(v["i"], 0)
+                   .inward(v["s"], m.tI64)
+                   .result(m.tI64);
+        m.withBody();
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["s"], v["i"]);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[4]});
+        m.endBody();
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[3]});
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[5] = m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1])
+                   .operand(v[0])
+                   .inward(v["j"], 0)
+                   .inward(v["t"], m.tI64)
+                   .result(m.tI64);
+        m.withBody();
+        v[6] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["t"], v["j"]);
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[6]});
+        m.endBody();
+        m.opInit<YieldOp>(std::vector<Value::Ptr>{v[5]});
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>(v[2]);
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(UnswitchLoopsTest, can_not_unswitch_loop_with_variant_condition) {
+    // for i in range(n): if i < 10: print(i)
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(10));
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        v[3] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessI, v["i"], v[2]);
+        m.op<IfOp>(v[3]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<PrintOp>(v["i"]);
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(UnswitchLoopsTest, can_not_unswitch_loop_exceeding_size_budget) {
+    // for i in range(n): if c: print(i) else: print(i + 1 + ... + 1)
+    {
+        auto &&[m, v] = getActual();
+        m.opInit<FunctionOp>("test", m.tFunc({m.tI64, m.tBool}, m.tNone)).inward(v["n"], 0).inward(v["c"], 1).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        m.op<IfOp>(v["c"]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<PrintOp>(v["i"]);
+        m.endBody();
+        m.op<ElseOp>().withBody();
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["i"], v[1]);
+        for (int i = 3; i < 18; i++)
+            v[i] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v[i - 1], v[1]);
+        m.opInit<PrintOp>(v[17]);
+        m.endBody();
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    saveActualAsExpected();
+    runOptimizer();
+    assertSameOpTree();
+}
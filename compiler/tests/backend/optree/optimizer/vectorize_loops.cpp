@@ -0,0 +1,123 @@
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "compiler/backend/optree/optimizer/optimizer.hpp"
+#include "compiler/backend/optree/optimizer/transform_factories.hpp"
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/types.hpp"
+
+#include "common.hpp"
+
+using namespace optree;
+using namespace optree::optimizer;
+
+class VectorizeLoopsTest : public TransformTestBase {
+    virtual void setupOptimizer(Optimizer &opt) const override {
+        opt.add(createVectorizeLoops(256U));
+    }
+
+  public:
+    VectorizeLoopsTest() = default;
+    ~VectorizeLoopsTest() = default;
+};
+
+TEST_F(VectorizeLoopsTest, can_run_on_empty_optree) {
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(VectorizeLoopsTest, can_vectorize_elementwise_loop) {
+    // for i in range(n): a[i] = b[i] + 3
+    {
+        auto &&[m, v] = getActual();
+        auto tList = m.tPtr(m.tI64, PointerType::dynamic);
+        m.opInit<FunctionOp>("test", m.tFunc({tList, tList, m.tI64}, m.tNone))
+            .inward(v["a"], 0)
+            .inward(v["b"], 1)
+            .inward(v["n"], 2)
+            .withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+        m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1]).inward(v["i"], 0).withBody();
+        v[3] = m.opInit<LoadOp>(v["b"], v["i"]);
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v[3], v[2]);
+        m.opInit<StoreOp>(v["a"], v[4], v["i"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        auto tList = m.tPtr(m.tI64, PointerType::dynamic);
+        auto tVec = Type::make<VectorType>(m.tI64, 4U);
+        m.opInit<FunctionOp>("test", m.tFunc({tList, tList, m.tI64}, m.tNone))
+            .inward(v["a"], 0)
+            .inward(v["b"], 1)
+            .inward(v["n"], 2)
+            .withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(3));
+        v[5] = m.opInit<ConstantOp>(m.tI64, int64_t(4));
+        v[6] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["n"], v[0]);
+        v[7] = m.opInit<ArithBinaryOp>(ArithBinOpKind::DivI, v[6], v[5]);
+        v[8] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v[7], v[5]);
+        v[9] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v[0], v[8]);
+        v[10] = m.opInit<ConstantOp>(m.tI64, int64_t(4));
+        m.opInit<ForOp>(m.tI64, v[0], v[9], v[10]).inward(v["j"], 0).withBody();
+        v[11] = m.opInit<LoadOp>(tVec, v["b"], v["j"]);
+        v[12] = m.opInit<ConstantOp>(tVec, int64_t(3));
+        v[13] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, tVec, v[11], v[12]);
+        m.opInit<StoreOp>(v["a"], v[13], v["j"]);
+        m.endBody();
+        m.opInit<ForOp>(m.tI64, v[9], v["n"], v[1]).inward(v["i"], 0).withBody();
+        v[3] = m.opInit<LoadOp>(v["b"], v["i"]);
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v[3], v[2]);
+        m.opInit<StoreOp>(v["a"], v[4], v["i"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
+
+TEST_F(VectorizeLoopsTest, can_not_vectorize_loop_with_cross_iteration_dependence) {
+    // for i in range(1, 100): a[i] = a[i - 1] + a[i]
+    {
+        auto &&[m, v] = getActual();
+        auto tList = m.tPtr(m.tI64, PointerType::dynamic);
+        m.opInit<FunctionOp>("test", m.tFunc({tList}, m.tNone)).inward(v["a"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(100));
+        m.opInit<ForOp>(m.tI64, v[0], v[1], v[0]).inward(v["i"], 0).withBody();
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["i"], v[0]);
+        v[3] = m.opInit<LoadOp>(v["a"], v[2]);
+        v[4] = m.opInit<LoadOp>(v["a"], v["i"]);
+        v[5] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v[3], v[4]);
+        m.opInit<StoreOp>(v["a"], v[5], v["i"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    {
+        auto &&[m, v] = getExpected();
+        auto tList = m.tPtr(m.tI64, PointerType::dynamic);
+        m.opInit<FunctionOp>("test", m.tFunc({tList}, m.tNone)).inward(v["a"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(100));
+        m.opInit<ForOp>(m.tI64, v[0], v[1], v[0]).inward(v["i"], 0).withBody();
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["i"], v[0]);
+        v[3] = m.opInit<LoadOp>(v["a"], v[2]);
+        v[4] = m.opInit<LoadOp>(v["a"], v["i"]);
+        v[5] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v[3], v[4]);
+        m.opInit<StoreOp>(v["a"], v[5], v["i"]);
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+    runOptimizer();
+    assertSameOpTree();
+}
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <vector>
+
 #include "compiler/backend/optree/semantizer/semantizer.hpp"
 #include "compiler/optree/adaptors.hpp"
 #include "compiler/optree/declarative.hpp"
@@ -97,6 +100,85 @@ TEST_F(SemantizerTest, succeeds_on_valid_function_with_if_elif_else) {
     assertNoErrors(m.rootOp());
 }
 
+TEST_F(SemantizerTest, succeeds_on_valid_function_with_switch) {
+    m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tI64)).inward(v["x"], 0).withBody();
+    v[0] = m.op<SwitchOp>(v["x"]).result(m.tI64);
+    m.withBody();
+    m.opInit<CaseOp>(int64_t(1)).withBody();
+    v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+    m.opInit<YieldOp>(std::vector<Value::Ptr>{v[1]});
+    m.endBody();
+    m.opInit<CaseOp>(int64_t(3)).withBody();
+    v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(4));
+    m.opInit<YieldOp>(std::vector<Value::Ptr>{v[2]});
+    m.endBody();
+    m.op<DefaultOp>().withBody();
+    m.opInit<YieldOp>(std::vector<Value::Ptr>{v["x"]});
+    m.endBody();
+    m.endBody();
+    m.opInit<ReturnOp>(v[0]);
+    m.endBody();
+
+    assertNoErrors(m.rootOp());
+}
+
+TEST_F(SemantizerTest, fails_on_switch_with_duplicate_cases) {
+    m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["x"], 0).withBody();
+    m.op<SwitchOp>(v["x"]).withBody();
+    m.opInit<CaseOp>(int64_t(1)).withBody();
+    m.opInit<PrintOp>(v["x"]);
+    m.endBody();
+    m.opInit<CaseOp>(int64_t(1)).withBody();
+    m.opInit<PrintOp>(v["x"]);
+    m.endBody();
+    m.endBody();
+    m.opInit<ReturnOp>();
+    m.endBody();
+
+    assertAnyErrors(m.rootOp());
+}
+
+TEST_F(SemantizerTest, fails_on_switch_with_results_without_default) {
+    m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tI64)).inward(v["x"], 0).withBody();
+    v[0] = m.op<SwitchOp>(v["x"]).result(m.tI64);
+    m.withBody();
+    m.opInit<CaseOp>(int64_t(1)).withBody();
+    m.opInit<YieldOp>(std::vector<Value::Ptr>{v["x"]});
+    m.endBody();
+    m.endBody();
+    m.opInit<ReturnOp>(v[0]);
+    m.endBody();
+
+    assertAnyErrors(m.rootOp());
+}
+
+TEST_F(SemantizerTest, succeeds_on_valid_function_with_profile_counts) {
+    m.opInit<FunctionOp>("test", m.tFunc({m.tBool}, m.tNone)).inward(v["c"], 0);
+    m.attr(int64_t(10)).withBody();
+    m.op<IfOp>(v["c"]).attr(int64_t(0)).attr(int64_t(10)).withBody();
+    m.op<ThenOp>().withBody();
+    m.opInit<PrintOp>(v["c"]);
+    m.endBody();
+    m.endBody();
+    m.opInit<ReturnOp>();
+    m.endBody();
+
+    assertNoErrors(m.rootOp());
+}
+
+TEST_F(SemantizerTest, fails_on_if_with_partial_profile_counts) {
+    m.opInit<FunctionOp>("test", m.tFunc({m.tBool}, m.tNone)).inward(v["c"], 0).withBody();
+    m.op<IfOp>(v["c"]).attr(int64_t(10)).withBody();
+    m.op<ThenOp>().withBody();
+    m.opInit<PrintOp>(v["c"]);
+    m.endBody();
+    m.endBody();
+    m.opInit<ReturnOp>();
+    m.endBody();
+
+    assertAnyErrors(m.rootOp());
+}
+
 TEST_F(SemantizerTest, succeeds_on_valid_functions_with_function_calls) {
     m.opInit<FunctionOp>("int_to_float", m.tFunc({m.tI64}, m.tF64)).withBody();
     v[0] = m.opInit<ConstantOp>(m.tF64, 1.2);
@@ -0,0 +1,9 @@
+def divz(x: int) -> int:
+    return 10 / x
+
+def main() -> None:
+    n: int = input()
+    if n > 100:
+        print(divz(0), "\n")
+    print(n, "\n")
+    return
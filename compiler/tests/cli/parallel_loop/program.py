@@ -0,0 +1,24 @@
+def collatz(x: int) -> int:
+    steps: int = 0
+    y: int = x
+    while y != 1:
+        if y - y / 2 * 2 == 0:
+            y = y / 2
+        else:
+            y = 3 * y + 1
+        steps = steps + 1
+    return steps
+
+def main() -> None:
+    n: int = 20000
+    a: list[int] = [0] * n
+    for i in range(n):
+        a[i] = collatz(i + 1)
+    total: int = 0
+    longest: int = 0
+    for i in range(n):
+        total = total + a[i]
+        if a[i] > a[longest]:
+            longest = i
+    print(total, " ", longest + 1, " ", a[longest])
+    return
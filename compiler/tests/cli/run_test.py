@@ -14,13 +14,54 @@ def parse_args():
     parser.add_argument("--input", default="", help="test input")
     parser.add_argument("--output", required=True, help="test output")
     parser.add_argument("--run", action="store_true", help="run output file after the compilation")
+    parser.add_argument("--interpret", action="store_true", help="run the program with the compiler interpreter")
+    parser.add_argument("--profile", action="store_true", help="rebuild the program with the profile of the first run")
     parser.add_argument("compiler_args", nargs="*", help="additional compiler arguments")
     return parser.parse_args()
 
 
+def check_output(actual_output: str, output_file: str) -> int:
+    expected_output = Path(output_file).read_text().strip()
+    print("---", "Actual output:", actual_output, "---", "Expected output:", expected_output, "---", sep="\n")
+    if actual_output == expected_output:
+        print("Verdict: PASS")
+        return 0
+    print("Verdict: FAIL")
+    return 1
+
+
+def run_executable(executable: str, input_file: str) -> str:
+    print("Run compiled executable:", executable)
+    input_text = Path(input_file).read_text() if input_file else None
+    cp = subprocess.run([executable], input=input_text, capture_output=True, text=True, timeout=10)
+    return cp.stdout.strip()
+
+
+def run_with_profile(args, temp_dir: str) -> int:
+    compiler_output = os.path.join(temp_dir, "output")
+    profile = os.path.join(temp_dir, "profile")
+    base_cmd = [args.compiler, args.program, "--output", compiler_output, "--compile"] + args.compiler_args
+    for cmd in (base_cmd + ["--profile-generate", profile], base_cmd + ["--profile-use", profile]):
+        print("Run compiler command:", shlex.join(cmd))
+        subprocess.check_call(cmd, timeout=10)
+        if check_output(run_executable(compiler_output, args.input), args.output):
+            return 1
+    return 0
+
+
 def main() -> int:
     args = parse_args()
+    if args.interpret:
+        cmd = [args.compiler, args.program, "--interpret"]
+        if args.compiler_args:
+            cmd.extend(args.compiler_args)
+        print("Run interpreter command:", shlex.join(cmd))
+        input_text = Path(args.input).read_text() if args.input else None
+        cp = subprocess.run(cmd, input=input_text, capture_output=True, text=True, timeout=10, check=True)
+        return check_output(cp.stdout.strip(), args.output)
     with tempfile.TemporaryDirectory() as temp_dir:
+        if args.profile:
+            return run_with_profile(args, temp_dir)
         compiler_output = os.path.join(temp_dir, "output")
         cmd = [args.compiler, args.program, "--output", compiler_output]
         if args.run:
@@ -31,21 +72,10 @@ def main() -> int:
         subprocess.check_call(cmd, timeout=10)
         actual_output = ""
         if args.run:
-            print("Run compiled executable:", compiler_output)
-            input_text = Path(args.input).read_text() if args.input else None
-            cp = subprocess.run([compiler_output], input=input_text, capture_output=True, text=True, timeout=10)
-            actual_output = cp.stdout.strip()
+            actual_output = run_executable(compiler_output, args.input)
         else:
             actual_output = Path(compiler_output).read_text()
-        actual_output = actual_output.strip()
-        expected_output = Path(args.output).read_text().strip()
-        print("---", "Actual output:", actual_output, "---", "Expected output:", expected_output, "---", sep="\n")
-        if actual_output == expected_output:
-            print("Verdict: PASS")
-        else:
-            print("Verdict: FAIL")
-            return 1
-    return 0
+        return check_output(actual_output.strip(), args.output)
 
 
 if __name__ == "__main__":
@@ -0,0 +1,26 @@
+def check(x: int) -> bool:
+    print(x, " ")
+    return x > 2
+
+def main() -> None:
+    n: int = input()
+    a: list[int] = [0] * n
+    for i in range(n):
+        a[i] = n - i
+    i: int = 0
+    while i < n and a[i] > 2:
+        i = i + 1
+    print(i, "\n")
+    if n > 3 and check(n):
+        print("yes\n")
+    if n > 3 or check(n + 1):
+        print("or\n")
+    b: bool = n < 0 and check(a[0])
+    c: bool = n > 0 or a[n] > 0
+    print(b, " ", c, "\n")
+    z: int = n - 5
+    if z != 0 and 100 / z > 3:
+        print("div\n")
+    if n != 0 and 100 / n > 3:
+        print(100 / n, "\n")
+    return
@@ -0,0 +1,28 @@
+def name(x: int) -> int:
+    r: int = 0
+    if x == 0:
+        r = 10
+    elif x == 1:
+        r = 20
+    elif 2 == x:
+        r = 35
+    elif x == 5:
+        r = 7
+    else:
+        r = x * 2
+    return r
+
+def main() -> None:
+    n: int = input()
+    s: int = 0
+    for i in range(n):
+        v: int = name(i)
+        s = s + v
+        if i == 0:
+            print("zero ")
+        elif i == 1:
+            print("one ")
+        elif i == 3:
+            print("three ")
+    print(s, "\n")
+    return
@@ -0,0 +1,14 @@
+def f(n: int, acc: int) -> int:
+    t: list[int] = [0] * 3
+    t[1] = n
+    if n == 0:
+        return acc
+    else:
+        return f(n - 1, acc + t[1])
+
+def main() -> None:
+    n: int = input()
+    a: int = f(n, 0)
+    b: int = f(n, 1)
+    print(a, " ", b, "\n")
+    return
@@ -1,6 +1,15 @@
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include "compiler/codegen/optree_to_llvmir/llvmir_generator.hpp"
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/declarative.hpp"
+#include "compiler/optree/profile.hpp"
+#include "compiler/optree/types.hpp"
+#include "compiler/utils/language.hpp"
 
 using namespace optree;
 using namespace optree::llvmir_generator;
@@ -10,3 +19,201 @@ TEST(LLVMIRGenerator, can_be_constructed) {
     auto output = generator.dump();
     ASSERT_EQ("; ModuleID = 'can_be_constructed'\nsource_filename = \"can_be_constructed\"\n", output);
 }
+
+class LLVMIRGeneratorParallelTest : public ::testing::Test {
+  protected:
+    DeclarativeModule m;
+
+    void SetUp() override {
+        auto &v = m.values();
+        m.opInit<FunctionOp>("main", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tStr, std::string("hello"));
+        m.opInit<PrintOp>(v[0]);
+        m.opInit<FunctionCallOp>("foo", m.tNone);
+        m.opInit<ReturnOp>();
+        m.endBody();
+        m.opInit<FunctionOp>("foo", m.tFunc(m.tNone)).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tStr, std::string("hello"));
+        m.opInit<PrintOp>(v[0]);
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+};
+
+TEST_F(LLVMIRGeneratorParallelTest, can_split_functions_between_modules) {
+    auto generators = LLVMIRGenerator::processInParallel(m.makeProgram(), "module", 2U);
+    ASSERT_EQ(2U, generators.size());
+    auto first = generators[0]->dump();
+    auto second = generators[1]->dump();
+    bool mainFirst = first.find("define void @main()") != std::string::npos;
+    const auto &mainModule = mainFirst ? first : second;
+    const auto &fooModule = mainFirst ? second : first;
+    ASSERT_NE(std::string::npos, mainModule.find("define void @main()"));
+    ASSERT_NE(std::string::npos, mainModule.find("declare void @foo()"));
+    ASSERT_EQ(std::string::npos, mainModule.find("define void @foo()"));
+    ASSERT_NE(std::string::npos, fooModule.find("define void @foo()"));
+    ASSERT_EQ(std::string::npos, fooModule.find("@main"));
+}
+
+TEST_F(LLVMIRGeneratorParallelTest, shares_global_strings_between_modules) {
+    auto generators = LLVMIRGenerator::processInParallel(m.makeProgram(), "module", 2U);
+    ASSERT_EQ(2U, generators.size());
+    for (const auto &generator : generators) {
+        auto output = generator->dump();
+        std::string global = "linkonce_odr unnamed_addr constant [6 x i8] c\"hello\\00\"";
+        auto pos = output.find(global);
+        ASSERT_NE(std::string::npos, pos) << output;
+        ASSERT_EQ(std::string::npos, output.find("c\"hello\\00\"", pos + global.size())) << output;
+    }
+}
+
+TEST_F(LLVMIRGeneratorParallelTest, skips_empty_shards) {
+    auto generators = LLVMIRGenerator::processInParallel(m.makeProgram(), "module", 8U);
+    ASSERT_EQ(2U, generators.size());
+}
+
+TEST(LLVMIRGenerator, marks_returned_calls_as_tail_calls) {
+    DeclarativeModule m;
+    auto &v = m.values();
+    m.opInit<FunctionOp>("id", m.tFunc({m.tI64}, m.tI64)).inward(v["x"], 0).withBody();
+    m.opInit<ReturnOp>(v["x"]);
+    m.endBody();
+    m.opInit<FunctionOp>("forward", m.tFunc({m.tI64}, m.tI64)).inward(v["y"], 0).withBody();
+    v[0] = m.opInit<FunctionCallOp>("id", m.tI64, std::vector<Value::Ptr>{v["y"]});
+    m.opInit<ReturnOp>(v[0]);
+    m.endBody();
+    m.opInit<FunctionOp>("main", m.tFunc(m.tNone)).withBody();
+    v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+    v[2] = m.opInit<FunctionCallOp>("forward", m.tI64, std::vector<Value::Ptr>{v[1]});
+    m.opInit<PrintOp>(v[2]);
+    m.opInit<ReturnOp>();
+    m.endBody();
+
+    LLVMIRGenerator generator("marks_returned_calls_as_tail_calls");
+    generator.process(m.makeProgram());
+    auto output = generator.dump();
+    ASSERT_NE(std::string::npos, output.find("musttail call i64 @id(")) << output;
+    ASSERT_EQ(std::string::npos, output.find("tail call i64 @forward(")) << output;
+}
+
+TEST(LLVMIRGenerator, generates_vector_operations) {
+    DeclarativeModule m;
+    auto &v = m.values();
+    auto tList = m.tPtr(m.tF64, PointerType::dynamic);
+    auto tVec = Type::make<VectorType>(m.tF64, 4U);
+    m.opInit<FunctionOp>("scale", m.tFunc({tList, m.tI64}, m.tNone)).inward(v["a"], 0).inward(v["i"], 1).withBody();
+    v[0] = m.opInit<LoadOp>(tVec, v["a"], v["i"]);
+    v[1] = m.opInit<ConstantOp>(tVec, 2.0);
+    v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulF, tVec, v[0], v[1]);
+    m.opInit<StoreOp>(v["a"], v[2], v["i"]);
+    m.opInit<ReturnOp>();
+    m.endBody();
+
+    LLVMIRGenerator generator("generates_vector_operations");
+    generator.process(m.makeProgram());
+    auto output = generator.dump();
+    ASSERT_NE(std::string::npos, output.find("load <4 x double>, ptr")) << output;
+    ASSERT_NE(std::string::npos, output.find("fmul <4 x double>")) << output;
+    ASSERT_NE(std::string::npos, output.find("store <4 x double>")) << output;
+}
+
+TEST(LLVMIRGenerator, generates_parallel_loop_calls) {
+    DeclarativeModule m;
+    auto &v = m.values();
+    auto tList = m.tPtr(m.tI64, PointerType::dynamic);
+    m.opInit<FunctionOp>("fill", m.tFunc({m.tI64, m.tI64, m.tI64, tList}, m.tNone))
+        .inward(v["begin"], 0)
+        .inward(v["end"], 1)
+        .inward(v["step"], 2)
+        .inward(v["a"], 3);
+    m.attr(utils::language::atParallel).withBody();
+    m.opInit<ForOp>(m.tI64, v["begin"], v["end"], v["step"]).inward(v["i"], 0).withBody();
+    m.opInit<StoreOp>(v["a"], v["i"], v["i"]);
+    m.endBody();
+    m.opInit<ReturnOp>();
+    m.endBody();
+    m.opInit<FunctionOp>("main", m.tFunc({tList, m.tI64}, m.tNone)).inward(v["b"], 0).inward(v["n"], 1).withBody();
+    v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+    v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+    m.opInit<FunctionCallOp>("fill", m.tNone, std::vector<Value::Ptr>{v[0], v["n"], v[1], v["b"]});
+    m.opInit<ReturnOp>();
+    m.endBody();
+
+    LLVMIRGenerator generator("generates_parallel_loop_calls");
+    generator.process(m.makeProgram());
+    auto output = generator.dump();
+    ASSERT_NE(std::string::npos, output.find("define internal void @fill.task(")) << output;
+    ASSERT_NE(std::string::npos, output.find("call void @fill(")) << output;
+    ASSERT_NE(std::string::npos, output.find("call void @__compiler_parallel_for(i64 0, i64 %1, i64 1")) << output;
+}
+
+TEST(LLVMIRGenerator, generates_switch_instructions) {
+    DeclarativeModule m;
+    auto &v = m.values();
+    m.opInit<FunctionOp>("select", m.tFunc({m.tI64}, m.tI64)).inward(v["x"], 0).withBody();
+    v[0] = m.op<SwitchOp>(v["x"]).result(m.tI64);
+    m.withBody();
+    m.opInit<CaseOp>(int64_t(-1)).withBody();
+    v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(10));
+    m.opInit<YieldOp>(std::vector<Value::Ptr>{v[1]});
+    m.endBody();
+    m.opInit<CaseOp>(int64_t(7)).withBody();
+    v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(20));
+    m.opInit<YieldOp>(std::vector<Value::Ptr>{v[2]});
+    m.endBody();
+    m.op<DefaultOp>().withBody();
+    m.opInit<YieldOp>(std::vector<Value::Ptr>{v["x"]});
+    m.endBody();
+    m.endBody();
+    m.opInit<ReturnOp>(v[0]);
+    m.endBody();
+
+    LLVMIRGenerator generator("generates_switch_instructions");
+    generator.process(m.makeProgram());
+    auto output = generator.dump();
+    ASSERT_NE(std::string::npos, output.find("switch i64 %0, label %bb3 [")) << output;
+    ASSERT_NE(std::string::npos, output.find("i64 -1, label %bb1")) << output;
+    ASSERT_NE(std::string::npos, output.find("i64 7, label %bb2")) << output;
+    ASSERT_NE(std::string::npos, output.find("phi i64 [ 10, %bb1 ], [ 20, %bb2 ], [ %0, %bb3 ]")) << output;
+}
+
+class LLVMIRGeneratorProfileTest : public ::testing::Test {
+  protected:
+    DeclarativeModule m;
+
+    void SetUp() override {
+        auto &v = m.values();
+        m.opInit<FunctionOp>("main", m.tFunc({m.tBool}, m.tNone)).inward(v["c"], 0).withBody();
+        m.op<IfOp>(v["c"]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<PrintOp>(v["c"]);
+        m.endBody();
+        m.endBody();
+        m.opInit<ReturnOp>();
+        m.endBody();
+    }
+};
+
+TEST_F(LLVMIRGeneratorProfileTest, generates_profile_counters) {
+    LLVMIRGenerator generator("generates_profile_counters");
+    generator.instrument("/tmp/test.prof");
+    generator.process(m.makeProgram());
+    auto output = generator.dump();
+    ASSERT_NE(std::string::npos, output.find("@__compiler_profile_counters = internal global [3 x i64]")) << output;
+    ASSERT_NE(std::string::npos, output.find("c\"call :0:0\\00\"")) << output;
+    ASSERT_NE(std::string::npos, output.find("c\"else :0:0\\00\"")) << output;
+    ASSERT_NE(std::string::npos, output.find("@llvm.global_ctors")) << output;
+    ASSERT_NE(std::string::npos, output.find("call void @__compiler_profile_register(")) << output;
+}
+
+TEST_F(LLVMIRGeneratorProfileTest, generates_branch_weights) {
+    const auto &funcOp = m.childOp();
+    setProfileCounts(funcOp, {10});
+    setProfileCounts(funcOp->body.front(), {1, 9});
+    LLVMIRGenerator generator("generates_branch_weights");
+    generator.process(m.makeProgram());
+    auto output = generator.dump();
+    ASSERT_NE(std::string::npos, output.find("!{!\"function_entry_count\", i64 10}")) << output;
+    ASSERT_NE(std::string::npos, output.find("!{!\"branch_weights\", i32 1, i32 9}")) << output;
+    ASSERT_EQ(std::string::npos, output.find("__compiler_profile")) << output;
+}
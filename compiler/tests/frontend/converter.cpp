@@ -627,6 +627,101 @@ TEST_F(ConverterTest, can_process_function_call) {
     assertCorrectConversion();
 }
 
+TEST_F(ConverterTest, can_process_short_circuit_logical_operation) {
+    // clang-format off
+    t.node(NodeType::FunctionDefinition).withChildren();
+        t.node(NodeType::FunctionName, "check");
+        t.node(NodeType::FunctionArguments).withChildren();
+            t.node(NodeType::FunctionArgument).withChildren();
+                t.node(NodeType::TypeName, ast::IntType);
+                t.node(NodeType::VariableName, "x");
+            t.endChildren();
+        t.endChildren();
+        t.node(NodeType::FunctionReturnType, ast::BoolType);
+        t.node(NodeType::BranchRoot).withChildren();
+            t.node(NodeType::ReturnStatement).withChildren();
+                t.node(NodeType::Expression).withChildren();
+                    t.node(NodeType::BinaryOperation, ast::BinaryOperation::Greater).withChildren();
+                        t.node(NodeType::VariableName, "x");
+                        t.node(NodeType::IntegerLiteralValue, 0);
+                    t.endChildren();
+                t.endChildren();
+            t.endChildren();
+        t.endChildren();
+    t.endChildren();
+    t.node(NodeType::FunctionDefinition).withChildren();
+        t.node(NodeType::FunctionName, "test");
+        t.node(NodeType::FunctionArguments).withChildren();
+            t.node(NodeType::FunctionArgument).withChildren();
+                t.node(NodeType::TypeName, ast::IntType);
+                t.node(NodeType::VariableName, "x");
+            t.endChildren();
+        t.endChildren();
+        t.node(NodeType::FunctionReturnType, ast::NoneType);
+        t.node(NodeType::BranchRoot).withChildren();
+            t.node(NodeType::Expression).withChildren();
+                t.node(NodeType::BinaryOperation, ast::BinaryOperation::And).withChildren();
+                    t.node(NodeType::BinaryOperation, ast::BinaryOperation::Less).withChildren();
+                        t.node(NodeType::VariableName, "x");
+                        t.node(NodeType::IntegerLiteralValue, 10);
+                    t.endChildren();
+                    t.node(NodeType::FunctionCall).withChildren();
+                        t.node(NodeType::FunctionName, "check");
+                        t.node(NodeType::FunctionArguments).withChildren();
+                            t.node(NodeType::Expression).withChildren();
+                                t.node(NodeType::VariableName, "x");
+                            t.endChildren();
+                        t.endChildren();
+                    t.endChildren();
+                t.endChildren();
+            t.endChildren();
+            t.node(NodeType::Expression).withChildren();
+                t.node(NodeType::BinaryOperation, ast::BinaryOperation::Or).withChildren();
+                    t.node(NodeType::BinaryOperation, ast::BinaryOperation::Less).withChildren();
+                        t.node(NodeType::VariableName, "x");
+                        t.node(NodeType::IntegerLiteralValue, 10);
+                    t.endChildren();
+                    t.node(NodeType::BinaryOperation, ast::BinaryOperation::Greater).withChildren();
+                        t.node(NodeType::VariableName, "x");
+                        t.node(NodeType::IntegerLiteralValue, 20);
+                    t.endChildren();
+                t.endChildren();
+            t.endChildren();
+            t.node(NodeType::ReturnStatement);
+        t.endChildren();
+    t.endChildren();
+    // clang-format on
+
+    m.opInit<FunctionOp>("check", m.tFunc({m.tI64}, m.tBool)).inward(v["a"], 0).withBody();
+    v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+    v[1] = m.opInit<LogicBinaryOp>(LogicBinOpKind::GreaterI, v["a"], v[0]);
+    m.opInit<ReturnOp>(v[1]);
+    m.endBody();
+    m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["x"], 0).withBody();
+    v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(10));
+    v[3] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessI, v["x"], v[2]);
+    m.op<IfOp>(v[3]).result(m.tBool);
+    m.withBody();
+    m.op<ThenOp>().withBody();
+    v[4] = m.opInit<FunctionCallOp>("check", m.tBool).operand(v["x"]);
+    m.opInit<YieldOp>(std::vector<Value::Ptr>{v[4]});
+    m.endBody();
+    m.op<ElseOp>().withBody();
+    v[5] = m.opInit<ConstantOp>(m.tBool, false);
+    m.opInit<YieldOp>(std::vector<Value::Ptr>{v[5]});
+    m.endBody();
+    m.endBody();
+    v[6] = m.opInit<ConstantOp>(m.tI64, int64_t(10));
+    v[7] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessI, v["x"], v[6]);
+    v[8] = m.opInit<ConstantOp>(m.tI64, int64_t(20));
+    v[9] = m.opInit<LogicBinaryOp>(LogicBinOpKind::GreaterI, v["x"], v[8]);
+    m.opInit<LogicBinaryOp>(LogicBinOpKind::OrI, v[7], v[9]);
+    m.opInit<ReturnOp>();
+    m.endBody();
+
+    assertCorrectConversion();
+}
+
 TEST_F(ConverterTest, can_process_if_statement) {
     // clang-format off
     t.node(NodeType::FunctionDefinition).withChildren();
@@ -195,6 +195,16 @@ TEST(Lexer, can_detect_colon) {
     SINGLE_TOKEN_TEST_IMPL(":", Special::Colon);
 }
 
+TEST(Lexer, can_detect_decorator) {
+    StringVec source = {"@inline"};
+    TokenList transformed = Lexer::process(source);
+    TokenList expected;
+    expected.emplace_back(Special::At);
+    expected.emplace_back(TokenType::Identifier, "inline");
+    expected.emplace_back(Special::EndOfExpression);
+    ASSERT_EQ(expected, transformed);
+}
+
 TEST(Lexer, can_detect_identifier) {
     StringVec source = {"x"};
     TokenList transformed = Lexer::process(source);
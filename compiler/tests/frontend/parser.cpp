@@ -1482,3 +1482,30 @@ TEST(Parser, can_parse_function_arguments) {
                            "      ReturnStatement\n";
     ASSERT_EQ(expected, tree.dump());
 }
+
+TEST(Parser, can_parse_function_decorators) {
+    StringVec source = {
+        "@inline",
+        "def foo() -> None:",
+        "    return",
+    };
+    TokenList tokens = Lexer::process(source);
+    SyntaxTree tree = Parser::process(tokens);
+    std::string expected = "ProgramRoot\n"
+                           "  FunctionDefinition\n"
+                           "    FunctionName: foo\n"
+                           "      FunctionDecorator: inline\n"
+                           "    FunctionArguments\n"
+                           "    FunctionReturnType: NoneType\n"
+                           "    BranchRoot\n"
+                           "      ReturnStatement\n";
+    ASSERT_EQ(expected, tree.dump());
+}
+
+TEST(Parser, can_throw_error_for_decorator_without_function) {
+    StringVec source = {
+        "@inline",
+    };
+    TokenList tokens = Lexer::process(source);
+    ASSERT_ANY_THROW(Parser::process(tokens));
+}
@@ -0,0 +1,160 @@
+#include <cstdint>
+#include <cstdio>
+#include <sstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "compiler/interpreter/bytecode.hpp"
+#include "compiler/interpreter/bytecode_generator.hpp"
+#include "compiler/interpreter/virtual_machine.hpp"
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/declarative.hpp"
+
+using namespace optree;
+using namespace optree::interpreter;
+
+class VirtualMachineTest : public ::testing::Test {
+  protected:
+    DeclarativeModule m;
+    ValueStorage &v;
+    std::stringstream input;
+    std::stringstream output;
+
+  public:
+    VirtualMachineTest() : m(), v(m.values()){};
+    ~VirtualMachineTest() = default;
+
+    Bytecode generate() {
+        return generateBytecode(Program(m.rootOp()));
+    }
+};
+
+TEST_F(VirtualMachineTest, can_run_recursive_calls) {
+    m.opInit<FunctionOp>("fact", m.tFunc({m.tI64}, m.tI64)).inward(v["n"], 0).withBody();
+    v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+    v[1] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessEqualI, v["n"], v[0]);
+    m.op<IfOp>(v[1]).withBody();
+    m.op<ThenOp>().withBody();
+    m.opInit<ReturnOp>(v[0]);
+    m.endBody();
+    m.endBody();
+    v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["n"], v[0]);
+    v[3] = m.opInit<FunctionCallOp>("fact", m.tI64, std::vector<Value::Ptr>{v[2]});
+    v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["n"], v[3]);
+    m.opInit<ReturnOp>(v[4]);
+    m.endBody();
+
+    auto bytecode = generate();
+    VirtualMachine vm(bytecode, input, output);
+    EXPECT_EQ(vm.call("fact", {{.i = 10}}).i, 3628800);
+    EXPECT_EQ(vm.call("fact", {{.i = 20}}).i, 2432902008176640000);
+    VirtualMachine limited(bytecode, input, output, 16U);
+    EXPECT_THROW(limited.call("fact", {{.i = 20}}), InterpreterError);
+}
+
+TEST_F(VirtualMachineTest, can_swap_loop_carried_values) {
+    // fib(n): a, b = 0, 1; for i in range(n): a, b = b, a + b
+    m.opInit<FunctionOp>("fib", m.tFunc({m.tI64}, m.tI64)).inward(v["n"], 0).withBody();
+    v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+    v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+    v[2] = m.opInit<ForOp>(m.tI64, v[0], v["n"], v[1])
+               .operands(v[0], v[1])
+               .inward(v["i"], 0)
+               .inward(v["a"], m.tI64)
+               .inward(v["b"], m.tI64)
+               .result(m.tI64)
+               .result(m.tI64);
+    m.withBody();
+    v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["a"], v["b"]);
+    m.opInit<YieldOp>(std::vector<Value::Ptr>{v["b"], v[3]});
+    m.endBody();
+    m.opInit<ReturnOp>(v[2]);
+    m.endBody();
+
+    auto bytecode = generate();
+    VirtualMachine vm(bytecode, input, output);
+    EXPECT_EQ(vm.call("fib", {{.i = 0}}).i, 0);
+    EXPECT_EQ(vm.call("fib", {{.i = 10}}).i, 55);
+    EXPECT_EQ(vm.call("fib", {{.i = 90}}).i, 2880067194370816120);
+}
+
+TEST_F(VirtualMachineTest, can_print_and_input_values) {
+    m.opInit<FunctionOp>("main", m.tFunc(m.tNone)).withBody();
+    v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+    m.opInit<InputOp>(v[0]);
+    v[1] = m.opInit<LoadOp>(v[0]);
+    v[2] = m.opInit<ConstantOp>(m.tF64, 1.5);
+    v[3] = m.opInit<ConstantOp>(m.tStr, " ");
+    v[4] = m.opInit<LogicBinaryOp>(LogicBinOpKind::GreaterI, v[1], v[1]);
+    m.opInit<PrintOp>(std::vector<Value::Ptr>{v[1], v[3], v[2], v[3], v[4]});
+    m.opInit<ReturnOp>();
+    m.endBody();
+
+    auto bytecode = generate();
+    input << "-42\n";
+    VirtualMachine vm(bytecode, input, output);
+    vm.call("main");
+    EXPECT_EQ(output.str(), "-42 1.500000 0");
+}
+
+TEST_F(VirtualMachineTest, can_print_large_floats) {
+    m.opInit<FunctionOp>("main", m.tFunc(m.tNone)).withBody();
+    v[0] = m.opInit<ConstantOp>(m.tF64, 1e100);
+    m.opInit<PrintOp>(v[0]);
+    m.opInit<ReturnOp>();
+    m.endBody();
+
+    auto bytecode = generate();
+    VirtualMachine vm(bytecode, input, output);
+    vm.call("main");
+    char expected[128];
+    std::snprintf(expected, sizeof(expected), "%lf", 1e100);
+    EXPECT_EQ(output.str(), expected);
+    EXPECT_GT(output.str().size(), 100U);
+}
+
+TEST_F(VirtualMachineTest, can_access_heap_memory) {
+    // Fills the list with squares of indices and returns their sum
+    m.opInit<FunctionOp>("squares", m.tFunc({m.tI64}, m.tI64)).inward(v["n"], 0).withBody();
+    v[0] = m.opInit<HeapAllocateOp>(m.tPtr(m.tI64, PointerType::dynamic), v["n"]);
+    v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+    v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+    m.opInit<ForOp>(m.tI64, v[1], v["n"], v[2]).inward(v["i"], 0).withBody();
+    v[3] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["i"], v["i"]);
+    m.opInit<StoreOp>(v[0], v[3], v["i"]);
+    m.endBody();
+    v[4] = m.opInit<ForOp>(m.tI64, v[1], v["n"], v[2])
+               .operand(v[1])
+               .inward(v["j"], 0)
+               .inward(v["sum"], m.tI64)
+               .result(m.tI64);
+    m.withBody();
+    v[5] = m.opInit<LoadOp>(v[0], v["j"]);
+    v[6] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v["sum"], v[5]);
+    m.opInit<YieldOp>(std::vector<Value::Ptr>{v[6]});
+    m.endBody();
+    m.opInit<DeallocateOp>(v[0]);
+    m.opInit<ReturnOp>(v[4]);
+    m.endBody();
+
+    auto bytecode = generate();
+    VirtualMachine vm(bytecode, input, output);
+    EXPECT_EQ(vm.call("squares", {{.i = 10}}).i, 285);
+    EXPECT_EQ(vm.call("squares", {{.i = 0}}).i, 0);
+}
+
+TEST_F(VirtualMachineTest, reports_runtime_errors) {
+    m.opInit<FunctionOp>("div", m.tFunc({m.tI64, m.tI64}, m.tI64)).inward(v["x"], 0).inward(v["y"], 1).withBody();
+    v[0] = m.opInit<ArithBinaryOp>(ArithBinOpKind::DivI, v["x"], v["y"]);
+    m.opInit<ReturnOp>(v[0]);
+    m.endBody();
+
+    auto bytecode = generate();
+    VirtualMachine vm(bytecode, input, output);
+    EXPECT_EQ(vm.call("div", {{.i = -7}, {.i = 2}}).i, -3);
+    EXPECT_EQ(vm.call("div", {{.i = INT64_MIN}, {.i = -1}}).i, INT64_MIN);
+    EXPECT_THROW(vm.call("div", {{.i = 1}, {.i = 0}}), InterpreterError);
+    EXPECT_THROW(vm.call("div", {{.i = 1}}), InterpreterError);
+    EXPECT_THROW(vm.call("unknown"), InterpreterError);
+}
@@ -0,0 +1,91 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/declarative.hpp"
+#include "compiler/optree/evaluator.hpp"
+
+using namespace optree;
+
+class EvaluatorTest : public ::testing::Test {
+  protected:
+    DeclarativeModule m;
+    ValueStorage &v;
+
+  public:
+    EvaluatorTest() : m(), v(m.values()){};
+    ~EvaluatorTest() = default;
+
+    // fact(n) = n <= 1 ? 1 : n * fact(n - 1)
+    void makeFact() {
+        m.opInit<FunctionOp>("fact", m.tFunc({m.tI64}, m.tI64)).inward(v["n"], 0).withBody();
+        v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+        v[1] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessEqualI, v["n"], v[0]);
+        m.op<IfOp>(v[1]).withBody();
+        m.op<ThenOp>().withBody();
+        m.opInit<ReturnOp>(v[0]);
+        m.endBody();
+        m.endBody();
+        v[2] = m.opInit<ArithBinaryOp>(ArithBinOpKind::SubI, v["n"], v[0]);
+        v[3] = m.opInit<FunctionCallOp>("fact", m.tI64, std::vector<Value::Ptr>{v[2]});
+        v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::MulI, v["n"], v[3]);
+        m.opInit<ReturnOp>(v[4]);
+        m.endBody();
+    }
+};
+
+TEST_F(EvaluatorTest, can_fold_operations_over_constants) {
+    EXPECT_EQ(foldArithBinary(ArithBinOpKind::AddI, Attribute(int64_t(2)), Attribute(int64_t(3))),
+              Attribute(int64_t(5)));
+    EXPECT_EQ(foldArithBinary(ArithBinOpKind::MulI, Attribute(INT64_MAX), Attribute(int64_t(2))),
+              Attribute(int64_t(-2)));
+    EXPECT_FALSE(foldArithBinary(ArithBinOpKind::DivI, Attribute(int64_t(1)), Attribute(int64_t(0))));
+    EXPECT_FALSE(foldArithBinary(ArithBinOpKind::ShlI, Attribute(int64_t(1)), Attribute(int64_t(64))));
+    EXPECT_EQ(foldLogicBinary(LogicBinOpKind::LessF, Attribute(1.0), Attribute(2.0)), Attribute(true));
+    EXPECT_EQ(foldArithCast(ArithCastOpKind::IntToFloat, Attribute(int64_t(3))), Attribute(3.0));
+}
+
+TEST_F(EvaluatorTest, can_evaluate_recursive_calls) {
+    makeFact();
+    Evaluator evaluator(m.rootOp());
+    EXPECT_EQ(evaluator.call("fact", {Attribute(int64_t(10))}), Attribute(int64_t(3628800)));
+    EXPECT_EQ(evaluator.call("fact", {Attribute(int64_t(1))}), Attribute(int64_t(1)));
+    EXPECT_FALSE(evaluator.call("unknown", {}));
+}
+
+TEST_F(EvaluatorTest, can_evaluate_loops_over_memory) {
+    m.opInit<FunctionOp>("sum", m.tFunc({m.tI64}, m.tI64)).inward(v["n"], 0).withBody();
+    v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+    v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+    v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+    m.opInit<StoreOp>(v[0], v[1]);
+    m.opInit<ForOp>(m.tI64, v[1], v["n"], v[2]).inward(v["i"], 0).withBody();
+    v[3] = m.opInit<LoadOp>(v[0]);
+    v[4] = m.opInit<ArithBinaryOp>(ArithBinOpKind::AddI, v[3], v["i"]);
+    m.opInit<StoreOp>(v[0], v[4]);
+    m.endBody();
+    v[5] = m.opInit<LoadOp>(v[0]);
+    m.opInit<ReturnOp>(v[5]);
+    m.endBody();
+
+    Evaluator evaluator(m.rootOp());
+    EXPECT_EQ(evaluator.call("sum", {Attribute(int64_t(100))}), Attribute(int64_t(4950)));
+    EXPECT_EQ(evaluator.call("sum", {Attribute(int64_t(-1))}), Attribute(int64_t(0)));
+}
+
+TEST_F(EvaluatorTest, gives_up_on_io_and_exhausted_limits) {
+    makeFact();
+    m.opInit<FunctionOp>("noisy", m.tFunc({m.tI64}, m.tI64)).inward(v["x"], 0).withBody();
+    m.opInit<PrintOp>(v["x"]);
+    m.opInit<ReturnOp>(v["x"]);
+    m.endBody();
+
+    Evaluator evaluator(m.rootOp(), 1000U, 16U);
+    EXPECT_FALSE(evaluator.call("noisy", {Attribute(int64_t(1))}));
+    EXPECT_FALSE(evaluator.call("fact", {Attribute(int64_t(20))}));
+    EXPECT_EQ(evaluator.call("fact", {Attribute(int64_t(15))}), Attribute(int64_t(1307674368000)));
+    Evaluator limited(m.rootOp(), 20U, 16U);
+    EXPECT_FALSE(limited.call("fact", {Attribute(int64_t(15))}));
+}
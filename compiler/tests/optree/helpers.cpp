@@ -1,6 +1,7 @@
 #include <cstdint>
 
 #include <algorithm>
+#include <iterator>
 #include <gtest/gtest.h>
 
 #include "compiler/optree/adaptors.hpp"
@@ -327,3 +328,33 @@ TEST_F(DeclarativeSimilarTest, if_then_else_dissimilarity) {
             return equal;
         }));
 }
+
+TEST(ConditionPredicateTest, only_terminator_of_condition_is_predicate) {
+    DeclarativeModule m;
+    auto &v = m.values();
+    m.opInit<FunctionOp>("test", m.tFunc({m.tI64}, m.tNone)).inward(v["x"], 0).withBody();
+    v[0] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+    m.op<WhileOp>().withBody();
+    m.op<ConditionOp>().withBody();
+    v[1] = m.opInit<LogicBinaryOp>(LogicBinOpKind::Equal, v["x"], v[0]);
+    v[2] = m.opInit<LogicBinaryOp>(LogicBinOpKind::LessI, v["x"], v[0]);
+    m.endBody();
+    m.opInit<PrintOp>(v[1]);
+    m.endBody();
+    m.opInit<ReturnOp>();
+    m.endBody();
+
+    const auto &whileOp = *std::next(m.childOp()->body.begin());
+    const auto &condOp = whileOp->body.front();
+    ASSERT_FALSE(isConditionPredicate(condOp->body.front()));
+    ASSERT_TRUE(isConditionPredicate(condOp->body.back()));
+    ASSERT_FALSE(isConditionPredicate(m.childOp()->body.front()));
+}
+
+TEST(SameAttributeTest, zeros_of_different_signs_are_not_same) {
+    ASSERT_TRUE(sameAttribute(Attribute(0.0), Attribute(0.0)));
+    ASSERT_FALSE(sameAttribute(Attribute(0.0), Attribute(-0.0)));
+    ASSERT_NE(hashAttribute(Attribute(0.0)), hashAttribute(Attribute(-0.0)));
+    ASSERT_TRUE(sameAttribute(Attribute(int64_t(1)), Attribute(int64_t(1))));
+    ASSERT_FALSE(sameAttribute(Attribute(int64_t(1)), Attribute(1.0)));
+}
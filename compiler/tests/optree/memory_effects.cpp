@@ -0,0 +1,93 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/declarative.hpp"
+#include "compiler/optree/memory_effects.hpp"
+
+using namespace optree;
+
+class MemoryEffectsTest : public ::testing::Test {
+  protected:
+    DeclarativeModule m;
+    ValueStorage &v;
+
+  public:
+    MemoryEffectsTest() : m(), v(m.values()){};
+    ~MemoryEffectsTest() = default;
+
+    static MemoryEffect access(const Value::Ptr &ptr, const Value::Ptr &offset = {}) {
+        return {MemoryEffectKind::Read, ptr, offset};
+    }
+};
+
+TEST_F(MemoryEffectsTest, can_distinguish_allocations_and_offsets) {
+    m.opInit<FunctionOp>("test", m.tFunc({m.tPtr(m.tI64)}, m.tNone)).inward(v["arg"], 0).withBody();
+    v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64, 4U));
+    v[1] = m.opInit<AllocateOp>(m.tPtr(m.tI64, 4U));
+    v[2] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+    v[3] = m.opInit<ConstantOp>(m.tI64, int64_t(2));
+    v[4] = m.opInit<LoadOp>(v["arg"]);
+    m.opInit<ReturnOp>();
+    m.endBody();
+
+    EXPECT_EQ(alias(access(v[0]), access(v[1])), AliasResult::NoAlias);
+    EXPECT_EQ(alias(access(v[0]), access(v["arg"])), AliasResult::NoAlias);
+    EXPECT_EQ(alias(access(v[0], v[2]), access(v[0], v[3])), AliasResult::NoAlias);
+    EXPECT_EQ(alias(access(v[0], v[2]), access(v[0], v[2])), AliasResult::MustAlias);
+    EXPECT_EQ(alias(access(v[0]), access(v[0], v[4])), AliasResult::MayAlias);
+    EXPECT_EQ(alias(access(v["arg"]), access(v[4])), AliasResult::MayAlias);
+    EXPECT_EQ(alias(access(v[0]), access({})), AliasResult::MayAlias);
+}
+
+TEST_F(MemoryEffectsTest, can_describe_operations) {
+    m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+    v[0] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+    v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(1));
+    m.opInit<StoreOp>(v[0], v[1]);
+    v[2] = m.opInit<LoadOp>(v[0]);
+    m.opInit<InputOp>(v[0]);
+    m.opInit<ReturnOp>();
+    m.endBody();
+
+    MemoryEffectsAnalysis analysis(m.rootOp());
+    auto funcOp = m.rootOp()->body.front();
+    std::vector<MemoryEffectKind> kinds;
+    for (const auto &effect : analysis.getEffects(funcOp))
+        kinds.push_back(effect.kind);
+    std::vector<MemoryEffectKind> expected = {MemoryEffectKind::Allocate, MemoryEffectKind::Write,
+                                              MemoryEffectKind::Read, MemoryEffectKind::Write, MemoryEffectKind::IO};
+    EXPECT_EQ(kinds, expected);
+    Value::Ptr constant = v[1];
+    EXPECT_FALSE(analysis.hasEffects(constant->owner.lock()));
+}
+
+TEST_F(MemoryEffectsTest, can_summarize_called_functions) {
+    m.opInit<FunctionOp>("write", m.tFunc({m.tPtr(m.tI64), m.tPtr(m.tI64)}, m.tNone))
+        .inward(v["dst"], 0)
+        .inward(v["src"], 1)
+        .withBody();
+    v[0] = m.opInit<LoadOp>(v["src"]);
+    m.opInit<StoreOp>(v["dst"], v[0]);
+    m.opInit<ReturnOp>();
+    m.endBody();
+    m.opInit<FunctionOp>("test", m.tFunc(m.tNone)).withBody();
+    v[1] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+    v[2] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+    v[3] = m.opInit<AllocateOp>(m.tPtr(m.tI64));
+    m.opInit<FunctionCallOp>("write", m.tNone, std::vector<Value::Ptr>{v[1], v[2]});
+    m.opInit<FunctionCallOp>("unknown", m.tNone, std::vector<Value::Ptr>{});
+    m.opInit<ReturnOp>();
+    m.endBody();
+
+    MemoryEffectsAnalysis analysis(m.rootOp());
+    auto funcOp = m.rootOp()->body.back();
+    auto callOp = *std::next(funcOp->body.begin(), 3);
+    auto unknownCallOp = *std::next(funcOp->body.begin(), 4);
+    EXPECT_TRUE(analysis.mayModify(callOp, access(v[1])));
+    EXPECT_FALSE(analysis.mayModify(callOp, access(v[2])));
+    EXPECT_FALSE(analysis.mayModify(callOp, access(v[3])));
+    EXPECT_TRUE(analysis.mayModify(unknownCallOp, access(v[3])));
+}
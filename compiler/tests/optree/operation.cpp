@@ -2,6 +2,7 @@
 
 #include "compiler/optree/base_adaptor.hpp"
 #include "compiler/optree/operation.hpp"
+#include "compiler/optree/types.hpp"
 
 using namespace optree;
 
@@ -42,3 +43,22 @@ TEST(Operation, can_find_parent_not_self) {
     auto op5 = Operation::make<SecondOp>(op4);
     ASSERT_EQ(op2.op, op5->findParent<SecondOp>().op);
 }
+
+TEST(Operation, can_clone_body_with_values_of_siblings_and_parent) {
+    auto op1 = Operation::make<FirstOp>();
+    auto inward = op1->addInward(TypeStorage::integerType());
+    auto op2 = Operation::make<SecondOp>();
+    op1->addToBody(op2.op);
+    auto result = op2->addResult(TypeStorage::integerType());
+    auto op3 = Operation::make<SecondOp>();
+    op1->addToBody(op3.op);
+    auto op4 = Operation::make<FirstOp>();
+    op3->addToBody(op4.op);
+    op4->addOperand(inward);
+    op4->addOperand(result);
+
+    auto cloned = op1->clone();
+    const auto &clonedOp4 = cloned->body.back()->body.front();
+    ASSERT_EQ(cloned->inward(0), clonedOp4->operand(0));
+    ASSERT_EQ(cloned->body.front()->result(0), clonedOp4->operand(1));
+}
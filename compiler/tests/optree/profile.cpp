@@ -0,0 +1,74 @@
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "compiler/optree/adaptors.hpp"
+#include "compiler/optree/declarative.hpp"
+#include "compiler/optree/definitions.hpp"
+#include "compiler/optree/profile.hpp"
+#include "compiler/utils/source_ref.hpp"
+
+using namespace optree;
+
+TEST(ProfileTest, can_read_profile_summing_repeated_keys) {
+    std::istringstream stream("call a.py:1:1 3\n\nthen a.py:2:5 0\ncall a.py:1:1 4\n");
+    auto profile = readProfile(stream);
+    ASSERT_EQ(profile.size(), 2U);
+    ASSERT_EQ(profile.at("call a.py:1:1"), 7);
+    ASSERT_EQ(profile.at("then a.py:2:5"), 0);
+}
+
+TEST(ProfileTest, can_not_read_invalid_profile_lines) {
+    for (const auto *text : {"call a.py:1:1", "call a.py:1:1 -1", "call a.py:1:1 1x", "call a.py:1:1 "}) {
+        std::istringstream stream(std::string("then a.py:2:5 1\n") + text);
+        ASSERT_THROW(readProfile(stream), std::runtime_error) << text;
+    }
+}
+
+TEST(ProfileTest, can_attach_profile_to_instrumented_operations) {
+    auto filename = std::make_shared<const std::string>("/sources/a.py");
+    DeclarativeModule m;
+    auto &v = m.values();
+    m.opInit<FunctionOp>("f", m.tFunc(m.tNone)).withBody();
+    v[0] = m.opInit<ConstantOp>(m.tBool, true);
+    m.op<IfOp>(v[0]).withBody();
+    m.op<ThenOp>().withBody();
+    m.opInit<PrintOp>(v[0]);
+    m.endBody();
+    m.endBody();
+    v[1] = m.opInit<ConstantOp>(m.tI64, int64_t(0));
+    m.opInit<ForOp>(m.tI64, v[1], v[1], v[1]).withBody();
+    m.opInit<PrintOp>(v[1]);
+    m.endBody();
+    m.opInit<ReturnOp>();
+    m.endBody();
+
+    const auto &funcOp = m.childOp();
+    const auto &ifOp = *std::next(funcOp->body.begin(), 1);
+    const auto &forOp = *std::next(funcOp->body.begin(), 3);
+    funcOp->ref = utils::SourceRef(filename, 1U, 1U);
+    ifOp->ref = utils::SourceRef(filename, 2U, 5U);
+    forOp->ref = utils::SourceRef(filename, 4U, 5U);
+    ASSERT_EQ(getProfileKeys(funcOp), std::vector<std::string>{"call a.py:1:1"});
+    ASSERT_EQ(getProfileKeys(ifOp), (std::vector<std::string>{"then a.py:2:5", "else a.py:2:5"}));
+    ASSERT_EQ(getProfileKeys(forOp), (std::vector<std::string>{"enter a.py:4:5", "iterate a.py:4:5"}));
+    ASSERT_TRUE(getProfileKeys(funcOp->body.front()).empty());
+
+    // The loop is not attached, since its iterations are missing in the profile
+    std::istringstream stream("call a.py:1:1 2\nthen a.py:2:5 1\nelse a.py:2:5 1\nenter a.py:4:5 2\n");
+    attachProfile(m.rootOp(), readProfile(stream));
+    ASSERT_EQ(getProfileCounts(funcOp), std::vector<NativeInt>{2});
+    ASSERT_EQ(funcOp->as<FunctionOp>().name(), "f");
+    ASSERT_EQ(getProfileCounts(ifOp), (std::vector<NativeInt>{1, 1}));
+    ASSERT_TRUE(getProfileCounts(forOp).empty());
+
+    setProfileCounts(ifOp, {0, 5});
+    ASSERT_EQ(getProfileCounts(ifOp), (std::vector<NativeInt>{0, 5}));
+    ASSERT_EQ(ifOp->numAttrs(), 2U);
+}
@@ -0,0 +1,55 @@
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "compiler/runtime/parallel_for.hpp"
+
+namespace {
+
+// Counts the visits of the iterations, the visit of the iteration i is stored at index i - offset
+struct Counters {
+    std::atomic<int64_t> *visits;
+    int64_t offset;
+
+    static void count(int64_t begin, int64_t end, int64_t step, void *context) {
+        auto *counters = static_cast<Counters *>(context);
+        for (int64_t i = begin; i < end; i += step)
+            counters->visits[i - counters->offset]++;
+    }
+};
+
+} // namespace
+
+TEST(ParallelForTest, runs_every_iteration_once) {
+    std::vector<std::atomic<int64_t>> visits(100500);
+    Counters counters{visits.data(), -500};
+    __compiler_parallel_for(-500, 100000, 3, Counters::count, &counters);
+    for (int64_t i = -500; i < 100000; i++)
+        ASSERT_EQ(visits[i + 500].load(), (i + 500) % 3 == 0 ? 1 : 0) << "iteration " << i;
+}
+
+TEST(ParallelForTest, can_run_empty_and_single_iteration_loops) {
+    std::vector<std::atomic<int64_t>> visits(10);
+    Counters counters{visits.data(), 0};
+    __compiler_parallel_for(5, 5, 1, Counters::count, &counters);
+    __compiler_parallel_for(7, 2, 1, Counters::count, &counters);
+    __compiler_parallel_for(3, 4, 5, Counters::count, &counters);
+    for (int64_t i = 0; i < 10; i++)
+        ASSERT_EQ(visits[i].load(), i == 3 ? 1 : 0) << "iteration " << i;
+}
+
+TEST(ParallelForTest, can_run_nested_loops) {
+    constexpr int64_t size = 200;
+    std::vector<std::atomic<int64_t>> visits(size * size);
+    auto outer = [](int64_t begin, int64_t end, int64_t step, void *context) {
+        for (int64_t i = begin; i < end; i += step) {
+            Counters row{static_cast<std::atomic<int64_t> *>(context), -i * size};
+            __compiler_parallel_for(0, size, 1, Counters::count, &row);
+        }
+    };
+    __compiler_parallel_for(0, size, 1, outer, visits.data());
+    for (int64_t i = 0; i < size * size; i++)
+        ASSERT_EQ(visits[i].load(), 1) << "iteration " << i;
+}
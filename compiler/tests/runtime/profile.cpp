@@ -0,0 +1,32 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "compiler/runtime/profile.hpp"
+
+namespace {
+
+// Counters are static like the ones of the instrumented modules, since the profile is written again at the exit
+const char *const firstKeys[] = {"call a.py:1:1", "then a.py:2:5", "else a.py:2:5"};
+const int64_t firstCounters[] = {3, 0, 3};
+const char *const secondKeys[] = {"call a.py:1:1"};
+const int64_t secondCounters[] = {4};
+
+} // namespace
+
+TEST(ProfileTest, writes_counts_summed_by_keys) {
+    auto path = std::filesystem::temp_directory_path() / "compiler_runtime_profile_test.prof";
+    const auto pathStr = path.string();
+    __compiler_profile_register(pathStr.c_str(), firstKeys, firstCounters, 3);
+    __compiler_profile_register(pathStr.c_str(), secondKeys, secondCounters, 1);
+    __compiler_profile_write();
+
+    std::ifstream stream(path);
+    std::stringstream content;
+    content << stream.rdbuf();
+    ASSERT_EQ(content.str(), "call a.py:1:1 7\nelse a.py:2:5 3\nthen a.py:2:5 0\n");
+}